@@ -1,5 +1,5 @@
 # Qt Modules
-QT += core gui widgets websockets
+QT += core gui widgets websockets concurrent
 
 CONFIG += c++17
 # CONFIG += release    # Options: debug, release, console, static, shared
@@ -14,6 +14,11 @@ SOURCES += $$files($$PWD/src/Multiplayer/*.cpp, true)
 HEADERS += $$files($$PWD/include/*.h, true)
 HEADERS += $$files($$PWD/include/Multiplayer/*.h, true)
 
+# The profile store is linked from its library, not compiled again
+include($$PWD/store/codenames_store.pri)
+SOURCES -= $$STORE_SOURCES
+HEADERS -= $$STORE_HEADERS
+
 # Remove duplicates if necessary (qmake uses += so the files won't be added twice as long as it's done correctly).
 SOURCES = $$unique(SOURCES)
 HEADERS = $$unique(HEADERS)
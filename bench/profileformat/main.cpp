@@ -0,0 +1,136 @@
+/**
+ * @file main.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Benchmark of parsing and writing the profile as JSON and CBOR
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage: profileformat_bench [users] [iterations]
+ * Generates a synthetic profile (50000 users by default) and reports the
+ * file size, decode time, encode time and the cost of one statistics
+ * update (decode, change one user, encode) for each format.
+ */
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "profilecodec.h"
+
+namespace {
+
+/**
+ * @brief Build a profile shaped like the one CreateAccountWindow writes
+ */
+QJsonObject makeProfile(int users) {
+  QRandomGenerator rng(3307);  // Fixed seed, runs are comparable
+  QJsonObject profile;
+  for (int i = 0; i < users; i++) {
+    QString username = QString("player_%1").arg(i);
+    int played = rng.bounded(500);
+    int total = rng.bounded(2000);
+
+    QJsonObject statistics;
+    statistics["games_played"] = played;
+    statistics["games_win"] = played ? rng.bounded(played + 1) : 0;
+    statistics["guess_total"] = total;
+    statistics["guess_hit"] = total ? rng.bounded(total + 1) : 0;
+
+    QJsonObject user;
+    user["user_name"] = username;
+    user["statistics"] = statistics;
+    profile[username] = user;
+  }
+  return profile;
+}
+
+/**
+ * @brief Median wall time of a function in milliseconds
+ */
+double medianMs(int iterations, const std::function<void()>& run) {
+  std::vector<double> samples;
+  for (int i = 0; i < iterations; i++) {
+    QElapsedTimer timer;
+    timer.start();
+    run();
+    samples.push_back(timer.nsecsElapsed() / 1e6);
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  QStringList args = app.arguments();
+  int users = args.size() > 1 ? args[1].toInt() : 50000;
+  int iterations = args.size() > 2 ? std::max(args[2].toInt(), 1) : 5;
+
+  QTextStream out(stdout);
+  QJsonObject profile = makeProfile(users);
+  out << "users: " << users << ", iterations: " << iterations << "\n";
+  out << QString("%1 %2 %3 %4 %5\n")
+             .arg("format", -14)
+             .arg("bytes", 12)
+             .arg("decode ms", 11)
+             .arg("encode ms", 11)
+             .arg("update ms", 11);
+
+  struct Variant {
+    QString name;
+    std::function<QByteArray(const QJsonObject&)> encode;
+  };
+  const std::vector<Variant> variants = {
+      {"json-indented",
+       [](const QJsonObject& p) {
+         return ProfileCodec::encode(p, ProfileCodec::Json);
+       }},
+      {"json-compact",
+       [](const QJsonObject& p) {
+         return QJsonDocument(p).toJson(QJsonDocument::Compact);
+       }},
+      {"cbor",
+       [](const QJsonObject& p) {
+         return ProfileCodec::encode(p, ProfileCodec::Cbor);
+       }},
+  };
+
+  for (const Variant& variant : variants) {
+    QByteArray data = variant.encode(profile);
+    QJsonObject decoded;
+
+    double decodeMs = medianMs(iterations, [&] {
+      ProfileCodec::decode(data, decoded);
+    });
+    double encodeMs = medianMs(iterations, [&] { variant.encode(decoded); });
+
+    // What every stat update cost before the write-behind queue
+    double updateMs = medianMs(iterations, [&] {
+      QJsonObject copy;
+      ProfileCodec::decode(data, copy);
+      QJsonObject user = copy["player_0"].toObject();
+      QJsonObject statistics = user["statistics"].toObject();
+      statistics["guess_total"] = statistics["guess_total"].toInt() + 1;
+      user["statistics"] = statistics;
+      copy["player_0"] = user;
+      variant.encode(copy);
+    });
+
+    out << QString("%1 %2 %3 %4 %5\n")
+               .arg(variant.name, -14)
+               .arg(data.size(), 12)
+               .arg(decodeMs, 11, 'f', 2)
+               .arg(encodeMs, 11, 'f', 2)
+               .arg(updateMs, 11, 'f', 2);
+  }
+
+  return 0;
+}
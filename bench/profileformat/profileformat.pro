@@ -0,0 +1,20 @@
+# Benchmark of the profile file formats (JSON vs CBOR)
+# Build: qmake bench/profileformat/profileformat.pro && make
+QT += core
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = profileformat_bench
+TEMPLATE = app
+
+SOURCES += $$PWD/main.cpp
+
+include($$PWD/../../store/codenames_store.pri)
+
+# Output Directory
+DESTDIR = $$PWD/../../bin
+
+# Object Directory
+OBJECTS_DIR = $$PWD/../../build/bench
@@ -0,0 +1,94 @@
+/**
+ * @file main.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Benchmark of recomputing every rating from a match history
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage: ratings_bench [games] [players]
+ * Generates a synthetic history (1000000 games between 20000 players by
+ * default, one game a minute) where each player has a hidden skill, then
+ * times RatingEngine::recompute and reports how well the ratings recover
+ * the hidden skills.
+ */
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ratingengine.h"
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  QStringList args = app.arguments();
+  int games = args.size() > 1 ? std::max(args[1].toInt(), 1) : 1000000;
+  int players = args.size() > 2 ? std::max(args[2].toInt(), 4) : 20000;
+
+  QTextStream out(stdout);
+  QRandomGenerator random(7);
+
+  QStringList usernames;
+  std::vector<double> skills;
+  for (int i = 0; i < players; i++) {
+    usernames.append(QString("player%1").arg(i));
+    // Sum of uniforms, roughly normal
+    skills.push_back(random.generateDouble() + random.generateDouble() +
+                     random.generateDouble() - 1.5);
+  }
+
+  QVector<MatchResult> matches;
+  matches.reserve(games);
+  qint64 start = 1700000000000;
+  for (int i = 0; i < games; i++) {
+    MatchResult match;
+    int seats[RatingEngine::SeatCount];
+    for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+      seats[seat] = random.bounded(players);
+      match.players[seat] = usernames.at(seats[seat]);
+    }
+    double edge = 3 * (skills[seats[0]] + skills[seats[1]] -
+                       skills[seats[2]] - skills[seats[3]]);
+    match.redWon = random.generateDouble() < 1 / (1 + std::exp(-edge));
+    match.timestamp = start + qint64(i) * 60000;
+    matches.append(match);
+  }
+
+  RatingEngine engine;
+  QElapsedTimer timer;
+  timer.start();
+  QHash<QString, PlayerRatings> ratings = engine.recompute(matches);
+  qint64 elapsed = timer.elapsed();
+
+  // Pearson correlation of hidden skill and spymaster rating
+  double n = 0, sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+  for (int i = 0; i < players; i++) {
+    auto it = ratings.constFind(usernames.at(i));
+    if (it == ratings.constEnd()) {
+      continue;
+    }
+    double x = skills[i];
+    double y = it->spymaster.rating;
+    n++;
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    syy += y * y;
+    sxy += x * y;
+  }
+  double correlation = (n * sxy - sx * sy) /
+                       std::sqrt((n * sxx - sx * sx) * (n * syy - sy * sy));
+
+  out << games << " games, " << ratings.size() << " players, "
+      << QThread::idealThreadCount() << " threads\n";
+  out << "recompute: " << elapsed << " ms\n";
+  out << "skill correlation: " << QString::number(correlation, 'f', 3)
+      << "\n";
+  return 0;
+}
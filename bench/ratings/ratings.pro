@@ -0,0 +1,20 @@
+# Benchmark of recomputing every rating from a match history
+# Build: qmake bench/ratings/ratings.pro && make
+QT += core concurrent
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = ratings_bench
+TEMPLATE = app
+
+SOURCES += $$PWD/main.cpp
+
+include($$PWD/../../store/codenames_store.pri)
+
+# Output Directory
+DESTDIR = $$PWD/../../bin
+
+# Object Directory
+OBJECTS_DIR = $$PWD/../../build/bench
@@ -0,0 +1,82 @@
+/**
+ * @file main.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Benchmark of in-place increments on the mapped statistics table
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage: statstable_bench [users] [increments]
+ * Fills a table in a temporary directory (100000 users by default) and
+ * reports the latency of a hit (lookup plus two increments) in nanoseconds.
+ */
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+
+#include "statstable.h"
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  QStringList args = app.arguments();
+  int users = args.size() > 1 ? std::max(args[1].toInt(), 1) : 100000;
+  int increments = args.size() > 2 ? std::max(args[2].toInt(), 1) : 1000000;
+
+  QTextStream out(stdout);
+  QTemporaryDir dir;
+  StatsTable table(dir.filePath("stats.table"));
+  if (!table.open()) {
+    out << "could not create the table\n";
+    return 1;
+  }
+
+  QStringList usernames;
+  for (int i = 0; i < users; i++) {
+    usernames.append(QString("player_%1").arg(i));
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  for (const QString& username : usernames) {
+    table.insert(username, StatsCounters());
+  }
+  out << "users: " << users << ", insert total ms: "
+      << timer.nsecsElapsed() / 1e6 << "\n";
+
+  // Random order, so the probes do not just walk the cache
+  QRandomGenerator rng(3307);
+  std::vector<int> order(increments);
+  for (int& index : order) {
+    index = rng.bounded(users);
+  }
+
+  timer.restart();
+  for (int index : order) {
+    StatsCounters* counters = table.find(usernames[index]);
+    counters->guessTotal++;
+    counters->guessHit++;
+  }
+  double meanNs = double(timer.nsecsElapsed()) / increments;
+
+  // Per-operation samples for the tail, includes the timer overhead
+  std::vector<qint64> samples;
+  samples.reserve(std::min(increments, 100000));
+  for (int i = 0; i < int(samples.capacity()); i++) {
+    timer.restart();
+    StatsCounters* counters = table.find(usernames[order[i]]);
+    counters->guessTotal++;
+    samples.push_back(timer.nsecsElapsed());
+  }
+  std::sort(samples.begin(), samples.end());
+
+  out << "hit mean ns: " << meanNs << "\n";
+  out << "hit p50 ns: " << samples[samples.size() / 2] << "\n";
+  out << "hit p99 ns: " << samples[samples.size() * 99 / 100] << "\n";
+  return 0;
+}
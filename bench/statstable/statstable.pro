@@ -0,0 +1,20 @@
+# Benchmark of in-place counter increments on the mapped statistics table
+# Build: qmake bench/statstable/statstable.pro && make
+QT += core
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = statstable_bench
+TEMPLATE = app
+
+SOURCES += $$PWD/main.cpp
+
+include($$PWD/../../store/codenames_store.pri)
+
+# Output Directory
+DESTDIR = $$PWD/../../bin
+
+# Object Directory
+OBJECTS_DIR = $$PWD/../../build/bench
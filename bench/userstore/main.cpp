@@ -0,0 +1,306 @@
+/**
+ * @file main.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Latency benchmark of every ProfileStore operation on synthetic
+ * profiles
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage: userstore_bench [sizes] [samples] [output]
+ * For each profile size (10,1000,100000,1000000 by default) a fresh
+ * resources/ directory is generated in a temporary directory and a child
+ * process opens a ProfileStore on it, so every size starts cold. Every
+ * operation is timed one call at a time (1000 samples by default, fewer for
+ * the operations that rewrite or re-read the whole profile on large stores)
+ * and the p50, p99, mean and max latency are written as JSON to stdout, or
+ * to the output file if given.
+ */
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QProcess>
+#include <QRandomGenerator>
+#include <QSaveFile>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "profilecodec.h"
+#include "profilestore.h"
+
+namespace {
+
+/**
+ * @brief Build a profile of accounts shaped like the app's, with the profile
+ * object renameUser needs next to the statistics
+ */
+QJsonObject makeProfile(int users) {
+  QRandomGenerator rng(3307);  // Fixed seed, runs are comparable
+  QJsonObject profile;
+  for (int i = 0; i < users; i++) {
+    QString username = QString("player_%1").arg(i);
+    int played = rng.bounded(500);
+    int total = rng.bounded(2000);
+
+    QJsonObject statistics;
+    statistics["games_played"] = played;
+    statistics["games_win"] = played ? rng.bounded(played + 1) : 0;
+    statistics["guess_total"] = total;
+    statistics["guess_hit"] = total ? rng.bounded(total + 1) : 0;
+
+    QJsonObject profileObject;
+    profileObject["player_name"] = username;
+
+    QJsonObject user;
+    user["user_name"] = username;
+    user["profile"] = profileObject;
+    user["statistics"] = statistics;
+    profile[username] = user;
+  }
+  return profile;
+}
+
+/**
+ * @brief One timed operation: prepare(i) runs untimed before run(i), note is
+ * copied into the report
+ */
+struct Operation {
+  QString name;
+  int samples;
+  std::function<void(int)> prepare;
+  std::function<void(int)> run;
+  QString note = QString();
+};
+
+/**
+ * @brief Latency distribution of an operation, in nanoseconds
+ */
+QJsonObject measure(const Operation& operation) {
+  std::vector<qint64> samples;
+  samples.reserve(operation.samples);
+  QElapsedTimer timer;
+  for (int i = 0; i < operation.samples; i++) {
+    if (operation.prepare) {
+      operation.prepare(i);
+    }
+    timer.start();
+    operation.run(i);
+    samples.push_back(timer.nsecsElapsed());
+  }
+  std::sort(samples.begin(), samples.end());
+
+  double total = 0;
+  for (qint64 sample : samples) {
+    total += double(sample);
+  }
+  size_t count = samples.size();
+  QJsonObject result;
+  result["samples"] = int(count);
+  result["p50_ns"] = double(samples[count / 2]);
+  result["p99_ns"] = double(samples[std::min(count - 1, count * 99 / 100)]);
+  result["mean_ns"] = total / double(count);
+  result["max_ns"] = double(samples.back());
+  if (!operation.note.isEmpty()) {
+    result["note"] = operation.note;
+  }
+  return result;
+}
+
+/**
+ * @brief Generate a store in the current directory and time every operation
+ *
+ * @return `int` the exit code of the child process
+ */
+int runChild(int argc, char* argv[], int users, int samples) {
+  QElapsedTimer setup;
+  setup.start();
+
+  // The store reads resources/ relative to the working directory
+  QDir().mkpath("resources");
+  QSaveFile file(ProfileCodec::cborPath("resources/profile.json"));
+  QByteArray encoded =
+      ProfileCodec::encode(makeProfile(users), ProfileCodec::Cbor, 1);
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(encoded) != encoded.size() || !file.commit() ||
+      !ProfileCodec::recordChecksum("resources/profile.json", encoded)) {
+    QTextStream(stderr) << "could not write the profile\n";
+    return 1;
+  }
+  qint64 generateMs = setup.elapsed();
+
+  // Logging is part of the app, but writing it out would dominate
+  QLoggingCategory::setFilterRules("*.debug=false");
+  QCoreApplication app(argc, argv);
+
+  setup.restart();
+  ProfileStore* store = new ProfileStore("resources", &app);
+  qint64 openMs = setup.elapsed();
+
+  // Operations that rewrite or re-read the whole profile get fewer samples
+  int wholeProfileSamples =
+      std::max(3, std::min(samples, int(qint64(samples) * 1000 / users)));
+
+  QRandomGenerator rng(7);
+  std::vector<int> picks(std::max(samples, wholeProfileSamples));
+  for (int& pick : picks) {
+    pick = rng.bounded(users);
+  }
+  auto user = [&picks](int i) {
+    return QString("player_%1").arg(picks[size_t(i)]);
+  };
+
+  // Arguments computed before the timer starts
+  unsigned int value = 0;
+  auto readPlayed = [&](int i) { value = store->getGamesPlayed(user(i)) + 1; };
+  auto readWins = [&](int i) {
+    value = std::min(store->getWins(user(i)) + 1,
+                     store->getGamesPlayed(user(i)));
+  };
+  auto readTotal = [&](int i) { value = store->getGuessTotal(user(i)) + 1; };
+  auto readHit = [&](int i) {
+    value = std::min(store->getGuessHit(user(i)) + 1,
+                     store->getGuessTotal(user(i)));
+  };
+
+  QList<Operation> operations = {
+      {"getGamesPlayed", samples, nullptr,
+       [&](int i) { store->getGamesPlayed(user(i)); }},
+      {"getWins", samples, nullptr, [&](int i) { store->getWins(user(i)); }},
+      {"getWinRate", samples, nullptr,
+       [&](int i) { store->getWinRate(user(i)); }},
+      {"getGuessTotal", samples, nullptr,
+       [&](int i) { store->getGuessTotal(user(i)); }},
+      {"getGuessHit", samples, nullptr,
+       [&](int i) { store->getGuessHit(user(i)); }},
+      {"getHitRate", samples, nullptr,
+       [&](int i) { store->getHitRate(user(i)); }},
+      {"updateGamesPlayed", samples, readPlayed,
+       [&](int i) { store->updateGamesPlayed(user(i), value); }},
+      {"updateWins", samples, readWins,
+       [&](int i) { store->updateWins(user(i), value); }},
+      {"updateGuessTotal", samples, readTotal,
+       [&](int i) { store->updateGuessTotal(user(i), value); }},
+      {"updateGuessHit", samples, readHit,
+       [&](int i) { store->updateGuessHit(user(i), value); }},
+      {"won", samples, nullptr, [&](int i) { store->won(user(i)); }},
+      {"lost", samples, nullptr, [&](int i) { store->lost(user(i)); }},
+      {"hit", samples, nullptr, [&](int i) { store->hit(user(i)); }},
+      {"miss", samples, nullptr, [&](int i) { store->miss(user(i)); }},
+      {"loadJsonFile", samples, nullptr,
+       [&](int) { store->loadJsonFile(); }},
+      {"loadJsonFile_cold", wholeProfileSamples,
+       [&](int) { store->invalidateProfileCache(); },
+       [&](int) { store->loadJsonFile(); }},
+      {"createAccount", wholeProfileSamples, nullptr,
+       [&](int i) { store->createAccount(QString("new_player_%1").arg(i)); },
+       "timed in place of CreateAccountWindow::saveJsonFile, which moved "
+       "into ProfileStore"},
+      // Last, the renamed users are gone for the operations above
+      {"renameUser", std::min(wholeProfileSamples, users), nullptr,
+       [&](int i) {
+         store->renameUser(QString("player_%1").arg(i),
+                           QString("renamed_%1").arg(i));
+       }},
+  };
+
+  // A rename that fails early would time only its error path
+  auto exists = [&](const QString& username) {
+    return !store->userEntry(username).isEmpty();
+  };
+  store->renameUser("player_0", "rename_check");
+  bool renamed = exists("rename_check") && !exists("player_0");
+  store->renameUser("rename_check", "player_0");
+  if (!renamed || !exists("player_0")) {
+    QTextStream(stderr) << "renameUser failed: " << store->lastError() << "\n";
+    return 1;
+  }
+
+  QJsonObject results;
+  for (const Operation& operation : operations) {
+    results[operation.name] = measure(operation);
+  }
+
+  QJsonObject report;
+  report["users"] = users;
+  report["generate_ms"] = double(generateMs);
+  report["open_ms"] = double(openMs);
+  report["profile_bytes"] = double(encoded.size());
+  report["operations"] = results;
+
+  // Let the writer thread drain before the store is torn down
+  QMetaObject::invokeMethod(&app, &QCoreApplication::quit,
+                            Qt::QueuedConnection);
+  app.exec();
+
+  QTextStream(stdout) << QJsonDocument(report).toJson(QJsonDocument::Compact)
+                      << "\n";
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  // The child measures one store size in its own working directory
+  if (argc == 4 && QByteArray(argv[1]) == "--child") {
+    return runChild(argc, argv, std::max(QByteArray(argv[2]).toInt(), 1),
+                    std::max(QByteArray(argv[3]).toInt(), 1));
+  }
+
+  QCoreApplication app(argc, argv);
+  QStringList args = app.arguments();
+  QStringList sizes = (args.size() > 1 ? args[1] : "10,1000,100000,1000000")
+                          .split(",", Qt::SkipEmptyParts);
+  int samples = args.size() > 2 ? std::max(args[2].toInt(), 1) : 1000;
+  QString outputPath = args.size() > 3 ? args[3] : QString();
+
+  QTextStream err(stderr);
+  QJsonArray runs;
+  for (const QString& size : sizes) {
+    QTemporaryDir dir;
+    QProcess child;
+    child.setWorkingDirectory(dir.path());
+    child.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    child.start(app.applicationFilePath(),
+                {"--child", size.trimmed(), QString::number(samples)});
+    if (!child.waitForFinished(-1) || child.exitCode() != 0) {
+      err << "run with " << size << " users failed\n";
+      return 1;
+    }
+
+    QJsonDocument run = QJsonDocument::fromJson(child.readAllStandardOutput());
+    if (!run.isObject()) {
+      err << "run with " << size << " users produced no report\n";
+      return 1;
+    }
+    runs.append(run.object());
+    err << "done: " << size << " users\n";
+    err.flush();
+  }
+
+  QJsonObject report;
+  report["benchmark"] = "userstore";
+  report["samples"] = samples;
+  report["runs"] = runs;
+  QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+  if (outputPath.isEmpty()) {
+    QTextStream(stdout) << json;
+    return 0;
+  }
+  QSaveFile output(outputPath);
+  if (!output.open(QIODevice::WriteOnly) || output.write(json) != json.size() ||
+      !output.commit()) {
+    err << "could not write " << outputPath << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,19 @@
+# Latency benchmark of every ProfileStore operation on synthetic stores
+# Build: qmake bench/userstore/userstore.pro && make
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = userstore_bench
+TEMPLATE = app
+
+SOURCES += $$PWD/main.cpp
+
+include($$PWD/../../store/codenames_store.pri)
+
+# Output Directory
+DESTDIR = $$PWD/../../bin
+
+# Object Directory
+OBJECTS_DIR = $$PWD/../../build/bench
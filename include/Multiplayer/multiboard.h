@@ -29,8 +29,12 @@
 #include "../spymasterhint.h"
 #include "Multiplayer/multimain.h"
 #include "Multiplayer/multipregame.h"
+#include "boarddealer.h"
+#include "boardstate.h"
 #include "chatbox.h"
+#include "matchhistory.h"
 #include "user.h"
+#include "wordpool.h"
 
 class MultiMain;
 class MultiPregame;
@@ -98,16 +102,6 @@ class MultiBoard : public QWidget {
     BLUE_OP   /**< Blue team operator's turn */
   };
 
-  /**
-   * @struct Card
-   * @brief Structure representing a card on the game board.
-   */
-  struct Card {
-    QString word;  /**< The word displayed on the card */
-    CardType type; /**< The type/team the card belongs to */
-    bool revealed; /**< Whether the card has been revealed */
-  };
-
  public slots:
   /**
    * @brief Handles a player clicking on a tile in the game grid.
@@ -181,7 +175,7 @@ class MultiBoard : public QWidget {
   ChatBox* chatBox;
 
   /** @brief User information management */
-  User* users;
+  ProfileStore* users;
 
   /** @brief Main game interface reference */
   MultiMain* main;
@@ -218,7 +212,7 @@ class MultiBoard : public QWidget {
   QLabel* redCardText;
 
   // Game state
-  /** @brief List of words used in the game */
+  /** @brief Words of the cards row by row, as sent in BOARD_SETUP */
   QStringList m_words;
   /** @brief List of card colors/teams */
   QStringList m_tileColors;
@@ -227,18 +221,18 @@ class MultiBoard : public QWidget {
   /** @brief Index of the current turn */
   int m_currentTurnIndex;
 
-  // Cards remaining
-  /** @brief Number of red team cards left */
-  int redCardsRemaining;
-  /** @brief Number of blue team cards left */
-  int blueCardsRemaining;
-
   // Limit guess 
   /** @brief Current number of guesses */
   int currentGuesses;
   /** @brief Maximum number of allowed guesses */
   int maxGuesses;
 
+  /** @brief Whether the result of this game was already recorded */
+  bool m_gameRecorded = false;
+
+  /** @brief Clues and reveals of this game, for the match history */
+  MatchRecord m_matchRecord;
+
   /**
    * @brief Sets up the user interface for the game board.
    *
@@ -289,21 +283,10 @@ class MultiBoard : public QWidget {
    */
   void sendInitialGameState();
 
-  /**
-   * @brief Loads word list from a file.
-   *
-   * @details Reads the dictionary of possible words from a data file
-   * to use for populating the game board.
-   *
-   * @author Group 9
-   */
-  void loadWordsFromFile();
-
   /**
    * @brief Generates the game grid layout.
    *
-   * @details Creates the visual grid of cards with words and
-   * configures their initial appearance and behavior.
+   * @details Deals the words and key card of the grid with BoardDealer.
    *
    * @author Group 9
    */
@@ -319,6 +302,21 @@ class MultiBoard : public QWidget {
    */
   void checkGameEnd();
 
+  /**
+   * @brief Records the result of this game and rates its players.
+   *
+   * @details Completes the match record with the board and the winner,
+   * rates the four seats and appends the record to the match history, once
+   * per game and on the host only. Only users in the local profile get
+   * stored ratings.
+   *
+   * @param redWon True if the red team won the game.
+   * @param reason How the game was decided.
+   *
+   * @author Group 9
+   */
+  void recordResult(bool redWon, MatchRecord::EndReason reason);
+
   /**
    * @brief Processes a chat message from a player.
    *
@@ -415,12 +413,31 @@ class MultiBoard : public QWidget {
    */
   void endGame(const QString& message);
 
+  /**
+   * @brief What a card hides.
+   *
+   * @param row The row of the card.
+   * @param col The column of the card.
+   * @return CardType The type of the card, read from the board state.
+   *
+   * @author Group 9
+   */
+  CardType cardType(int row, int col) const;
+
+  /**
+   * @brief Shows the cards each team has left to find.
+   *
+   * @details The counts are popcounts of the board state, so the labels
+   * agree with the revealed cards however often they are refreshed.
+   *
+   * @author Group 9
+   */
+  void updateCardCounts();
+
   /** @brief Size of the game grid (5x5) */
   static const int GRID_SIZE = 5;
-  /** @brief 2D array of game cards */
-  Card gameGrid[GRID_SIZE][GRID_SIZE];
-  /** @brief List of available words */
-  QStringList wordList;
+  /** @brief Key card and revealed cards of the grid, row by row */
+  BoardState boardState;
   /** @brief 2D array of card buttons */
   QPushButton* cards[GRID_SIZE][GRID_SIZE];
   /** @brief Label showing current hint */
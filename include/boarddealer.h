@@ -0,0 +1,107 @@
+/**
+ * @file boarddealer.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Deals the words and key card of a new board
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef BOARDDEALER_H
+#define BOARDDEALER_H
+
+#include <QString>  // For board codes
+
+#include "boardrandom.h"  // For dealing boards
+#include "wordpool.h"     // For the words boards are dealt from
+
+/**
+ * @brief Generates boards without touching the heap
+ *
+ * A board is 25 positions into the WordPool and a key card of 25 agents,
+ * both in fixed arrays. Dealing one costs the same whatever the size of the
+ * pool: the words are sampled with Floyd's algorithm and the key card is a
+ * shuffle of a constant layout.
+ *
+ * Every board is dealt from a 32-bit seed with BoardRandom, so the same seed
+ * and word list always give the same words and key card. A board code, eight
+ * characters of Crockford base32 holding the seed and a byte of the word
+ * list's fingerprint, lets players share a board or replay one.
+ */
+class BoardDealer {
+ public:
+  /**
+   * @brief Cards on a board
+   */
+  static const int Cells = 25;
+
+  /**
+   * @brief What a card hides, in the order of the boards' CardType
+   */
+  enum Agent : quint8 { RedAgent, BlueAgent, Bystander, Assassin };
+
+  /**
+   * @brief Agents of each kind; red starts, so red has one more
+   */
+  static const int RedAgents = 9;
+  static const int BlueAgents = 8;
+  static const int Bystanders = 7;
+
+  /**
+   * @brief One dealt board, row by row
+   */
+  struct Board {
+    quint32 seed;           ///< what the board was dealt from
+    int words[Cells];       ///< positions into WordPool::instance()
+    quint8 keyCard[Cells];  ///< the Agent under each card
+  };
+
+  /**
+   * @brief Deal a board from a seed drawn at random
+   *
+   * @param board receives the board and its seed
+   * @return `bool` false if the word pool has fewer than Cells words
+   */
+  static bool deal(Board& board);
+
+  /**
+   * @brief Deal the board of a seed
+   *
+   * @param board receives the board
+   * @param seed the same seed gives the same board
+   * @return `bool` false if the word pool has fewer than Cells words
+   */
+  static bool deal(Board& board, quint32 seed);
+
+  /**
+   * @brief Shuffle a fresh key card
+   * A Fisher-Yates pass over the fixed layout of agents
+   *
+   * @param keyCard receives the Agent of every card
+   * @param rng the generator to draw from
+   */
+  static void dealKeyCard(quint8 (&keyCard)[Cells], BoardRandom& rng);
+
+  /**
+   * @brief The code players can share to deal a board again
+   *
+   * @param seed the seed of the board
+   * @return `QString` eight characters, for example "3F9K-QX2M"
+   */
+  static QString boardCode(quint32 seed);
+
+  /**
+   * @brief Read a board code back
+   * Case, dashes and spaces are ignored, and O, I and L are read as 0, 1
+   * and 1
+   *
+   * @param code the code as typed
+   * @param seed receives the seed of the board
+   * @return `bool` false if the code is malformed or was made with another
+   * word list
+   */
+  static bool seedFromCode(const QString& code, quint32* seed);
+};
+
+#endif  // BOARDDEALER_H
@@ -0,0 +1,94 @@
+/**
+ * @file boardqueue.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Boards dealt ahead of time on a worker thread
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef BOARDQUEUE_H
+#define BOARDQUEUE_H
+
+#include <QFutureWatcher>  // For boards dealt on a worker thread
+#include <QObject>         // Base class, lives in the GUI thread
+#include <QQueue>          // For the ready boards
+#include <QVector>         // For a batch of dealt boards
+
+#include "boarddealer.h"  // For the boards
+
+/**
+ * @brief Keeps a few random boards ready so a new game starts at once
+ * Boards are dealt on the global thread pool with QtConcurrent and handed
+ * back to the GUI thread, which owns the queue, so the queue needs no lock.
+ * Taking a board starts dealing its replacement. A board is ready to bind:
+ * its key card and its words, which are positions into the shared WordPool
+ * and resolve to their strings without copying.
+ */
+class BoardQueue : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief Start dealing the first boards
+   *
+   * @param depth how many boards to keep ready
+   * @param parent owner of the queue
+   */
+  explicit BoardQueue(int depth = 3, QObject* parent = nullptr);
+
+  /**
+   * @brief Wait for boards being dealt, so no work outlives the queue
+   */
+  ~BoardQueue();
+
+  /**
+   * @brief Take the oldest ready board and deal a replacement
+   *
+   * @param board receives the board
+   * @return `bool` false if none is ready yet, deal one with BoardDealer
+   */
+  bool take(BoardDealer::Board& board);
+
+  /**
+   * @brief Number of ready boards
+   *
+   * @return `int` at most the depth
+   */
+  int size() const;
+
+ private slots:
+  /**
+   * @brief Queue the boards of a finished batch
+   */
+  void onBoardsDealt();
+
+ private:
+  /**
+   * @brief Deal the missing boards unless a batch is already being dealt
+   */
+  void refill();
+
+  /**
+   * @brief how many boards to keep ready
+   */
+  int depth;
+
+  /**
+   * @brief whether a batch is being dealt
+   */
+  bool refilling;
+
+  /**
+   * @brief the ready boards, oldest first
+   */
+  QQueue<BoardDealer::Board> boards;
+
+  /**
+   * @brief reports the batch being dealt
+   */
+  QFutureWatcher<QVector<BoardDealer::Board>>* dealWatcher;
+};
+
+#endif  // BOARDQUEUE_H
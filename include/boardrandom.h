@@ -0,0 +1,55 @@
+/**
+ * @file boardrandom.h
+ * @author Team 9 - UWO CS 3307
+ * @brief The random number generator boards are dealt with
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef BOARDRANDOM_H
+#define BOARDRANDOM_H
+
+#include <QtGlobal>  // For quint32 and quint64
+
+/**
+ * @brief PCG32 generator, the same numbers from the same seed everywhere
+ *
+ * QRandomGenerator does not promise the same sequence across Qt versions or
+ * platforms, so boards are dealt with this one instead: PCG-XSH-RR with 64
+ * bits of state and a fixed stream. The output and bounded() are defined
+ * here, so a seed names one board for as long as the word list is the same.
+ */
+class BoardRandom {
+ public:
+  /**
+   * @brief Start the sequence of a seed
+   *
+   * @param seed any value, equal seeds give equal sequences
+   */
+  explicit BoardRandom(quint32 seed);
+
+  /**
+   * @brief The next 32 random bits
+   *
+   * @return `quint32` uniformly distributed
+   */
+  quint32 generate();
+
+  /**
+   * @brief A number below a bound, without modulo bias
+   *
+   * @param bound the exclusive upper limit, more than 0
+   * @return `quint32` uniformly distributed in [0, bound)
+   */
+  quint32 bounded(quint32 bound);
+
+ private:
+  /**
+   * @brief the LCG state
+   */
+  quint64 state;
+};
+
+#endif  // BOARDRANDOM_H
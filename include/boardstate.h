@@ -0,0 +1,158 @@
+/**
+ * @file boardstate.h
+ * @author Team 9 - UWO CS 3307
+ * @brief The key card and reveals of a board as bit masks
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef BOARDSTATE_H
+#define BOARDSTATE_H
+
+#include <QtGlobal>  // For quint32 and qPopulationCount
+
+#include "boarddealer.h"  // For the cells and agents of a board
+
+/**
+ * @brief What every card hides and which cards are face up
+ *
+ * One 32-bit mask per agent and one for the revealed cards, bit k standing
+ * for card k counted row by row. Counting what a team has left, checking for
+ * a win or for the assassin, or listing the cards a team still has to find
+ * are a mask AND and a popcount instead of a pass over the grid, so boards
+ * and bots can ask as often as they like. The words are not part of the
+ * state, boards keep them in a separate array of word ids.
+ */
+class BoardState {
+ public:
+  /**
+   * @brief Cards on a board, bit k of a mask is card k
+   */
+  static const int Cells = BoardDealer::Cells;
+
+  /**
+   * @brief An empty board, no agents and nothing revealed
+   */
+  BoardState();
+
+  /**
+   * @brief The state of a freshly dealt board
+   *
+   * @param board the dealt key card, its words are not kept
+   */
+  explicit BoardState(const BoardDealer::Board& board);
+
+  /**
+   * @brief Forget every agent and reveal
+   */
+  void clear();
+
+  /**
+   * @brief Place an agent under a card, used to rebuild a received board
+   *
+   * @param cell the card, 0 <= cell < Cells
+   * @param agent what the card hides
+   */
+  void setAgent(int cell, BoardDealer::Agent agent);
+
+  /**
+   * @brief What a card hides
+   *
+   * @param cell the card, 0 <= cell < Cells
+   * @return `BoardDealer::Agent` the agent, Bystander if none was placed
+   */
+  BoardDealer::Agent agentAt(int cell) const;
+
+  /**
+   * @brief Turn a card face up
+   *
+   * @param cell the card, 0 <= cell < Cells
+   * @return `bool` false if it already was
+   */
+  bool reveal(int cell);
+
+  /**
+   * @brief Whether a card is face up
+   *
+   * @param cell the card, 0 <= cell < Cells
+   * @return `bool` true once reveal() was called for it
+   */
+  bool isRevealed(int cell) const { return revealedMask & bit(cell); }
+
+  /**
+   * @brief Every face up card
+   *
+   * @return `quint32` the revealed mask
+   */
+  quint32 revealed() const { return revealedMask; }
+
+  /**
+   * @brief Every card hiding an agent, revealed or not
+   *
+   * @param agent the agent
+   * @return `quint32` its mask
+   */
+  quint32 cards(BoardDealer::Agent agent) const { return masks[agent]; }
+
+  /**
+   * @brief Cards hiding an agent that are still face down
+   *
+   * @param agent the agent, a team's for the cards it has left to find
+   * @return `quint32` the face down part of its mask
+   */
+  quint32 unrevealed(BoardDealer::Agent agent) const {
+    return masks[agent] & ~revealedMask;
+  }
+
+  /**
+   * @brief Number of face down cards hiding an agent
+   *
+   * @param agent the agent
+   * @return `int` the popcount of unrevealed()
+   */
+  int remaining(BoardDealer::Agent agent) const {
+    return int(qPopulationCount(unrevealed(agent)));
+  }
+
+  /**
+   * @brief Whether a team has found all of its agents
+   *
+   * @param team RedAgent or BlueAgent
+   * @return `bool` true once the team has agents and none is face down
+   */
+  bool cleared(BoardDealer::Agent team) const {
+    return masks[team] != 0 && unrevealed(team) == 0;
+  }
+
+  /**
+   * @brief Whether the assassin is face up
+   *
+   * @return `bool` true if the game was lost on the assassin
+   */
+  bool assassinRevealed() const {
+    return (masks[BoardDealer::Assassin] & revealedMask) != 0;
+  }
+
+ private:
+  /**
+   * @brief The mask of one card
+   *
+   * @param cell the card
+   * @return `quint32` bit cell set
+   */
+  static quint32 bit(int cell) { return quint32(1) << cell; }
+
+  /**
+   * @brief One mask per agent, indexed by BoardDealer::Agent
+   */
+  quint32 masks[4];
+
+  /**
+   * @brief The face up cards
+   */
+  quint32 revealedMask;
+};
+
+#endif  // BOARDSTATE_H
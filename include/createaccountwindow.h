@@ -13,11 +13,8 @@
 #ifndef CREATEACCOUNTWINDOW_H
 #define CREATEACCOUNTWINDOW_H
 
-#include <QDir>
-#include <QFile>
+#include <QDebug>
 #include <QHBoxLayout>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
@@ -27,7 +24,7 @@
 /**
  * @brief The CreateAccountWindow class provides a singleton interface for
  * creating new user accounts This window allows users to input a username and
- * creates a profile JSON file for the new account
+ * adds the account to the profile store
  */
 class CreateAccountWindow : public QWidget {
   Q_OBJECT
@@ -95,18 +92,12 @@ class CreateAccountWindow : public QWidget {
   /**
    * @brief Signal emitted when a new account is successfully created
    *        Notifies other components to update their user lists
-   */
-  void accountCreated();
-
- private:
-  /**
-   * @brief Creates and saves a JSON profile file for the new user
-   *        Stores basic user information in the specified JSON file
    *
-   * @param username The username for the new account
+   * @param username The username of the new account
    */
-  void saveJsonFile(const QString& username);
+  void accountCreated(const QString& username);
 
+ private:
   /**
    * @brief Text input field for entering the new username
    */
@@ -122,12 +113,6 @@ class CreateAccountWindow : public QWidget {
    */
   QLabel* statusLabel;
 
-  /**
-   * @brief Path to the JSON profile file where user data will be stored
-   *        May need to be updated based on deployment environment
-   */
-  QString jsonFilePath = "resources/profile.json";  // Update path as necessary
-
   /**
    * @brief Pointer to the previous screen to return to after account creation
    *        Set via setPreviousScreen() method
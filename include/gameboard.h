@@ -21,11 +21,17 @@
 #include <QVBoxLayout>
 #include <QWidget>
 
+#include "boarddealer.h"
+#include "boardqueue.h"
+#include "boardstate.h"
 #include "chatbox.h"
+#include "matchhistory.h"
 #include "operatorguess.h"
 #include "spymasterhint.h"
+#include "statssession.h"
 #include "transition.h"
 #include "user.h"
+#include "wordpool.h"
 
 /**
  * @class GameBoard
@@ -121,6 +127,19 @@ class GameBoard : public QWidget {
    */
   void setBlueOperativeName(const QString& name);
 
+  /**
+   * @brief Deals the next game from a seed instead of at random.
+   *
+   * @details Used when players enter a board code, so every table playing
+   * that code gets the same words and key card. Only the next board is
+   * affected, later ones are random again.
+   *
+   * @param seed The seed of the board, read from its code.
+   *
+   * @author Group 9
+   */
+  void setNextSeed(quint32 seed);
+
   /**
    * @brief Updates the labels displaying team information.
    *
@@ -176,19 +195,10 @@ class GameBoard : public QWidget {
   void displayGuess();
 
  private:
-  /**
-   * @brief Loads words from a file and generates the game grid.
-   *
-   * @details Loads words from a file and generates the game grid.
-   *
-   * @author Group 9
-   */
-  void loadWordsFromFile();
-
   /**
    * @brief Generates the game grid.
    *
-   * @details Generates the game grid based on the loaded words.
+   * @details Deals the words and key card of the grid with BoardDealer.
    *
    * @author Group 9
    */
@@ -263,6 +273,20 @@ class GameBoard : public QWidget {
    */
   void checkGameEnd();
 
+  /**
+   * @brief Records the result of the game and rates the four players.
+   *
+   * @details Sets the winner of the match record, then rates the spymaster
+   * and operative of each team in their role against the other team. The
+   * record is written by endGame.
+   *
+   * @param redWon True if the red team won the game.
+   * @param reason How the game was decided.
+   *
+   * @author Group 9
+   */
+  void recordResult(bool redWon, MatchRecord::EndReason reason);
+
   /**
    * @brief Ends the game and displays a message.
    *
@@ -297,22 +321,29 @@ class GameBoard : public QWidget {
   enum Turn { RED_SPY, RED_OP, BLUE_SPY, BLUE_OP };
 
   /**
-   * @brief Structure representing a card in the game grid.
+   * @brief The word on a card.
+   *
+   * @param row The row of the card.
+   * @param col The column of the card.
+   * @return `const QString&` The word, looked up in the word pool.
+   *
+   * @author Group 9
+   */
+  const QString& cardWord(int row, int col) const;
+
+  /**
+   * @brief What a card hides.
+   *
+   * @param row The row of the card.
+   * @param col The column of the card.
+   * @return `CardType` The type of the card, read from the board state.
    *
-   * @details Contains the word, type, and revealed status of the card.
+   * @author Group 9
    */
-  struct Card {
-    QString word;
-    CardType type;
-    bool revealed;
-  };
+  CardType cardType(int row, int col) const;
 
   /** @brief Structure representing a turn in the game board. */
   int currentTurn;
-  /** @brief The number of remaining cards for each team.*/
-  int redCardsRemaining;
-  /** @brief The number of remaining cards for each team.*/
-  int blueCardsRemaining;
 
   /** @brief The maximum number of guesses allowed in a turn.*/
   int maxGuesses = 0;
@@ -330,10 +361,16 @@ class GameBoard : public QWidget {
 
   /** @brief The size of the game grid.*/
   static const int GRID_SIZE = 5;
-  /** @brief The game grid.*/
-  Card gameGrid[GRID_SIZE][GRID_SIZE];
-  /** @brief The list of words.*/
-  QStringList wordList;
+  /** @brief The key card and revealed cards of the grid, row by row.*/
+  BoardState boardState;
+  /** @brief The word ids of the grid into the word pool, row by row.*/
+  int wordIds[GRID_SIZE * GRID_SIZE];
+  /** @brief Random boards dealt ahead on a worker thread.*/
+  BoardQueue* boardQueue;
+  /** @brief Whether the next board is dealt from nextSeed.*/
+  bool hasNextSeed = false;
+  /** @brief The seed of the next board, if one was given.*/
+  quint32 nextSeed = 0;
 
   /** @brief The grid layout for the game board.*/
   QGridLayout* gridLayout;
@@ -372,6 +409,11 @@ class GameBoard : public QWidget {
   ChatBox::Team currentPlayerTeam;
   /** @brief The list of users in the game.*/
   User* users;
+  /** @brief Statistics of the current game, written once when it ends.*/
+  StatsSession statsSession;
+  /** @brief Clues and reveals of the current game, appended to the match
+   * history when it ends.*/
+  MatchRecord matchRecord;
 };
 
 #endif  // GAMEBOARD_H
\ No newline at end of file
@@ -0,0 +1,263 @@
+/**
+ * @file leaderboard.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Ranked indexes of the users by wins, win rate and hit rate
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <QHash>     // For the counters of every ranked user
+#include <QList>     // For top-K results
+#include <QString>   // For usernames
+#include <vector>    // For the node pool of the ranked index
+
+#include "statscounters.h"  // For the counters a user is ranked by
+
+/**
+ * @brief One row of a leaderboard
+ */
+struct LeaderboardEntry {
+  int rank = 0;       ///< 1-based position
+  QString username;   ///< the ranked user
+  double score = 0;   ///< wins, or a rate between 0 and 1
+};
+
+/**
+ * @brief Users ordered by score, with rank and position lookups
+ *
+ * An order-statistic treap: every node stores the size of its subtree, so
+ * inserting, erasing and finding the rank of a user are O(log n), and the
+ * first K entries are read in O(K + log n). Higher scores come first, ties
+ * are ordered by username. Nodes live in one vector and refer to each other
+ * by index.
+ */
+class RankIndex {
+ public:
+  /**
+   * @brief Add a user with a score
+   *
+   * @param score the value the user is ranked by
+   * @param username the user, must not already be in the index
+   */
+  void insert(double score, const QString& username);
+
+  /**
+   * @brief Remove a user
+   *
+   * @param score the score the user was inserted with
+   * @param username the user
+   */
+  void erase(double score, const QString& username);
+
+  /**
+   * @brief 0-based position of a user
+   *
+   * @param score the score the user was inserted with
+   * @param username the user
+   * @return `int` the number of users ranked before this one
+   */
+  int position(double score, const QString& username) const;
+
+  /**
+   * @brief The first entries of the index
+   *
+   * @param count how many entries to return at most
+   * @return `QList<LeaderboardEntry>` the entries, best first
+   */
+  QList<LeaderboardEntry> top(int count) const;
+
+  /**
+   * @brief Number of users in the index
+   *
+   * @return `int` the size of the index
+   */
+  int size() const;
+
+  /**
+   * @brief Remove every user
+   */
+  void clear();
+
+ private:
+  /**
+   * @brief A user in the treap
+   */
+  struct Node {
+    double score;
+    QString username;
+    quint32 priority;  ///< heap order, random so the tree stays balanced
+    int left;
+    int right;
+    int size;  ///< nodes in this subtree
+  };
+
+  /**
+   * @brief Whether (score, username) is ranked before a node
+   */
+  static bool before(double score, const QString& username, const Node& node);
+
+  /**
+   * @brief Size of a subtree, 0 for no node
+   */
+  int sizeOf(int node) const;
+
+  /**
+   * @brief Recompute the subtree size of a node from its children
+   */
+  void update(int node);
+
+  /**
+   * @brief Join two treaps where every node of left ranks first
+   *
+   * @return `int` the root of the joined treap
+   */
+  int merge(int left, int right);
+
+  /**
+   * @brief Split a treap into the nodes ranked before (score, username) and
+   * the rest
+   */
+  void split(int node, double score, const QString& username, int& left,
+             int& right);
+
+  /**
+   * @brief Remove (score, username) from the treap rooted at node
+   *
+   * @return `int` the new root of that treap
+   */
+  int eraseFrom(int node, double score, const QString& username);
+
+  /**
+   * @brief Append up to count entries of a subtree in order
+   */
+  void collect(int node, int count, QList<LeaderboardEntry>& entries) const;
+
+  /**
+   * @brief Next treap priority, from a xorshift generator
+   */
+  quint32 nextPriority();
+
+  /**
+   * @brief every node, live or free
+   */
+  std::vector<Node> nodes;
+
+  /**
+   * @brief indexes of nodes that can be reused
+   */
+  std::vector<int> freeNodes;
+
+  /**
+   * @brief index of the root node, -1 when empty
+   */
+  int root = -1;
+
+  /**
+   * @brief state of the priority generator
+   */
+  quint32 seed = 0x9E3779B9u;
+};
+
+/**
+ * @brief Leaderboards kept up to date as statistics change
+ *
+ * Holds one RankIndex per metric. A user is ranked by win rate only after
+ * MinGames games, and by hit rate only after MinGuesses guesses, so a single
+ * lucky game does not top the board. update() is O(log n) per metric, so
+ * it can be called on every won/lost/hit/miss.
+ */
+class Leaderboard {
+ public:
+  /**
+   * @brief What the users are ranked by
+   */
+  enum Metric { Wins, WinRate, HitRate, MetricCount };
+
+  /// games needed before a user is ranked by win rate
+  static const unsigned int MinGames = 5;
+  /// guesses needed before a user is ranked by hit rate
+  static const unsigned int MinGuesses = 10;
+
+  /**
+   * @brief Set the counters of a user, adding the user if needed
+   *
+   * @param username the user
+   * @param counters the current statistics of the user
+   */
+  void update(const QString& username, const StatsCounters& counters);
+
+  /**
+   * @brief Remove a user from every index
+   *
+   * @param username the user
+   */
+  void remove(const QString& username);
+
+  /**
+   * @brief Move a user to a new name, keeping the counters
+   *
+   * @param oldUsername the current username
+   * @param newUsername the new username
+   */
+  void rename(const QString& oldUsername, const QString& newUsername);
+
+  /**
+   * @brief Remove every user
+   */
+  void clear();
+
+  /**
+   * @brief The best users for a metric
+   *
+   * @param metric what to rank by
+   * @param count how many entries to return at most
+   * @return `QList<LeaderboardEntry>` the entries, best first
+   */
+  QList<LeaderboardEntry> top(Metric metric, int count) const;
+
+  /**
+   * @brief 1-based rank of a user for a metric
+   *
+   * @param metric what to rank by
+   * @param username the user
+   * @return `int` the rank, 0 if the user is not ranked for this metric
+   */
+  int rank(Metric metric, const QString& username) const;
+
+  /**
+   * @brief Number of users ranked for a metric
+   *
+   * @param metric what to rank by
+   * @return `int` the number of ranked users
+   */
+  int size(Metric metric) const;
+
+ private:
+  /**
+   * @brief Score of counters for a metric
+   *
+   * @param metric what to rank by
+   * @param counters the statistics of a user
+   * @param score set to the score if the user qualifies
+   * @return `bool` false if the user is not ranked for this metric
+   */
+  static bool scoreOf(Metric metric, const StatsCounters& counters,
+                      double& score);
+
+  /**
+   * @brief the counters each user is currently indexed with
+   */
+  QHash<QString, StatsCounters> ranked;
+
+  /**
+   * @brief one index per metric
+   */
+  RankIndex indexes[MetricCount];
+};
+
+#endif  // LEADERBOARD_H
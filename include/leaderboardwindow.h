@@ -0,0 +1,133 @@
+/**
+ * @file leaderboardwindow.h
+ * @author Team 9 - UWO CS 3307
+ * @brief The screen to show the best users and the rank of a user
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef LEADERBOARD_WINDOW_H
+#define LEADERBOARD_WINDOW_H
+
+// Qt framework includes for UI components and screen management
+#include <QComboBox>        // For the metric and username dropdowns
+#include <QGuiApplication>  // For application-level GUI functionality
+#include <QHBoxLayout>      // For horizontal layout arrangement
+#include <QHeaderView>      // For sizing the table columns
+#include <QLabel>           // For text display in UI
+#include <QPushButton>      // For button UI elements
+#include <QScreen>          // For screen geometry information
+#include <QTableWidget>     // For the top-K table
+#include <QVBoxLayout>      // For vertical layout arrangement
+
+#include "user.h"  // Include for user data access
+
+// Forward declaration to resolve circular dependency
+class User;
+
+/**
+ * @brief The class that shows the Leaderboard screen
+ * Lists the best users by wins, win rate or guess hit rate, and the rank of
+ * a selected user. Reads the rankings kept by the profile store, so nothing
+ * is sorted when the screen is opened.
+ */
+class LeaderboardWindow : public QWidget {
+  Q_OBJECT
+
+ signals:
+  /**
+   * @brief Go back to the main window
+   * Signal emitted when user chooses to return to main menu
+   */
+  void backToMainWindow();
+
+ public:
+  /**
+   * @brief Construct a new Leaderboard Window object
+   * Initializes UI components and connects signals/slots
+   *
+   * @param parent the parent of the leaderboard screen for widget hierarchy
+   */
+  explicit LeaderboardWindow(QWidget* parent = nullptr);
+
+  /**
+   * @brief Number of users listed in the table
+   */
+  static const int TopCount = 10;
+
+ public slots:
+  /**
+   * @brief show the leaderboard screen
+   * Makes the leaderboard UI visible with the current rankings
+   */
+  void show();
+
+ private slots:
+  /**
+   * @brief to back to the main window
+   * Slot triggered when back button is clicked
+   */
+  void goBackToMain();
+
+  /**
+   * @brief fill the table with the best users of the selected metric
+   * Also updates the rank of the selected user
+   */
+  void refresh();
+
+  /**
+   * @brief show the rank of the user selected in the drop down menu
+   */
+  void showUserRank();
+
+ private:
+  /**
+   * @brief Format a score of the selected metric for display
+   *
+   * @param score wins, or a rate between 0 and 1
+   * @return `QString` the score as shown in the table
+   */
+  QString formatScore(double score) const;
+
+  /**
+   * @brief The metric selected in the drop down menu
+   *
+   * @return `Leaderboard::Metric` what the users are ranked by
+   */
+  Leaderboard::Metric selectedMetric() const;
+
+  /**
+   * @brief the profile store of the User singleton
+   * Reference to access the rankings
+   */
+  ProfileStore* users;
+
+  /**
+   * @brief button to click to go back to main
+   */
+  QPushButton* backToMainButton;
+
+  /**
+   * @brief the drop down box of what to rank by
+   */
+  QComboBox* metricComboBox;
+
+  /**
+   * @brief the best users of the selected metric
+   */
+  QTableWidget* topTable;
+
+  /**
+   * @brief the drop down box of usernames
+   */
+  QComboBox* usernameComboBox;
+
+  /**
+   * @brief the rank of the selected user
+   */
+  QLabel* userRankLabel;
+};
+
+#endif  // LEADERBOARD_WINDOW_H
@@ -18,6 +18,7 @@
 
 #include "Multiplayer/multimain.h"
 #include "createaccountwindow.h"
+#include "leaderboardwindow.h"
 #include "pregame.h"
 #include "statisticswindow.h"
 #include "tutorial.h"
@@ -27,6 +28,7 @@ class PreGame;
 class User;
 class CreateAccountWindow;
 class StatisticsWindow;
+class LeaderboardWindow;
 class Tutorial;
 class MultiMain;
 
@@ -71,6 +73,11 @@ class MainWindow : public QMainWindow {
    */
   void openStatsWindow();
 
+  /**
+   * @brief Opens the leaderboard window.
+   */
+  void openLeaderboard();
+
   /**
    * @brief Opens the Create Account window.
    */
@@ -100,6 +107,7 @@ class MainWindow : public QMainWindow {
   QPushButton* onlinePlayButton;  ///< Button for starting an online game.
   QPushButton* tutorialButton;    ///< Button for opening the tutorial.
   QPushButton* statsButton;       ///< Button for opening the statistics window.
+  QPushButton* leaderboardButton;  ///< Button for opening the leaderboard.
   QPushButton*
       createAccountButton;  ///< Button for opening the account creation window.
 
@@ -109,6 +117,8 @@ class MainWindow : public QMainWindow {
       createAccountWindow;  ///< Pointer to the account creation window.
   StatisticsWindow*
       statsWindow;  ///< Pointer to the statistics window displaying game stats.
+  LeaderboardWindow*
+      leaderboardWindow;  ///< Pointer to the leaderboard of the best users.
   Tutorial* tutorialWindow;  ///< Pointer to the tutorial window explaining the
                              ///< game mechanics.
 };
@@ -0,0 +1,270 @@
+/**
+ * @file matchhistory.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Append-only, segmented binary history of finished games
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef MATCHHISTORY_H
+#define MATCHHISTORY_H
+
+#include <QByteArray>  // For encoded records
+#include <QFile>       // For the active log
+#include <QList>       // For the sealed segments
+#include <QString>     // For usernames, words and paths
+#include <QVector>     // For clues, reveals and results
+#include <functional>  // For the scan callback
+
+#include "ratingengine.h"  // For MatchResult and the seat order
+
+/**
+ * @brief Everything recorded about one finished game
+ * Seats and card types use the order of RatingEngine::Seat and of the
+ * CardType enums of the game boards.
+ */
+struct MatchRecord {
+  /**
+   * @brief How the game was decided
+   */
+  enum EndReason : quint8 { AllAgentsFound, AssassinRevealed };
+
+  /**
+   * @brief A clue given by a spymaster
+   */
+  struct Clue {
+    quint8 seat = 0;    ///< the spymaster's seat
+    quint8 number = 0;  ///< number of words, 0 for unlimited
+    qint32 atMs = 0;    ///< ms since the game started
+    QString word;       ///< the clue
+  };
+
+  /**
+   * @brief A card revealed by an operative
+   */
+  struct Reveal {
+    quint8 cell = 0;  ///< row * 5 + column
+    quint8 seat = 0;  ///< the operative's seat
+    qint32 atMs = 0;  ///< ms since the game started
+  };
+
+  static const int Cells = 25;  ///< cards on the board
+
+  qint64 startedAt = 0;               ///< ms since epoch
+  qint64 endedAt = 0;                 ///< ms since epoch
+  QString players[4];                 ///< usernames, by seat
+  bool redWon = false;                ///< true if the red team won
+  quint8 endReason = AllAgentsFound;  ///< an EndReason
+  QString words[Cells];               ///< board words, row by row
+  quint8 keyCard[Cells] = {};         ///< card type of each cell
+  QVector<Clue> clues;                ///< clues in the order given
+  QVector<Reveal> reveals;            ///< reveals in the order made
+
+  /**
+   * @brief Start recording a new game now
+   */
+  void start();
+
+  /**
+   * @brief Record a clue given now
+   *
+   * @param seat the spymaster's seat
+   * @param word the clue
+   * @param number number of words, 0 for unlimited
+   */
+  void addClue(int seat, const QString& word, int number);
+
+  /**
+   * @brief Record a card revealed now
+   *
+   * @param cell row * 5 + column
+   * @param seat the operative's seat
+   */
+  void addReveal(int cell, int seat);
+
+  /**
+   * @brief The players and winner, for rating the game
+   *
+   * @return `MatchResult` the result of the game
+   */
+  MatchResult result() const;
+};
+
+/**
+ * @brief Append-only store of finished games
+ *
+ * New games are appended as length-prefixed rows to active.cnmr, so
+ * finishing a game costs one write. Once it holds SegmentGames games the
+ * log is sealed: rewritten into an immutable segment-<first game>.cnmc file
+ * that stores each field as its own column (all timestamps, then all
+ * winners, then all player ids, ...) next to a dictionary of the strings
+ * used, and emptied. Scans map the sealed segments and read just the
+ * columns they need, front to back. A torn row at the end of the log, from
+ * a crash mid-append, is dropped when the store is opened.
+ *
+ * Several instances may share the directory. Every call holds its lock
+ * (history.lock) while it reads or changes the log, and first catches up
+ * with the games and segments other instances added: an append lands at
+ * the end of the log as it is on disk, and a scan sees every game. Sealed
+ * segments never change, so scans read them after releasing the lock.
+ */
+class MatchHistory {
+ public:
+  /// games in the active log before it is sealed into a segment
+  static const int SegmentGames = 4096;
+
+  /**
+   * @brief Construct a store for a directory, call open() before use
+   *
+   * @param dirPath the directory of the log and segments
+   */
+  explicit MatchHistory(const QString& dirPath);
+
+  /**
+   * @brief Open the active log, recovering it and the segment list
+   *
+   * @return `bool` true if games can be appended
+   */
+  bool open();
+
+  /**
+   * @brief Add a finished game
+   *
+   * @param record the game
+   * @return `bool` true if the game was written
+   */
+  bool append(const MatchRecord& record);
+
+  /**
+   * @brief Number of recorded games
+   *
+   * @return `quint64` games in the segments and the active log
+   */
+  quint64 gameCount() const;
+
+  /**
+   * @brief Players and winner of every game, oldest first
+   * Reads only the player, winner and end time columns
+   *
+   * @return `QVector<MatchResult>` one result per game
+   */
+  QVector<MatchResult> results() const;
+
+  /**
+   * @brief Decode every game, oldest first
+   *
+   * @param visit called for each game, return false to stop
+   * @return `bool` false if a file could not be read
+   */
+  bool forEachGame(const std::function<bool(const MatchRecord&)>& visit) const;
+
+ private:
+  /**
+   * @brief A sealed, columnar segment
+   */
+  struct Segment {
+    QString path;        ///< the segment file
+    quint64 firstGame;   ///< number of the first game in it
+    quint32 count;       ///< games in it
+  };
+
+  /**
+   * @brief Serialize a game as a row of the active log
+   *
+   * @param record the game
+   * @return `QByteArray` the row, without its length prefix
+   */
+  static QByteArray encodeRow(const MatchRecord& record);
+
+  /**
+   * @brief Parse a row of the active log
+   *
+   * @param row the row, without its length prefix
+   * @param record set to the game
+   * @return `bool` false if the row is malformed
+   */
+  static bool decodeRow(const QByteArray& row, MatchRecord& record);
+
+  /**
+   * @brief Decode every row of the active log
+   *
+   * @param records set to the games
+   * @return `bool` false if the log could not be read
+   */
+  bool readActive(QVector<MatchRecord>& records) const;
+
+  /**
+   * @brief Read the segment list and count the games of the active log
+   * Cuts off a torn final row. Caller holds the lock.
+   *
+   * @return `bool` false if the log could not be read or reset
+   */
+  bool load() const;
+
+  /**
+   * @brief Load again if another instance changed the log since
+   * Caller holds the lock.
+   *
+   * @return `bool` true if the state matches the files
+   */
+  bool refresh() const;
+
+  /**
+   * @brief Take the lock and copy what a scan reads
+   *
+   * @param sealed set to the sealed segments
+   * @param records set to the games of the active log
+   * @return `bool` false if the active log could not be read
+   */
+  bool snapshot(QList<Segment>& sealed, QVector<MatchRecord>& records) const;
+
+  /**
+   * @brief Rewrite the active log as a segment and empty it
+   *
+   * @return `bool` true if the segment was written
+   */
+  bool seal();
+
+  /**
+   * @brief Write the header of an empty active log
+   *
+   * @param firstGame number of the next game
+   * @return `bool` true if the header was written
+   */
+  bool resetActive(quint64 firstGame) const;
+
+  /**
+   * @brief the directory of the log and segments
+   */
+  QString dirPath;
+
+  /**
+   * @brief the log new games are appended to, the state below is reloaded
+   * by const calls too once another instance changed the files
+   */
+  mutable QFile active;
+
+  /**
+   * @brief number of the first game in the active log
+   */
+  mutable quint64 activeFirst = 0;
+
+  /**
+   * @brief games in the active log
+   */
+  mutable quint32 activeCount = 0;
+
+  /**
+   * @brief end of the last complete row of the active log
+   */
+  mutable qint64 activeEnd = 0;
+
+  /**
+   * @brief sealed segments, oldest first
+   */
+  mutable QList<Segment> segments;
+};
+
+#endif  // MATCHHISTORY_H
@@ -0,0 +1,313 @@
+/**
+ * @file pairstats.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Memory-mapped win records of teammate and opponent pairs
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PAIRSTATS_H
+#define PAIRSTATS_H
+
+#include <QFile>    // For the mapped file
+#include <QHash>    // For the username <-> id tables and partner lists
+#include <QLockFile>  // For sharing the files with other instances
+#include <QString>  // For usernames and paths
+#include <QVector>  // For names by id and query results
+
+#include "ratingengine.h"  // For MatchResult and the seat order
+
+/**
+ * @brief Record of one user with or against another
+ */
+struct PairRecord {
+  QString other;       ///< the teammate or opponent
+  quint32 games = 0;   ///< games played together or against each other
+  quint32 wins = 0;    ///< of those, games won by the user asked about
+  float winRate = 0;   ///< wins / games, 0 without games
+};
+
+/**
+ * @brief Sparse matrix of pairwise results, mapped into memory
+ *
+ * Every user gets a small id the first time they finish a game; ids are
+ * appended to a names file next to the table and never reused. A pair is
+ * keyed by (lower id, higher id, relation) and its games and wins live in
+ * a 16 byte record of an open-addressing table with linear probing: a 64
+ * byte header and a power-of-two number of records, grown when half full.
+ * For teammates the wins are the games the pair won; for opponents they
+ * are the wins of the lower id, so the other side's record is games -
+ * wins. Recording a game touches six records.
+ *
+ * Each user's teammates and opponents are also listed in memory, built by
+ * one pass over the table when it is opened, so a "best partners" query
+ * only reads that user's records.
+ *
+ * Several instances may share the files. Every public call holds the
+ * table's lock (filePath.lock), so ids are assigned from the names on disk.
+ * A rebuild marks the table it replaces as retired, and every new name or
+ * pair bumps a generation in the header; an instance remaps a retired
+ * table, and rereads the names and partner lists when the generation is not
+ * the one it last saw. Not thread safe within a process.
+ */
+class PairStats {
+ public:
+  /**
+   * @brief How two users were seated
+   */
+  enum Relation : quint32 { Teammates = 0, Opponents = 1 };
+
+  /**
+   * @brief Construct a matrix for a file, call open() before use
+   *
+   * @param filePath path of the table file, names go to filePath.names
+   */
+  explicit PairStats(const QString& filePath);
+
+  /**
+   * @brief Unmap and close the file
+   */
+  ~PairStats();
+
+  /**
+   * @brief Map the table and read the names, creating both if needed
+   *
+   * @param initialCapacity slots of a new table, a power of two
+   * @return `bool` true if the table is mapped
+   */
+  bool open(quint32 initialCapacity = 1024);
+
+  /**
+   * @brief Whether the table is mapped
+   *
+   * @return `bool` true after a successful open()
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Add a finished game to every pair of its players
+   * Empty seats and a user playing both roles of a team are skipped
+   *
+   * @param match the players and winner of the game
+   */
+  void recordGame(const MatchResult& match);
+
+  /**
+   * @brief The record of a user with or against another
+   *
+   * @param username the user asked about
+   * @param other the teammate or opponent
+   * @param relation how they were seated
+   * @return `PairRecord` the record, no games if they never met
+   */
+  PairRecord record(const QString& username, const QString& other,
+                    Relation relation) const;
+
+  /**
+   * @brief Every teammate or opponent of a user, best record first
+   * Sorted by win rate, then by games
+   *
+   * @param username the user asked about
+   * @param relation teammates or opponents
+   * @param minGames pairs with fewer games are left out
+   * @return `QVector<PairRecord>` the records
+   */
+  QVector<PairRecord> records(const QString& username, Relation relation,
+                              quint32 minGames = 1) const;
+
+  /**
+   * @brief Move a user's pairs to a new name
+   * The id stays, only the names file is rewritten
+   *
+   * @param oldUsername the current username
+   * @param newUsername the new username
+   * @return `bool` true if the user had pairs
+   */
+  bool rename(const QString& oldUsername, const QString& newUsername);
+
+ private:
+  /**
+   * @brief Layout of the file header
+   */
+  struct Header {
+    char magic[4];
+    quint32 version;
+    quint32 capacity;    ///< number of records, a power of two
+    quint32 used;        ///< records holding a pair
+    quint32 retired;     ///< non-zero once a rebuild replaced the file
+    quint32 generation;  ///< bumped by every new name, rename and pair
+    quint32 reserved[10];
+  };
+
+  /**
+   * @brief Layout of one record, low == 0 marks an empty slot
+   */
+  struct Record {
+    quint32 low;   ///< lower user id
+    quint32 high;  ///< higher user id, Relation in the top bit
+    quint32 games;
+    quint32 wins;
+  };
+
+  static_assert(sizeof(Header) == 64, "PairStats header must be 64 bytes");
+  static_assert(sizeof(Record) == 16, "PairStats record must be 16 bytes");
+
+  /**
+   * @brief Slot a key starts probing at
+   *
+   * @param low lower user id
+   * @param high higher user id with the relation bit
+   * @return `quint64` a well mixed hash of the key
+   */
+  static quint64 hashKey(quint32 low, quint32 high);
+
+  /**
+   * @brief Find the record of a pair
+   *
+   * @param low lower user id
+   * @param high higher user id with the relation bit
+   * @return `Record*` the record, nullptr if absent
+   */
+  Record* lookup(quint32 low, quint32 high) const;
+
+  /**
+   * @brief The record of two users, by id
+   *
+   * @param id the user asked about
+   * @param otherId the teammate or opponent
+   * @param other the teammate's or opponent's username
+   * @param relation how they were seated
+   * @return `PairRecord` the record, no games if they never met
+   */
+  PairRecord recordOf(quint32 id, quint32 otherId, const QString& other,
+                      Relation relation) const;
+
+  /**
+   * @brief Add a game to a pair, adding the pair if needed
+   *
+   * @param a one user's id
+   * @param b the other user's id
+   * @param relation how they were seated
+   * @param aWon true if a won the game
+   */
+  void addGame(quint32 a, quint32 b, Relation relation, bool aWon);
+
+  /**
+   * @brief Id of a username, assigning and saving a new one if needed
+   *
+   * @param username the username
+   * @return `quint32` the id, 0 if the name could not be saved
+   */
+  quint32 idOf(const QString& username);
+
+  /**
+   * @brief Read the names file into names and ids
+   * Cuts off a name torn by a crash mid-append.
+   *
+   * @return `bool` false if the file is missing or not a names file
+   */
+  bool readNames() const;
+
+  /**
+   * @brief List every user's pairs by one pass over the table
+   * A table referring to ids the names do not know is cleared.
+   */
+  void listPartners() const;
+
+  /**
+   * @brief Catch up with changes another instance made
+   * Remaps a retired table, then rereads the names and partner lists if the
+   * generation changed. Caller holds the lock.
+   *
+   * @return `bool` true if a table is mapped
+   */
+  bool refresh() const;
+
+  /**
+   * @brief Record a change of the names or pairs made by this instance
+   */
+  void bumpGeneration();
+
+  /**
+   * @brief Write every name, in id order
+   *
+   * @return `bool` true if the names file was replaced
+   */
+  bool writeNames() const;
+
+  /**
+   * @brief Write a table of the given size holding the current records
+   * Replaces the file atomically, retires the old table and maps the result.
+   * Caller holds the lock.
+   *
+   * @param capacity slots of the new table, a power of two
+   * @return `bool` true if the new table is mapped
+   */
+  bool rebuild(quint32 capacity);
+
+  /**
+   * @brief Map the open file and check its header
+   *
+   * @return `bool` true if the file holds a valid table
+   */
+  bool map() const;
+
+  /**
+   * @brief Unmap and close the file
+   */
+  void unmap() const;
+
+  /**
+   * @brief path of the table file
+   */
+  QString filePath;
+
+  /**
+   * @brief path of the lock shared with other instances
+   */
+  QString lockPath;
+
+  /**
+   * @brief the mapped file, const reads remap it once it is retired
+   */
+  mutable QFile file;
+
+  /**
+   * @brief start of the mapping, nullptr when closed
+   */
+  mutable uchar* data = nullptr;
+
+  /**
+   * @brief the header in the mapping
+   */
+  mutable Header* header = nullptr;
+
+  /**
+   * @brief the first record in the mapping
+   */
+  mutable Record* pairs = nullptr;
+
+  /**
+   * @brief generation of the table the names and partners were read at
+   */
+  mutable quint32 seenGeneration = 0;
+
+  /**
+   * @brief usernames by id, index 0 unused
+   */
+  mutable QVector<QString> names;
+
+  /**
+   * @brief ids by username
+   */
+  mutable QHash<QString, quint32> ids;
+
+  /**
+   * @brief other ids each id has a record with, by relation
+   */
+  mutable QHash<quint32, QVector<quint32>> partners[2];
+};
+
+#endif  // PAIRSTATS_H
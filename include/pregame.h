@@ -89,12 +89,11 @@ class PreGame : public QWidget {
 
  private:
   /**
-   * @brief Populates the user selection dropdown menus with available users
-   *        This is called when the window is shown to ensure the latest user
-   * list
+   * @brief Binds the user selection dropdown menus to the shared usernames
+   *        Called once; the model keeps every dropdown up to date
    *
    */
-  void populateUserDropdowns();
+  void bindUserDropdowns();
 
  private slots:
   /**
@@ -149,18 +148,11 @@ class PreGame : public QWidget {
 
  private:
   /**
-   * @brief Pointer to User objects containing player information
+   * @brief Pointer to the profile store containing player information
    *        Used to populate the dropdown menus
    *
    */
-  User* users;
-
-  /**
-   * @brief List of available usernames for player selection
-   *        Populated from the users database
-   *
-   */
-  QStringList usernames;
+  ProfileStore* users;
 
   /**
    * @brief Pointer to the account creation window
@@ -217,6 +209,12 @@ class PreGame : public QWidget {
    */
   QComboBox* blueTeamOperativeComboBox;
 
+  /**
+   * @brief Optional board code to deal a known board instead of a random one
+   *
+   */
+  QLineEdit* boardCodeEdit;
+
   /**
    * @brief Main vertical layout for the entire pregame screen
    *
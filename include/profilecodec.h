@@ -0,0 +1,173 @@
+/**
+ * @file profilecodec.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Reads and writes the profile in JSON or binary CBOR form
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PROFILECODEC_H
+#define PROFILECODEC_H
+
+#include <QByteArray>   // For encoded profiles
+#include <QHash>        // For the journal positions of a profile
+#include <QJsonObject>  // The profile document used by the rest of the app
+#include <QString>      // For file paths
+
+/**
+ * @brief Encoding of the profile file
+ *
+ * The profile was stored as indented JSON in profile.json. It is now written
+ * as CBOR to profile.cbor, a compact binary form of the same document that
+ * starts with the CBOR self-describe tag (0xD9D9F7). Reads detect the format
+ * from the content, so either file can be loaded. The first write after
+ * reading a JSON profile migrates it: profile.cbor is created and
+ * profile.json is renamed to profile.json.migrated. Once profile.cbor
+ * exists it is the only file read or written.
+ *
+ * After the tag the CBOR file holds an array: the generation, always as a
+ * full 8 byte integer, then the profile map, then the journal positions
+ * the profile contains (left out when there are none). Every write bumps
+ * the generation, and because it sits at a fixed offset (GenerationHeader
+ * bytes from the start) a reader can tell whether the file changed by
+ * reading that header alone. A JSON profile counts as generation 0.
+ *
+ * Every save also records the SHA-1 of the file in profile.checksum, so a
+ * profile changed or damaged outside the app is detected at startup.
+ */
+class ProfileCodec {
+ public:
+  /**
+   * @brief Encodings the codec understands
+   */
+  enum Format { Json, Cbor };
+
+  /**
+   * @brief Last stats journal record a profile contains, keyed by the
+   * journal's file name (see StatsJournal::name)
+   */
+  typedef QHash<QString, quint64> JournalPositions;
+
+  /// bytes of the tag, the array head and the generation
+  static const int GenerationHeader = 13;
+
+  /// milliseconds a writer waits for the profile lock
+  static const int LockTimeoutMs = 5000;
+
+  /**
+   * @brief Path of the CBOR profile stored next to a JSON profile
+   *
+   * @param jsonPath path of profile.json
+   * @return `QString` path of profile.cbor
+   */
+  static QString cborPath(const QString& jsonPath);
+
+  /**
+   * @brief Path of the lock file held by every profile writer
+   * Writers in any process take it with QLockFile around their
+   * read-modify-write of the profile; readers never take it.
+   *
+   * @param jsonPath path of profile.json
+   * @return `QString` path of profile.lock
+   */
+  static QString lockPath(const QString& jsonPath);
+
+  /**
+   * @brief Path of the checksum recorded by save()
+   *
+   * @param jsonPath path of profile.json
+   * @return `QString` path of profile.checksum
+   */
+  static QString checksumPath(const QString& jsonPath);
+
+  /**
+   * @brief Checksum of an encoded profile
+   *
+   * @param encoded the file contents
+   * @return `QByteArray` hex SHA-1 of the contents
+   */
+  static QByteArray checksum(const QByteArray& encoded);
+
+  /**
+   * @brief Record the checksum of the profile on disk
+   *
+   * @param jsonPath path of profile.json
+   * @param encoded the contents of the profile file
+   * @return `bool` true if the checksum was written
+   */
+  static bool recordChecksum(const QString& jsonPath,
+                             const QByteArray& encoded);
+
+  /**
+   * @brief Checksum recorded by the last save()
+   *
+   * @param jsonPath path of profile.json
+   * @return `QByteArray` the checksum, empty if none was recorded
+   */
+  static QByteArray storedChecksum(const QString& jsonPath);
+
+  /**
+   * @brief Path of the profile file to read
+   *
+   * @param jsonPath path of profile.json
+   * @return `QString` profile.cbor if it exists, otherwise jsonPath
+   */
+  static QString activePath(const QString& jsonPath);
+
+  /**
+   * @brief Detect the encoding of a profile from its content
+   *
+   * @param data the file contents
+   * @return `Format` Cbor if the self-describe tag is present, otherwise Json
+   */
+  static Format detect(const QByteArray& data);
+
+  /**
+   * @brief Decode a profile in either format
+   *
+   * @param data the file contents
+   * @param profile receives the profile document
+   * @param generation receives the generation of the file, may be null
+   * @param positions receives the journal positions of the file, may be null
+   * @return `bool` false if the data is not a profile object
+   */
+  static bool decode(const QByteArray& data, QJsonObject& profile,
+                     quint64* generation = nullptr,
+                     JournalPositions* positions = nullptr);
+
+  /**
+   * @brief Read the generation of a profile file from its header
+   * Reads GenerationHeader bytes, not the profile
+   *
+   * @param path path of the profile file
+   * @return `quint64` the generation, 0 if the file has none
+   */
+  static quint64 readGeneration(const QString& path);
+
+  /**
+   * @brief Encode a profile
+   *
+   * @param profile the profile document
+   * @param format the encoding to produce
+   * @param generation generation stored in the CBOR header
+   * @param positions journal positions the profile contains, CBOR only
+   * @return `QByteArray` the file contents
+   */
+  static QByteArray encode(const QJsonObject& profile, Format format = Cbor,
+                           quint64 generation = 0,
+                           const JournalPositions& positions = {});
+
+  /**
+   * @brief Atomically replace the CBOR profile, migrating a JSON one away
+   * Records the checksum of the new file afterwards
+   *
+   * @param jsonPath path of profile.json
+   * @param encoded CBOR contents produced by encode()
+   * @return `bool` true if the new profile is on disk
+   */
+  static bool save(const QString& jsonPath, const QByteArray& encoded);
+};
+
+#endif  // PROFILECODEC_H
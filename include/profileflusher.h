@@ -0,0 +1,291 @@
+/**
+ * @file profileflusher.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Write-behind queue that saves profile changes on a background thread
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PROFILEFLUSHER_H
+#define PROFILEFLUSHER_H
+
+#include <QDateTime>      // For file modification stamps
+#include <QElapsedTimer>  // For flush latency
+#include <QHash>          // For the coalescing queue
+#include <QJsonObject>    // For the profile document
+#include <QList>          // For the attached journals
+#include <QMutex>         // For sharing the queue with the GUI thread
+#include <QObject>        // Base class, lives in a worker QThread
+#include <QSet>           // For the cached shard index
+#include <QString>        // For file paths and usernames
+#include <QTimer>         // For the periodic flush
+
+#include "profilecodec.h"   // For the journal positions of a snapshot
+#include "profileshards.h"  // For the per-user layout
+#include "statsjournal.h"   // Compacted after every snapshot
+#include "userpatch.h"      // For the queued changes
+
+/**
+ * @brief Counters describing the state of the write-behind queue
+ */
+struct FlushCounters {
+  int queueDepth = 0;             ///< users waiting to be written
+  quint64 flushes = 0;            ///< completed flushes
+  quint64 failedFlushes = 0;      ///< flushes that could not write the file
+  quint64 queuedUpdates = 0;      ///< patches handed to the queue
+  quint64 coalescedUpdates = 0;   ///< patches merged into a queued user
+  qint64 lastFlushLatencyUs = 0;  ///< duration of the last flush
+  qint64 maxFlushLatencyUs = 0;   ///< longest flush so far
+};
+
+/**
+ * @brief Queue of pending profile changes drained by a background thread
+ * The GUI thread queues a UserPatch per changed user; several patches for
+ * the same user merge into one. The worker applies the queue to the
+ * profile and replaces profile.cbor every flush interval, or on request,
+ * migrating a JSON profile on the first write (see ProfileCodec). When the
+ * sharded layout is in use (see ProfileShards), only the files of the
+ * queued users and, if users were added, the index are written.
+ * Queued and in-flight patches can be read back so callers always see
+ * their own writes.
+ * Several app instances may share the profile, so each flush holds the
+ * profile lock (ProfileCodec::lockPath) from reading the file on disk to
+ * replacing it, and patches are applied to the entries read under it. The
+ * single file is only re-read when its generation is not the one this
+ * flusher wrote last, and each write bumps the generation.
+ * When stats journals are attached, each flush is their compaction: the
+ * written entries record the journal positions they contain and the
+ * records up to them are dropped from each journal.
+ */
+class ProfileFlusher : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief Construct a flusher for a profile file
+   * Move it to a QThread and start it from QThread::started
+   *
+   * @param filePath path of profile.json
+   * @param shardDirPath path of the per-user profiles directory
+   * @param journals stats journals to compact after each flush, not owned
+   * @param intervalMs milliseconds between flushes
+   */
+  explicit ProfileFlusher(const QString& filePath,
+                          const QString& shardDirPath,
+                          const QList<StatsJournal*>& journals = {},
+                          int intervalMs = 2000);
+
+  /**
+   * @brief Queue the changes to a user, merged into any queued for them
+   * Thread safe.
+   *
+   * @param username username of the user
+   * @param patch the changes
+   */
+  void enqueue(const QString& username, const UserPatch& patch);
+
+  /**
+   * @brief Queue changes to several users so they land in the same flush
+   * Thread safe.
+   *
+   * @param patches the changes keyed by username
+   */
+  void enqueue(const QHash<QString, UserPatch>& patches);
+
+  /**
+   * @brief Patches that are queued or being written
+   * Apply these to a freshly parsed profile to read your own writes.
+   * Thread safe.
+   *
+   * @return `QHash<QString, UserPatch>` patches keyed by username
+   */
+  QHash<QString, UserPatch> pendingPatches() const;
+
+  /**
+   * @brief Whether the file on disk is the one this flusher last wrote
+   * Thread safe.
+   *
+   * @param size current size of the file
+   * @param modified current modification time of the file
+   * @return `bool` true if the stamp matches our last write
+   */
+  bool isOwnWrite(qint64 size, const QDateTime& modified) const;
+
+  /**
+   * @brief Whether a profile generation holds only changes from this process
+   * Thread safe.
+   *
+   * @param generation the generation in the header of profile.cbor
+   * @return `bool` true if we wrote it onto a file we had written before
+   */
+  bool isOwnGeneration(quint64 generation) const;
+
+  /**
+   * @brief Snapshot of the queue counters
+   * Thread safe.
+   *
+   * @return `FlushCounters` the current counters
+   */
+  FlushCounters counters() const;
+
+ public slots:
+  /**
+   * @brief Create the flush timer, run in the worker thread
+   */
+  void start();
+
+  /**
+   * @brief Write every queued entry to disk now
+   */
+  void flush();
+
+  /**
+   * @brief Change the time between flushes
+   *
+   * @param intervalMs milliseconds between flushes
+   */
+  void setFlushInterval(int intervalMs);
+
+ signals:
+  /**
+   * @brief Emitted when queued entries could not be written
+   * The entries stay queued and are retried on the next flush.
+   *
+   * @param message description of the failure
+   */
+  void flushFailed(const QString& message);
+
+ private:
+  /**
+   * @brief Load the profile into baseDocument unless we wrote it last
+   * Call with the profile lock held
+   *
+   * @param foreign set to true if the file was written by someone else
+   * @return `bool` false if the file is missing or not a profile object
+   */
+  bool refreshBaseDocument(bool& foreign);
+
+  /**
+   * @brief Apply a batch to the single profile file and replace it
+   *
+   * @param batch patches to write
+   * @return `bool` true if the profile was written
+   */
+  bool writeSnapshot(const QHash<QString, UserPatch>& batch);
+
+  /**
+   * @brief Load the shard index into baseIndex
+   * Call with the profile lock held
+   *
+   * @return `bool` false if the index could not be read
+   */
+  bool refreshBaseIndex();
+
+  /**
+   * @brief Apply a batch to the per-user files and update the index
+   *
+   * @param batch patches to write
+   * @return `bool` true if every file was written
+   */
+  bool writeShards(const QHash<QString, UserPatch>& batch);
+
+  /**
+   * @brief path of profile.json
+   */
+  QString filePath;
+
+  /**
+   * @brief per-user profile files, used when their index exists
+   */
+  ProfileShards shards;
+
+  /**
+   * @brief stats journals folded into each snapshot, not owned
+   */
+  QList<StatsJournal*> journals;
+
+  /**
+   * @brief milliseconds between flushes
+   */
+  int intervalMs;
+
+  /**
+   * @brief periodic flush timer, owned by the worker thread
+   */
+  QTimer* timer = nullptr;
+
+  /**
+   * @brief profile document as of our last write, worker thread only
+   */
+  QJsonObject baseDocument;
+
+  /**
+   * @brief journal positions baseDocument contains
+   */
+  ProfileCodec::JournalPositions basePositions;
+
+  /**
+   * @brief whether baseDocument has been loaded
+   */
+  bool baseValid = false;
+
+  /**
+   * @brief generation of the file baseDocument was read from or written to
+   */
+  quint64 baseGeneration = 0;
+
+  /**
+   * @brief shard index as of our last write, worker thread only
+   */
+  QStringList baseIndex;
+
+  /**
+   * @brief the usernames of baseIndex, for lookups
+   */
+  QSet<QString> baseIndexSet;
+
+  /**
+   * @brief guards every member below
+   */
+  mutable QMutex mutex;
+
+  /**
+   * @brief patches waiting for the next flush
+   */
+  QHash<QString, UserPatch> pending;
+
+  /**
+   * @brief patches taken by the flush currently writing
+   */
+  QHash<QString, UserPatch> inFlight;
+
+  /**
+   * @brief modification time of profile.cbor (or the index) after our last
+   * write
+   */
+  QDateTime lastWriteTime;
+
+  /**
+   * @brief size of profile.cbor (or the index) after our last write
+   */
+  qint64 lastWriteSize = -1;
+
+  /**
+   * @brief generation of profile.cbor after our last write
+   */
+  quint64 lastWriteGeneration = 0;
+
+  /**
+   * @brief whether our last write merged changes made by someone else
+   */
+  bool lastWriteForeign = false;
+
+  /**
+   * @brief queue counters
+   */
+  FlushCounters stats;
+};
+
+#endif  // PROFILEFLUSHER_H
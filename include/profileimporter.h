@@ -0,0 +1,208 @@
+/**
+ * @file profileimporter.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Streams the users of a profile dump in fixed-size batches
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PROFILEIMPORTER_H
+#define PROFILEIMPORTER_H
+
+#include <QByteArray>   // For the read buffer and raw values
+#include <QFile>        // For the dump being read
+#include <QHash>        // For a batch of counters
+#include <QJsonObject>  // For one decoded user
+#include <QString>      // For usernames and paths
+#include <functional>   // For the batch callback
+
+#include "statscounters.h"  // For the four counters
+
+/**
+ * @brief Reads a profile dump without loading it whole
+ *
+ * The dump is a profile file from another machine, in either format
+ * ProfileCodec writes, and only the user being parsed is held in memory. A
+ * JSON dump is read in ReadChunk byte pieces and split into top-level
+ * members by a small scanner that tracks strings and nesting, then each
+ * member is decoded on its own; a CBOR dump is walked with
+ * QCborStreamReader one map entry at a time. The statistics of every user
+ * are collected into a batch of at most batchSize users, which is handed to
+ * the callback and cleared, so peak memory is bounded by the batch size and
+ * the largest single user, not by the size of the dump.
+ *
+ * A user that appears twice in the same batch has its counters summed.
+ * Users without a statistics object are skipped.
+ */
+class ProfileImporter {
+ public:
+  /// bytes read from the dump at a time
+  static const int ReadChunk = 64 * 1024;
+
+  /// largest encoded user accepted, larger ones fail the import
+  static const int MaxUserBytes = 1024 * 1024;
+
+  /**
+   * @brief Called with each full batch, return false to stop the import
+   */
+  using BatchHandler =
+      std::function<bool(const QHash<QString, StatsCounters>& batch)>;
+
+  /**
+   * @brief Construct an importer for a dump file
+   *
+   * @param dumpPath path of the profile dump
+   * @param batchSize users handed to the callback at a time
+   */
+  explicit ProfileImporter(const QString& dumpPath, int batchSize = 4096);
+
+  /**
+   * @brief Read the whole dump, handing its users over batch by batch
+   *
+   * @param handler receives each batch
+   * @return `bool` false if the dump is unreadable or malformed, or the
+   * handler stopped the import; batches handed over before stay applied
+   */
+  bool run(const BatchHandler& handler);
+
+  /**
+   * @brief Users read from the dump so far
+   *
+   * @return `quint64` users with statistics
+   */
+  quint64 usersRead() const;
+
+  /**
+   * @brief Users skipped because they had no statistics
+   *
+   * @return `quint64` users without statistics
+   */
+  quint64 usersSkipped() const;
+
+  /**
+   * @brief Why the last run failed
+   *
+   * @return `QString` empty after a successful run
+   */
+  QString errorString() const;
+
+ private:
+  /**
+   * @brief Stream a JSON dump
+   *
+   * @return `bool` true if every member was read
+   */
+  bool runJson();
+
+  /**
+   * @brief Stream a CBOR dump
+   *
+   * @return `bool` true if every entry was read
+   */
+  bool runCbor();
+
+  /**
+   * @brief Next byte of the dump, refilling the buffer as needed
+   *
+   * @return `int` the byte, -1 at the end of the dump
+   */
+  int nextByte();
+
+  /**
+   * @brief Next byte that is not JSON whitespace
+   *
+   * @return `int` the byte, -1 at the end of the dump
+   */
+  int nextToken();
+
+  /**
+   * @brief Copy a JSON string, the opening quote already read
+   *
+   * @param raw receives the string with its quotes and escapes
+   * @return `bool` false if the dump ends first or the string is too long
+   */
+  bool readJsonString(QByteArray& raw);
+
+  /**
+   * @brief Copy a JSON value up to the ',' or '}' that ends it
+   *
+   * @param raw receives the value, without the terminator
+   * @param terminator receives the ',' or '}'
+   * @return `bool` false if the dump ends first or the value is too long
+   */
+  bool readJsonValue(QByteArray& raw, int& terminator);
+
+  /**
+   * @brief Add the statistics of one user to the batch
+   * Hands the batch over when it is full
+   *
+   * @param username the user
+   * @param user the user's object from the dump
+   * @return `bool` false if the handler stopped the import
+   */
+  bool addUser(const QString& username, const QJsonObject& user);
+
+  /**
+   * @brief Hand the batch over and clear it
+   *
+   * @return `bool` false if the handler stopped the import
+   */
+  bool flushBatch();
+
+  /**
+   * @brief Record why the import failed
+   *
+   * @param message the reason
+   * @return `bool` always false
+   */
+  bool fail(const QString& message);
+
+  /**
+   * @brief the dump being read
+   */
+  QFile file;
+
+  /**
+   * @brief users per batch
+   */
+  int batchSize;
+
+  /**
+   * @brief the current batch handler
+   */
+  BatchHandler handler;
+
+  /**
+   * @brief users read but not yet handed over
+   */
+  QHash<QString, StatsCounters> batch;
+
+  /**
+   * @brief the last chunk read from the dump
+   */
+  QByteArray buffer;
+
+  /**
+   * @brief next unread byte of the buffer
+   */
+  int bufferPos = 0;
+
+  /**
+   * @brief users read from the dump
+   */
+  quint64 readCount = 0;
+
+  /**
+   * @brief users skipped for lack of statistics
+   */
+  quint64 skippedCount = 0;
+
+  /**
+   * @brief why the last run failed
+   */
+  QString error;
+};
+
+#endif  // PROFILEIMPORTER_H
@@ -0,0 +1,98 @@
+/**
+ * @file profilescanner.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Checks, repairs and compacts the profile in the background
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PROFILESCANNER_H
+#define PROFILESCANNER_H
+
+#include <QJsonObject>  // For the profile document
+#include <QString>      // For paths and messages
+#include <QStringList>  // For the repaired users
+
+/**
+ * @brief Integrity scan of the single-file profile
+ *
+ * Meant to run once at startup on a worker thread. When the file still has
+ * the checksum recorded by its last save nothing else happens. Otherwise,
+ * holding the profile lock, every user entry is checked:
+ * - an entry that is not an object, or has an empty username, is moved to
+ *   profile.quarantine.json and removed from the profile;
+ * - missing statistics, counters that are not non-negative integers, wins
+ *   above games played or hits above guesses, and a user_name that differs
+ *   from the key are repaired in place.
+ * The profile is then written back as compact CBOR, which also migrates an
+ * indented JSON profile, with the journal positions it held, and its new
+ * checksum is recorded. A profile that
+ * does not decode at all is copied aside, to profile.cbor.corrupt-<ms>, and
+ * left as it is.
+ */
+class ProfileScanner {
+ public:
+  /**
+   * @brief What a scan found and did
+   */
+  struct Report {
+    bool skipped = false;    ///< the checksum matched, nothing was read
+    bool rewritten = false;  ///< the profile was written back
+    int users = 0;           ///< entries checked
+    int quarantined = 0;     ///< entries moved to the quarantine
+    QStringList repaired;    ///< users whose entry was repaired
+    QString error;           ///< why the scan failed, empty on success
+  };
+
+  /**
+   * @brief Construct a scanner for a profile
+   *
+   * @param jsonPath path of profile.json
+   */
+  explicit ProfileScanner(const QString& jsonPath);
+
+  /**
+   * @brief Scan, repair and compact the profile
+   * Blocks on file I/O, call it off the GUI thread
+   *
+   * @return `Report` the outcome
+   */
+  Report run();
+
+  /**
+   * @brief Path of the quarantine next to a profile
+   *
+   * @param jsonPath path of profile.json
+   * @return `QString` path of profile.quarantine.json
+   */
+  static QString quarantinePath(const QString& jsonPath);
+
+ private:
+  /**
+   * @brief Check one user entry, repairing it if it can be repaired
+   *
+   * @param username the key of the entry
+   * @param entry the entry, repaired in place
+   * @param repaired set to true if the entry was changed
+   * @return `bool` false if the entry must be quarantined
+   */
+  static bool checkEntry(const QString& username, QJsonObject& entry,
+                         bool& repaired);
+
+  /**
+   * @brief Add entries to the quarantine file
+   *
+   * @param entries the entries, keyed by username
+   * @return `bool` true if the quarantine was written
+   */
+  bool quarantine(const QJsonObject& entries);
+
+  /**
+   * @brief path of profile.json
+   */
+  QString jsonPath;
+};
+
+#endif  // PROFILESCANNER_H
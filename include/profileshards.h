@@ -0,0 +1,130 @@
+/**
+ * @file profileshards.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Optional profile layout with one small file per user
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PROFILESHARDS_H
+#define PROFILESHARDS_H
+
+#include <QJsonObject>  // For user entries
+#include <QString>      // For paths and usernames
+#include <QStringList>  // For the index
+
+#include "profilecodec.h"  // For the journal positions of a user file
+
+/**
+ * @brief Per-user profile files under resources/profiles/
+ *
+ * Each user entry is stored as CBOR in its own file named after the hex
+ * encoded UTF-8 username, so updating one player touches one small file.
+ * The directory also holds "index", a UTF-8 text file with one username
+ * per line, which is all that is read to list the accounts. The layout is
+ * in use whenever the index exists.
+ *
+ * Every user file records the last stats journal records it contains (see
+ * ProfileCodec::JournalPositions), so replay after a crash only applies
+ * newer records. Files written before that record a single "journal_seq",
+ * read as the position of profile.journal.
+ */
+class ProfileShards {
+ public:
+  /**
+   * @brief Construct for a profiles directory
+   *
+   * @param dirPath path of the profiles directory
+   */
+  explicit ProfileShards(const QString& dirPath);
+
+  /**
+   * @brief Whether the sharded layout is in use
+   *
+   * @return `bool` true if the index file exists
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief Path of the index file
+   *
+   * @return `QString` path of the index
+   */
+  QString indexPath() const;
+
+  /**
+   * @brief Path of a user's file
+   *
+   * @param username username of the user
+   * @return `QString` path of the user's file
+   */
+  QString userPath(const QString& username) const;
+
+  /**
+   * @brief Read the usernames listed in the index
+   *
+   * @param usernames receives the usernames, in file order
+   * @return `bool` false if the index could not be read
+   */
+  bool readIndex(QStringList& usernames) const;
+
+  /**
+   * @brief Atomically replace the index
+   *
+   * @param usernames every username of the profile
+   * @return `bool` true if the index was written
+   */
+  bool writeIndex(const QStringList& usernames) const;
+
+  /**
+   * @brief Read one user's entry
+   *
+   * @param username username of the user
+   * @param userObject receives the user entry
+   * @param positions receives the journal positions of the entry
+   * @return `bool` false if the file is missing or invalid
+   */
+  bool readUser(const QString& username, QJsonObject& userObject,
+                ProfileCodec::JournalPositions* positions = nullptr) const;
+
+  /**
+   * @brief Atomically replace one user's entry
+   *
+   * @param username username of the user
+   * @param userObject the user entry
+   * @param positions journal positions the entry contains
+   * @return `bool` true if the file was written
+   */
+  bool writeUser(const QString& username, const QJsonObject& userObject,
+                 const ProfileCodec::JournalPositions& positions = {}) const;
+
+  /**
+   * @brief Delete one user's file
+   *
+   * @param username username of the user
+   * @return `bool` true if the file no longer exists
+   */
+  bool removeUser(const QString& username) const;
+
+  /**
+   * @brief Split a whole profile into user files and an index
+   * The index is written last, so the layout only switches on once every
+   * user file is in place.
+   *
+   * @param profile the whole profile document
+   * @param positions journal positions the profile contains
+   * @return `bool` true if the layout was created
+   */
+  bool create(const QJsonObject& profile,
+              const ProfileCodec::JournalPositions& positions) const;
+
+ private:
+  /**
+   * @brief path of the profiles directory
+   */
+  QString dirPath;
+};
+
+#endif  // PROFILESHARDS_H
@@ -0,0 +1,1023 @@
+/**
+ * @file profilestore.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Headless store of user profiles, statistics and game records
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef PROFILESTORE_H
+#define PROFILESTORE_H
+
+#include <QCoreApplication>    // For flushing profile writes on shutdown
+#include <QDateTime>           // For profile modification stamps
+#include <QDebug>              // For debug output to console
+#include <QDir>                // For directory manipulation
+#include <QFile>               // For file I/O operations
+#include <QFileInfo>           // For profile file metadata
+#include <QFileSystemWatcher>  // For invalidating the profile cache
+#include <QFutureWatcher>      // For the startup integrity scan
+#include <QHash>               // For per-user positions and patches
+#include <QJsonDocument>       // For JSON document parsing
+#include <QJsonObject>         // For JSON object manipulation
+#include <QLockFile>           // For profile rewrites under the lock
+#include <QObject>             // Base class, for signals and timers
+#include <QSet>                // For the sharded profile index
+#include <QThread>             // For the background profile writer
+#include <functional>          // For profile rewrites
+
+#include "leaderboard.h"      // For ranking users by their statistics
+#include "matchhistory.h"     // For the record of finished games
+#include "pairstats.h"        // For teammate and opponent records
+#include "profilecodec.h"     // For JSON and CBOR profile files
+#include "profileflusher.h"   // For write-behind profile saving
+#include "profileimporter.h"  // For merging profile dumps
+#include "profilescanner.h"   // For checking the profile at startup
+#include "profileshards.h"    // For the per-user profile layout
+#include "ratingengine.h"     // For per-role skill ratings
+#include "statsbuckets.h"     // For the last days of statistics
+#include "statsjournal.h"     // For crash-safe statistics updates
+#include "statstable.h"       // For the mapped counters of every user
+#include "usernamemodel.h"    // For the shared username list
+#include "userpatch.h"        // For the changes queued per user
+
+/**
+ * @brief Typed copy of the "statistics" object of a user in profile.json
+ * Kept in the mapped statistics table so getters never touch the profile,
+ * and won, lost, hit and miss add to it in place
+ */
+using UserStats = StatsCounters;
+
+/**
+ * @brief Per-role counters, the "role_statistics" object of a user
+ * Updated by one addition per clue and per reveal, never rebuilt from the
+ * match history
+ */
+struct RoleStats {
+  // As spymaster
+  unsigned int cluesGiven = 0;       ///< clues_given
+  unsigned int numberedClues = 0;    ///< numbered_clues, clues that are not ∞
+  unsigned int clueWords = 0;        ///< clue_words, sum of their numbers
+  unsigned int cluesSolved = 0;      ///< clues_solved, every word found
+  unsigned int assassinsCaused = 0;  ///< assassins_caused, on their clues
+
+  // As operative
+  unsigned int cluesReceived = 0;    ///< clues_received
+  unsigned int correctGuesses = 0;   ///< correct_guesses, own agents
+  unsigned int bonusGuesses = 0;     ///< bonus_guesses, beyond the number
+  unsigned int neutralGuesses = 0;   ///< neutral_guesses, bystanders
+  unsigned int opponentGuesses = 0;  ///< opponent_guesses, other team
+  unsigned int assassinGuesses = 0;  ///< assassin_guesses
+};
+
+/**
+ * @brief Every statistic of a user, with the derived rates
+ * Filled from a single profile lookup by ProfileStore::statsSnapshot
+ */
+struct StatsSnapshot {
+  QString username;    ///< the user the statistics belong to
+  bool found = false;  ///< false if the user could not be read
+  UserStats counters;  ///< the raw counters
+  float winRate = 0;   ///< games_win / games_played, 0 without games
+  float hitRate = 0;   ///< guess_hit / guess_total, 0 without guesses
+};
+
+/**
+ * @brief Profiles, statistics, ratings and game records of every user
+ *
+ * Owns the profile cache, the journal, the mapped files, the background
+ * writer and the startup scan. It only needs QtCore, so the game, a
+ * dedicated server, the benchmarks and the tools all link the same store.
+ * Nothing here touches a widget: getters report problems through
+ * lastError(), and mutators also emit statusMessage for a UI to show.
+ *
+ * Every file lives under one directory, resources/ for the game, and
+ * several instances may share it: the profile is written under its lock
+ * (see ProfileFlusher), each instance appends to a statistics journal of
+ * its own, and the mapped files and the match history are locked and
+ * brought up to date around every access. Within a process, a store is not
+ * thread safe and belongs to the thread that created it.
+ */
+class ProfileStore : public QObject {
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief Result of the last attempt to parse profile.json
+   */
+  enum ProfileStatus {
+    ProfileOk,
+    ProfileMissing,
+    ProfileUnreadable,
+    ProfileInvalid
+  };
+
+  /**
+   * @brief Outcome of createAccount
+   */
+  enum AccountResult { AccountCreated, AccountExists, AccountFailed };
+
+  /**
+   * @brief Open every file of a store, creating the missing ones
+   * Starts the background writer, and the integrity scan of a single-file
+   * profile. Honours --sharded-profiles and --recompute-ratings.
+   *
+   * @param dirPath directory holding profile.json and the statistics files
+   * @param parent the parent QObject for memory management
+   */
+  explicit ProfileStore(const QString& dirPath = "resources",
+                        QObject* parent = nullptr);
+
+  /**
+   * @brief Write every queued change and close the files
+   */
+  ~ProfileStore();
+
+  /**
+   * @brief Update the number of games played by a user
+   * Modifies user statistics and saves to profile
+   *
+   * @param username username of the user to update
+   * @param newGamesPlayed the new number of games played by a user
+   */
+  void updateGamesPlayed(const QString& username,
+                         const unsigned int& newGamesPlayed);
+
+  /**
+   * @brief Get the number of games played by a user
+   * Retrieves game count from user profile
+   *
+   * @param username username of the user
+   * @return `unsigned int` the number of games played
+   */
+  unsigned int getGamesPlayed(const QString& username) const;
+
+  /**
+   * @brief Update the number of wins a user has
+   * Modifies win statistics and saves to profile
+   *
+   * @param username username of the user
+   * @param newWins the new number of wins the user has
+   */
+  void updateWins(const QString& username, const unsigned int& newWins);
+
+  /**
+   * @brief Get the number of wins the user has
+   * Retrieves win count from user profile
+   *
+   * @param username username of the user
+   * @return `unsigned int` the number of wins the user has
+   */
+  unsigned int getWins(const QString& username) const;
+
+  /**
+   * @brief Get the win rate of the user (games_win/games_played)
+   * Calculates win percentage based on games played and won
+   *
+   * @param username the username of a user
+   * @return `float` win rate of the user (games_win/games_played)
+   */
+  float getWinRate(const QString& username) const;
+
+  /**
+   * @brief Update the total of guesses the user has
+   * Modifies guess statistics and saves to profile
+   *
+   * @param username username of the user
+   * @param newGuessTotal the new total number of guesses the user has
+   */
+  void updateGuessTotal(const QString& username,
+                        const unsigned int& newGuessTotal);
+
+  /**
+   * @brief Get the total number of guesses the user has
+   * Retrieves guess count from user profile
+   *
+   * @param username username of the user
+   * @return `unsigned int` the total number of guesses the user has
+   */
+  unsigned int getGuessTotal(const QString& username) const;
+
+  /**
+   * @brief Update the number times the user guess correctly
+   * Modifies correct guess statistics and saves to profile
+   *
+   * @param username username of the user
+   * @param newGuessHit the number of times the user guess correctly
+   */
+  void updateGuessHit(const QString& username, const unsigned int& newGuessHit);
+
+  /**
+   * @brief Get the number of times the user guess correctly
+   * Retrieves correct guess count from user profile
+   *
+   * @param username username of the user
+   * @return `unsigned int` the number of times the user guess correctly
+   */
+  unsigned int getGuessHit(const QString& username) const;
+
+  /**
+   * @brief Get the rate the user guess correctly (guess_hit/guess_total)
+   * Calculates accuracy percentage based on total guesses and correct guesses
+   *
+   * @param username username of the user
+   * @return `float` the rate the user guess correctly (guess_hit/guess_total)
+   */
+  float getHitRate(const QString& username);
+
+  /**
+   * @brief Get every statistic and rate of the user at once
+   * One profile lookup instead of one per getter
+   *
+   * @param username username of the user
+   * @return `StatsSnapshot` the statistics, `found` is false on error
+   */
+  StatsSnapshot statsSnapshot(const QString& username) const;
+
+  /**
+   * @brief Get the statistics of several users in one pass
+   * The profile is checked once; unknown users are returned with `found`
+   * false instead of being reported
+   *
+   * @param usernames the users to read, in the order to return them
+   * @return `QList<StatsSnapshot>` one snapshot per username
+   */
+  QList<StatsSnapshot> statsSnapshots(const QStringList& usernames) const;
+
+  /**
+   * @brief Get the statistics of a user over the last days
+   * Summed from daily buckets, so the cost does not grow with history
+   *
+   * @param username username of the user
+   * @param days length of the window, at most StatsBuckets::Days
+   * @return `StatsSnapshot` the counters and rates of the window
+   */
+  StatsSnapshot recentStats(const QString& username, int days) const;
+
+  /**
+   * @brief Get the leaderboards of every user
+   * Built from the profile on first use, then updated in place by every
+   * statistics change, so opening a leaderboard never sorts all users
+   *
+   * @return `const Leaderboard*` the rankings, owned by the store
+   */
+  const Leaderboard* leaderboard();
+
+  /**
+   * @brief Get the skill ratings of the user in both roles
+   * Users who have not played a rated game get the initial rating
+   *
+   * @param username username of the user
+   * @return `PlayerRatings` the spymaster and operative ratings
+   */
+  PlayerRatings getRatings(const QString& username) const;
+
+  /**
+   * @brief Update the ratings of the four players of a finished game
+   * Players missing from the profile are rated at the initial rating and
+   * not stored, so a local profile only keeps its own users.
+   *
+   * @param match the players of each seat and the winning team
+   */
+  void rateMatch(const MatchResult& match);
+
+  /**
+   * @brief Replace every rating with one recomputed from a match history
+   * Uses every core; meant for after the rating constants change
+   *
+   * @param matches every game to rate, in any order
+   * @return `bool` true if the ratings were written
+   */
+  bool recomputeRatings(const QVector<MatchResult>& matches);
+
+  /**
+   * @brief Replace every rating with one recomputed from the match history
+   * Also done at startup when the app is run with --recompute-ratings.
+   *
+   * @return `bool` true if the ratings were written
+   */
+  bool recomputeRatings();
+
+  /**
+   * @brief Record a finished game in the match history
+   * One append to the history log, plus the pair records of its players
+   *
+   * @param record the game
+   * @return `bool` true if the game was written
+   */
+  bool recordMatch(const MatchRecord& record);
+
+  /**
+   * @brief The history of finished games, for analytics scans
+   *
+   * @return `const MatchHistory*` the match history
+   */
+  const MatchHistory* matchHistory() const;
+
+  /**
+   * @brief The teammates a user wins most with
+   * Reads only that user's pairs
+   *
+   * @param username username of the user
+   * @param count number of partners to return at most
+   * @param minGames partners with fewer games together are left out
+   * @return `QVector<PairRecord>` best win rate first
+   */
+  QVector<PairRecord> bestPartners(const QString& username, int count,
+                                   quint32 minGames = 1) const;
+
+  /**
+   * @brief The record of a user against another
+   *
+   * @param username username of the user
+   * @param opponent username of the opponent
+   * @return `PairRecord` wins are the user's, no games if they never met
+   */
+  PairRecord headToHead(const QString& username,
+                        const QString& opponent) const;
+
+  /**
+   * @brief Change the constants used to rate games
+   * Call recomputeRatings afterwards to apply them to past games
+   *
+   * @param params the new constants
+   */
+  void setRatingParams(const RatingEngine::Params& params);
+
+  /**
+   * @brief Rename the user
+   * Changes username in profile while preserving statistics. Written straight
+   * to disk under the profile lock.
+   *
+   * @param oldUsername old username of the user
+   * @param newUsername new username of the user
+   */
+  void renameUser(const QString& oldUsername, const QString& newUsername);
+
+  /**
+   * @brief Change the games played total and games played win of the user when
+   * they won
+   * Convenience method to update multiple statistics after a win. Like hit,
+   * miss and lost, this is one journal append and an update of the cached
+   * profile; the profile file is rewritten later by the background writer.
+   *
+   * @param username username of the user
+   */
+  void won(const QString& username);
+
+  /**
+   * @brief Change the games played total of the user when they lost
+   * Convenience method to update statistics after a loss
+   *
+   * @param username username of the user
+   */
+  void lost(const QString& username);
+
+  /**
+   * @brief Change the guess total and guess hit of the user when they guess
+   * correctly
+   * Convenience method to update multiple statistics after a correct guess
+   *
+   * @param username username of the user
+   */
+  void hit(const QString& username);
+
+  /**
+   * @brief Change the guess total of the user when they guess incorrectly
+   * Convenience method to update statistics after an incorrect guess
+   *
+   * @param username username of the user
+   */
+  void miss(const QString& username);
+
+  /**
+   * @brief Add the statistics and role statistics changes of a game at once
+   * Every change is journaled, then applied in memory and queued as one
+   * batch, so the whole game lands in the same atomic profile write. Users
+   * missing from the profile are skipped.
+   *
+   * @param deltas the amount to add to each counter, keyed by username
+   * @param roleDeltas the amount to add to each role counter, keyed by
+   * username
+   * @return `bool` true if the changes were queued
+   */
+  bool applyGameDeltas(const QHash<QString, UserStats>& deltas,
+                       const QHash<QString, RoleStats>& roleDeltas);
+
+  /**
+   * @brief Add a batch of counters merged from another profile
+   * Counters are added to existing users and users missing from the
+   * profile are created with them. Unlike applyGameDeltas the recent
+   * statistics are left alone, the games were not played today.
+   *
+   * @param counters the counters to add, keyed by username
+   * @return `bool` true if the batch was queued
+   */
+  bool mergeStats(const QHash<QString, StatsCounters>& counters);
+
+  /**
+   * @brief Merge the counters of a profile dump into this profile
+   * The dump is streamed in batches, see ProfileImporter, so memory does
+   * not grow with its size.
+   *
+   * @param dumpPath path of a profile.json or profile.cbor from elsewhere
+   * @return `bool` true if the whole dump was merged
+   */
+  bool importProfile(const QString& dumpPath);
+
+  /**
+   * @brief Get the spymaster and operative statistics of a user
+   *
+   * @param username username of the user
+   * @return `RoleStats` the counters, all zero for a user without any
+   */
+  RoleStats getRoleStats(const QString& username) const;
+
+  /**
+   * @brief loading the info of the users
+   * Reads user profiles from JSON storage
+   *
+   * @return `QJsonObject` the info of the user in json format
+   */
+  QJsonObject loadJsonFile();  // Function to load JSON data
+
+  /**
+   * @brief Get the usernames of every user, sorted
+   * Reads only the index when the profile is sharded
+   *
+   * @return `QStringList` the usernames, empty on error
+   */
+  QStringList loadUsernames();
+
+  /**
+   * @brief Get the shared, sorted list of usernames
+   * Every account dropdown binds to this model; it is kept up to date as
+   * accounts are created and renamed, so showing a screen reads no file.
+   *
+   * @return `UsernameModel*` the model, owned by the store
+   */
+  UsernameModel* usernameModel() const;
+
+  /**
+   * @brief Switch to one file per user under resources/profiles/
+   * Splits the current profile and keeps the single file as a backup.
+   * Also done at startup when the app is run with --sharded-profiles.
+   *
+   * @return `bool` true if the sharded layout is in use
+   */
+  bool enableShardedProfiles();
+
+  /**
+   * @brief Drop the in-memory profile table
+   * The next access re-parses profile.json. Called automatically when the
+   * file changes on disk, and by writers that must be visible immediately.
+   */
+  void invalidateProfileCache();
+
+  /**
+   * @brief Change how often queued profile changes are written to disk
+   *
+   * @param intervalMs milliseconds between background flushes
+   */
+  void setProfileFlushInterval(int intervalMs);
+
+  /**
+   * @brief Counters of the background profile writer
+   * Queue depth, flush count and flush latency
+   *
+   * @return `FlushCounters` snapshot of the counters
+   */
+  FlushCounters profileFlushCounters() const;
+
+  /**
+   * @brief Add an account to the profile
+   * Written straight to disk under the profile lock. An existing account
+   * keeps its statistics and is reported as AccountExists.
+   *
+   * @param username username of the new account
+   * @return `AccountResult` the outcome, lastError says why it failed
+   */
+  AccountResult createAccount(const QString& username);
+
+  /**
+   * @brief Load the profile if needed and report whether it is usable
+   *
+   * @return `ProfileStatus` the outcome of the last parse
+   */
+  ProfileStatus status() const;
+
+  /**
+   * @brief Number of users in the profile
+   *
+   * @return `int` the users, 0 if the profile is not loaded
+   */
+  int userCount() const;
+
+  /**
+   * @brief The profile entry of one user
+   * Reads only that user's file when the profile is sharded
+   *
+   * @param username username of the user
+   * @return `QJsonObject` the entry, empty if the user does not exist
+   */
+  QJsonObject userEntry(const QString& username) const;
+
+  /**
+   * @brief Path of the profile file currently in use
+   * profile.cbor once the profile has been migrated, profile.json before
+   *
+   * @return `QString` the path to read
+   */
+  QString profileFilePath() const;
+
+  /**
+   * @brief Why the last operation failed
+   * Set by every lookup and mutator that fails, never cleared
+   *
+   * @return `QString` a message fit to show to the user
+   */
+  QString lastError() const;
+
+ signals:
+  /**
+   * @brief A mutator finished or failed
+   * Carries the message the login screen shows; getters never emit it
+   *
+   * @param message the message
+   */
+  void statusMessage(const QString& message);
+
+ private slots:
+  /**
+   * @brief react to profile.json (or its directory) changing on disk
+   * Invalidates the profile table unless the change is our own write
+   *
+   * @param path the path reported by the file system watcher
+   */
+  void onProfileFileChanged(const QString& path);
+
+  /**
+   * @brief write every queued profile change and stop the writer thread
+   * Runs on application shutdown
+   */
+  void shutdownProfileFlusher();
+
+  /**
+   * @brief pick up the result of the startup integrity scan
+   * Reloads the profile if the scan rewrote it
+   */
+  void onProfileScanned();
+
+ private:
+  /**
+   * @brief the path of the users info
+   * Location of JSON profile storage
+   */
+  QString jsonFilePath;
+
+  /**
+   * @brief the path of the daily statistics buckets
+   * The last StatsBuckets::Days days of counters of every user
+   */
+  QString statsBucketsFilePath;
+
+  /**
+   * @brief the path of the first statistics table
+   * The counters of every loaded user, other instances use the numbered
+   * tables next to it
+   */
+  QString statsTableFilePath;
+
+  /**
+   * @brief the path of the pair statistics
+   * Teammate and opponent records, with the user ids in a .names file
+   */
+  QString pairStatsFilePath;
+
+  /**
+   * @brief the directory of the sharded profile layout
+   * One file per user plus an index, used when the index exists
+   */
+  QString shardDirPath;
+
+  /**
+   * @brief the path of the first statistics journal
+   * Stat changes not yet folded into the profile, other instances use the
+   * numbered journals next to it
+   */
+  QString journalFilePath;
+
+  /**
+   * @brief the directory of the match history
+   * The active log of recent games plus sealed, columnar segments
+   */
+  QString historyDirPath;
+
+  /**
+   * @brief the sorted usernames shown by every account dropdown
+   * Filled once at startup and updated incrementally afterwards
+   */
+  UsernameModel* usernameListModel;
+
+  /**
+   * @brief the leaderboards, kept in step with every statistics change
+   */
+  Leaderboard* rankings;
+
+  /**
+   * @brief false until the leaderboards are built, and after a reload of
+   * the profile failed
+   */
+  bool rankingsValid = false;
+
+  /**
+   * @brief the rating system used for every game
+   */
+  RatingEngine ratingEngine;
+
+  /**
+   * @brief Record why an operation failed
+   * Const, so lookups can fail without emitting anything
+   *
+   * @param message the message returned by lastError
+   */
+  void setError(const QString& message) const;
+
+  /**
+   * @brief Record why a mutator failed and emit it as a status message
+   *
+   * @param message the message
+   */
+  void reportError(const QString& message);
+
+  /**
+   * @brief Change users on disk under the profile lock, past the queue
+   * For changes a patch cannot express: new accounts, renames and absolute
+   * ratings. The queue is flushed first and the cache is reloaded after.
+   *
+   * @param usernames every user the change reads or writes
+   * @param change edits the users read from disk, returns false to abort
+   * after setting the error
+   * @return `bool` true if the change was written, lastError says why not
+   */
+  bool rewriteProfile(const QStringList& usernames,
+                      const std::function<bool(QJsonObject& users)>& change);
+
+  /**
+   * @brief rewriteProfile for the single file, the change sees every user
+   * Call with the profile lock held
+   *
+   * @param change edits the profile, returns false to abort
+   * @return `bool` true if the profile was written
+   */
+  bool rewriteProfileFile(
+      const std::function<bool(QJsonObject& users)>& change);
+
+  /**
+   * @brief rewriteProfile for the per-user layout
+   * Call with the profile lock held
+   *
+   * @param usernames the users read and written
+   * @param change edits the users that exist, returns false to abort
+   * @return `bool` true if every file was written
+   */
+  bool rewriteUserFiles(
+      const QStringList& usernames,
+      const std::function<bool(QJsonObject& users)>& change);
+
+  /**
+   * @brief Parse profile.json into the profile table if it is not loaded
+   * Costs one read and one parse per change of the file on disk
+   */
+  void ensureProfileCache() const;
+
+  /**
+   * @brief Apply the background writer's queue on top of the loaded profile
+   *
+   * @param pending the queued patches, taken before the profile was read
+   */
+  void overlayPendingPatches(const QHash<QString, UserPatch>& pending) const;
+
+  /**
+   * @brief Journal positions of a user's cached entry
+   *
+   * @param username username of the user
+   * @return `ProfileCodec::JournalPositions` the positions of its file
+   */
+  ProfileCodec::JournalPositions cachedPositions(
+      const QString& username) const;
+
+  /**
+   * @brief Read a user's file into the cache if the profile is sharded
+   * Records the journal positions the file contains
+   *
+   * @param username username of the user
+   */
+  void loadShard(const QString& username) const;
+
+  /**
+   * @brief Whether a user exists, without loading the user's file
+   *
+   * @param username username of the user
+   * @return `bool` true if the user is in the profile
+   */
+  bool hasUser(const QString& username) const;
+
+  /**
+   * @brief Copy a user's role statistics into the cached profile document
+   * Stored under "role_statistics", next to "statistics"
+   *
+   * @param username username of the user
+   * @param stats the counters to store
+   */
+  void writeRoleStatsToJson(const QString& username,
+                            const RoleStats& stats) const;
+
+  /**
+   * @brief Copy a user's ratings into the cached profile document
+   * Stored under "ratings", next to "statistics"
+   *
+   * @param username username of the user
+   * @param ratings the ratings to store
+   */
+  void writeRatingsToJson(const QString& username,
+                          const PlayerRatings& ratings) const;
+
+  /**
+   * @brief Re-rank a user after their statistics changed
+   * Does nothing until the leaderboard has been built
+   *
+   * @param username username of the user
+   */
+  void rankStats(const QString& username);
+
+  /**
+   * @brief Re-rank the users a reload of the profile changed
+   * Removes the users that are gone and updates the ones that are new or
+   * whose statistics differ, instead of rebuilding every leaderboard. Does
+   * nothing until the leaderboard has been built.
+   *
+   * @param previousUsers usernames before the reload
+   * @param previousStats cached statistics before the reload
+   */
+  void rankChangedUsers(const QStringList& previousUsers,
+                        const QHash<QString, UserStats>& previousStats);
+
+  /**
+   * @brief Add a change of statistics to today's bucket of a user
+   * Called from every path that changes the counters
+   *
+   * @param username username of the user
+   * @param delta the counters to add
+   */
+  void bucketStats(const QString& username, const StatsCounters& delta);
+
+  /**
+   * @brief Check that the profile is loaded and usable
+   * Missing files and invalid profiles are left in lastError
+   *
+   * @return `bool` true if the profile table can be read
+   */
+  bool checkProfileStatus() const;
+
+  /**
+   * @brief Look up the statistics of a user without reporting errors
+   * The profile must already have passed checkProfileStatus
+   *
+   * @param username username of the user
+   * @return `const UserStats*` the statistics, or nullptr if not found
+   */
+  const UserStats* cachedStats(const QString& username) const;
+
+  /**
+   * @brief Look up the statistics of a user in the statistics table
+   * Missing files, invalid profiles and unknown users are left in lastError
+   *
+   * @param username username of the user
+   * @return `const UserStats*` the statistics, or nullptr on error
+   */
+  const UserStats* findStats(const QString& username) const;
+
+  /**
+   * @brief Add to the counters of a user, for won, lost, hit and miss
+   * Unknown users are reported through statusMessage
+   *
+   * @param username username of the user
+   * @param delta the amount to add to each counter
+   */
+  void addStats(const QString& username, const UserStats& delta);
+
+  /**
+   * @brief Copy a user's statistics into the cached profile document
+   *
+   * @param username username of the user
+   * @param stats the statistics to copy
+   */
+  void writeStatsToJson(const QString& username, const UserStats& stats) const;
+
+  /**
+   * @brief Copy the counters changed in the table into the cached profile
+   * document
+   * Counter updates only touch the table, callers handing out user entries
+   * call this first
+   */
+  void syncStatsToJson() const;
+
+  /**
+   * @brief Append the difference between two statistics to the journal
+   *
+   * @param username username of the user
+   * @param before the statistics before the change
+   * @param after the statistics after the change
+   * @param patch receives the records
+   */
+  void journalStats(const QString& username, const UserStats& before,
+                    const UserStats& after, UserPatch& patch);
+
+  /**
+   * @brief Journal and apply statistics changes, without queueing them
+   *
+   * @param deltas the amount to add to each counter, keyed by username
+   * @param patches receives the records of each user
+   */
+  void addStatsDeltas(const QHash<QString, UserStats>& deltas,
+                      QHash<QString, UserPatch>& patches);
+
+  /**
+   * @brief Journal and apply role statistics changes, without queueing them
+   *
+   * @param deltas the amount to add to each role counter, keyed by username
+   * @param patches receives the records of each user
+   */
+  void addRoleStatsDeltas(const QHash<QString, RoleStats>& deltas,
+                          QHash<QString, UserPatch>& patches);
+
+  /**
+   * @brief Apply the records of the owned and adopted journals that the
+   * profile does not contain yet
+   * Called once at startup, the replayed users are queued for writing
+   */
+  void replayStatsJournal();
+
+  /**
+   * @brief Append a rating change to the journal
+   * The change is rounded to the journal's scale first, so the rating kept in
+   * memory is the one a replay would rebuild
+   *
+   * @param username username of the user
+   * @param role the role the rating belongs to
+   * @param before the rating before the game
+   * @param after the rating after the game, receives the rounded rating
+   * @param patch receives the records
+   */
+  void journalRating(const QString& username, RatingEngine::Role role,
+                     const Rating& before, Rating& after, UserPatch& patch);
+
+  /**
+   * @brief Store new statistics for a user and queue the profile write
+   *
+   * @param username username of the user, must be in the statistics table
+   * @param stats the new statistics of the user
+   */
+  void storeStats(const QString& username, const UserStats& stats);
+
+  /**
+   * @brief Read the "statistics" object of a user entry
+   *
+   * @param userObject the user entry from profile.json
+   * @param stats receives the parsed counters
+   * @return `bool` false if the entry has no statistics object
+   */
+  static bool parseUserStats(const QJsonValue& userObject, UserStats& stats);
+
+  /**
+   * @brief Replace a user's cached entry with a patched one
+   * Keeps the cache consistent with writes that are not on disk yet
+   *
+   * @param username username of the user
+   * @param userObject the patched user object, or null if removed
+   */
+  void applyCachedEntry(const QString& username,
+                        const QJsonValue& userObject) const;
+
+  /**
+   * @brief (Re)register the profile file and its directory with the watcher
+   */
+  void watchProfileFile();
+
+  /**
+   * @brief message of the last failure, see lastError
+   */
+  mutable QString errorText;
+
+  /**
+   * @brief the parsed profile document, kept to preserve non-statistics keys
+   */
+  mutable QJsonObject profileJson;
+
+  /**
+   * @brief users whose counters in statsTable are newer than the
+   * "statistics" object in profileJson
+   */
+  mutable QSet<QString> staleJsonStats;
+
+  /**
+   * @brief usernames listed in the shard index, plus queued additions
+   * Only used when the profile is sharded
+   */
+  mutable QSet<QString> profileIndex;
+
+  /**
+   * @brief whether the cache was loaded from the sharded layout
+   * profileJson and statsTable then hold only the users read so far
+   */
+  mutable bool profileSharded = false;
+
+  /**
+   * @brief whether profileJson and statsTable reflect profile.json
+   */
+  mutable bool profileCacheValid = false;
+
+  /**
+   * @brief generation of the profile file the cache was loaded from
+   * Compared with the file header to tell whether the cache is current
+   */
+  mutable quint64 profileGeneration = 0;
+
+  /**
+   * @brief journal positions recorded in the cached profile.json
+   */
+  mutable ProfileCodec::JournalPositions profilePositions;
+
+  /**
+   * @brief journal positions recorded in each loaded user file, by username
+   */
+  mutable QHash<QString, ProfileCodec::JournalPositions> shardPositions;
+
+  /**
+   * @brief outcome of the last parse of profile.json
+   */
+  mutable ProfileStatus profileStatus = ProfileMissing;
+
+  /**
+   * @brief watches profile.json so external edits invalidate the cache
+   */
+  QFileSystemWatcher* profileWatcher;
+
+  /**
+   * @brief reports the background integrity scan started at startup
+   */
+  QFutureWatcher<ProfileScanner::Report>* profileScanWatcher = nullptr;
+
+  /**
+   * @brief the per-user profile files
+   */
+  ProfileShards* profileShards;
+
+  /**
+   * @brief mapped counters of every loaded user, refilled on every load
+   * Owned by this instance, like statsJournal
+   */
+  StatsTable* statsTable;
+
+  /**
+   * @brief mapped daily counters, for the windowed statistics
+   */
+  StatsBuckets* statsBuckets;
+
+  /**
+   * @brief mapped records of every teammate and opponent pair
+   */
+  PairStats* pairStats;
+
+  /**
+   * @brief append-only log of statistics changes, compacted by the flusher
+   * Owned by this instance, no other one appends to it
+   */
+  StatsJournal* statsJournal;
+
+  /**
+   * @brief journals a crashed instance left records in, replayed at startup
+   * and compacted by the flusher
+   */
+  QList<StatsJournal*> adoptedJournals;
+
+  /**
+   * @brief every finished game, appended as each game ends
+   */
+  MatchHistory* history;
+
+  /**
+   * @brief queues profile changes and writes them on profileFlusherThread
+   */
+  ProfileFlusher* profileFlusher;
+
+  /**
+   * @brief worker thread that owns profileFlusher
+   */
+  QThread* profileFlusherThread;
+};
+
+#endif  // PROFILESTORE_H
@@ -0,0 +1,193 @@
+/**
+ * @file ratingengine.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Glicko skill ratings for the spymaster and operative roles
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef RATINGENGINE_H
+#define RATINGENGINE_H
+
+#include <QHash>    // For the recomputed ratings of every player
+#include <QString>  // For usernames
+#include <QVector>  // For match history
+
+/**
+ * @brief Skill rating of a player in one role
+ */
+struct Rating {
+  double rating = 1500;    ///< estimated skill
+  double deviation = 350;  ///< uncertainty of the estimate (Glicko RD)
+  quint32 games = 0;       ///< rated games played in this role
+  qint64 lastPlayed = 0;   ///< ms since epoch of the last rated game
+};
+
+/**
+ * @brief Ratings of a player in both roles
+ */
+struct PlayerRatings {
+  Rating spymaster;  ///< rating as a spymaster
+  Rating operative;  ///< rating as an operative
+};
+
+/**
+ * @brief The four players of a finished game and who won
+ */
+struct MatchResult {
+  QString players[4];    ///< usernames, indexed by RatingEngine::Seat
+  bool redWon = false;   ///< true if the red team won
+  qint64 timestamp = 0;  ///< ms since epoch when the game ended
+};
+
+/**
+ * @brief Glicko rating updates for team games
+ *
+ * Each player has a separate rating per role. A team is rated as the mean
+ * of its spymaster and operative ratings (deviations are combined as the
+ * root mean square), and each player is scored against the other team.
+ *
+ * Glicko updates every player once per rating period from the ratings at
+ * the start of the period, so within a period the updates are independent.
+ * recompute() uses that to spread a whole match history over every core:
+ * the team ratings of all games of a period and the new rating of every
+ * player in it are each computed in parallel. A live game (rateMatch) is
+ * its own period.
+ */
+class RatingEngine {
+ public:
+  /**
+   * @brief The two roles a player is rated in
+   */
+  enum Role { Spymaster, Operative, RoleCount };
+
+  /**
+   * @brief The four places of a game
+   */
+  enum Seat {
+    RedSpymaster,
+    RedOperative,
+    BlueSpymaster,
+    BlueOperative,
+    SeatCount
+  };
+
+  /**
+   * @brief Tunable constants of the rating system
+   */
+  struct Params {
+    double initialRating = 1500;    ///< rating of a new player
+    double initialDeviation = 350;  ///< deviation of a new player, the max
+    double minDeviation = 30;       ///< floor, so ratings keep moving
+    double deviationGrowth = 35;    ///< deviation added per idle period (c)
+    qint64 periodMs = 86400000;     ///< length of a rating period (one day)
+  };
+
+  /**
+   * @brief Construct an engine with the default constants
+   */
+  RatingEngine();
+
+  /**
+   * @brief Construct an engine
+   *
+   * @param params the constants to rate with
+   */
+  explicit RatingEngine(const Params& params);
+
+  /**
+   * @brief The constants the engine rates with
+   *
+   * @return `const Params&` the parameters
+   */
+  const Params& params() const;
+
+  /**
+   * @brief Rating of a player who has never played
+   *
+   * @return `Rating` the initial rating
+   */
+  Rating initialRating() const;
+
+  /**
+   * @brief Role played from a seat
+   *
+   * @param seat the seat
+   * @return `Role` Spymaster or Operative
+   */
+  static Role roleOf(Seat seat);
+
+  /**
+   * @brief Rating of a player in a role
+   *
+   * @param ratings the ratings of the player
+   * @param role the role
+   * @return `Rating&` the rating for that role
+   */
+  static Rating& roleRating(PlayerRatings& ratings, Role role);
+
+  /**
+   * @brief Update the ratings of the four players of one game
+   *
+   * @param seats the role rating of each seat, updated in place
+   * @param redWon true if the red team won
+   * @param timestamp ms since epoch when the game ended
+   */
+  void rateMatch(Rating seats[SeatCount], bool redWon, qint64 timestamp) const;
+
+  /**
+   * @brief Rate a whole match history from scratch, using every core
+   *
+   * @param matches the games, in any order
+   * @return `QHash<QString, PlayerRatings>` the ratings of every player
+   */
+  QHash<QString, PlayerRatings> recompute(
+      const QVector<MatchResult>& matches) const;
+
+ private:
+  /**
+   * @brief Rating and deviation a team is scored against
+   */
+  struct Opponent {
+    double rating;
+    double deviation;
+  };
+
+  /**
+   * @brief Rating of two teams from the ratings of their seats
+   *
+   * @param seats the role rating of each seat
+   * @param red set to the red team
+   * @param blue set to the blue team
+   */
+  static void teamRatings(const Rating* const seats[SeatCount], Opponent& red,
+                          Opponent& blue);
+
+  /**
+   * @brief Grow the deviation of a rating for the periods it was idle
+   *
+   * @param rating the rating, updated in place
+   * @param timestamp when the rating is next used
+   */
+  void age(Rating& rating, qint64 timestamp) const;
+
+  /**
+   * @brief Apply one period of results to a rating
+   *
+   * @param rating the rating at the start of the period, updated in place
+   * @param opponents the teams played against
+   * @param scores 1 for a win, 0 for a loss, one per opponent
+   * @param count the number of games
+   */
+  void update(Rating& rating, const Opponent* opponents, const double* scores,
+              int count) const;
+
+  /**
+   * @brief the constants to rate with
+   */
+  Params constants;
+};
+
+#endif  // RATINGENGINE_H
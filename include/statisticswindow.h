@@ -67,10 +67,10 @@ class StatisticsWindow : public QWidget {
 
  private:
   /**
-   * @brief the users instance
-   * Singleton reference to access user data and statistics
+   * @brief the profile store of the User singleton
+   * Reference to access user data and statistics
    */
-  User* users;
+  ProfileStore* users;
 
   /**
    * @brief button to click to go back to main
@@ -138,13 +138,120 @@ class StatisticsWindow : public QWidget {
    */
   QLabel* guessHitRateStats;
 
+  /**
+   * @brief the win rate of the user over the last 7 days
+   * Display label showing win percentage and games of the week
+   */
+  QLabel* weekWinRateStats;
+
+  /**
+   * @brief the guess hit rate of the user over the last 7 days
+   * Display label showing guess accuracy and guesses of the week
+   */
+  QLabel* weekHitRateStats;
+
+  /**
+   * @brief the win rate of the user over the last 30 days
+   * Display label showing win percentage and games of the month
+   */
+  QLabel* monthWinRateStats;
+
+  /**
+   * @brief the guess hit rate of the user over the last 30 days
+   * Display label showing guess accuracy and guesses of the month
+   */
+  QLabel* monthHitRateStats;
+
+  /**
+   * @brief the number of clues the user gave as spymaster
+   * Display label showing clues given
+   */
+  QLabel* cluesGivenStats;
+
+  /**
+   * @brief the average number of words per clue
+   * Display label showing words per numbered clue
+   */
+  QLabel* clueWordsStats;
+
+  /**
+   * @brief the clues whose every word was found
+   * Display label showing solved clues and their share of numbered clues
+   */
+  QLabel* cluesSolvedStats;
+
+  /**
+   * @brief the assassins revealed on the user's clues
+   * Display label showing assassins caused as spymaster
+   */
+  QLabel* assassinsCausedStats;
+
+  /**
+   * @brief the number of clues the user played as operative
+   * Display label showing clues received
+   */
+  QLabel* cluesReceivedStats;
+
+  /**
+   * @brief the average number of own agents found per clue
+   * Display label showing correct guesses per clue received
+   */
+  QLabel* correctPerClueStats;
+
+  /**
+   * @brief the correct guesses beyond the clue number
+   * Display label showing bonus guesses
+   */
+  QLabel* bonusGuessesStats;
+
+  /**
+   * @brief the bystanders and opponent agents revealed
+   * Display label showing wrong guesses as operative
+   */
+  QLabel* wrongGuessesStats;
+
+  /**
+   * @brief the assassins the user revealed
+   * Display label showing assassin hits as operative
+   */
+  QLabel* assassinGuessesStats;
+
+  /**
+   * @brief the teammate the user wins most with
+   * Display label showing the partner, win rate and games together
+   */
+  QLabel* bestPartnerStats;
+
  private:
   /**
    * @brief populate the drop down button with the usernames
-   * Fetches user list from User singleton and fills dropdown menu
+   * Binds the dropdown menu to the shared username model of the profile store
    */
   void populateDropDown();
 
+  /**
+   * @brief format a rate with the count it was computed from
+   * Shows N/A when there is nothing to compute the rate from
+   *
+   * @param rate the rate, between 0 and 1
+   * @param count the games or guesses behind the rate
+   * @param unit what count counts
+   * @return `QString` the text to display
+   */
+  QString formatRate(float rate, unsigned int count,
+                     const QString& unit) const;
+
+  /**
+   * @brief add a titled statistic row to a column
+   *
+   * @param column the column to add the row to
+   * @param title the text in front of the value
+   * @param style the style sheet of the value
+   * @return `QLabel*` the label showing the value
+   */
+  QLabel* addStatsRow(QVBoxLayout* column, const QString& title,
+                      const QString& style);
+
  private slots:
   /**
    * @brief to back to the main window
@@ -0,0 +1,262 @@
+/**
+ * @file statsbuckets.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Memory-mapped rings of daily statistics counters
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef STATSBUCKETS_H
+#define STATSBUCKETS_H
+
+#include <QFile>      // For the mapped file
+#include <QLockFile>  // For sharing the file with other instances
+#include <QString>    // For usernames and paths
+
+#include "statscounters.h"  // For the four counters
+#include "userids.h"        // For the ids records are keyed by
+
+/**
+ * @brief Per-user counters of the last Days days, mapped into memory
+ *
+ * A 64 byte header and a power-of-two number of fixed-size records, found
+ * by linear probing on the user's id. Ids come from a names file next to
+ * the table (filePath.names), the same way PairStats numbers its users, so
+ * names of any length fit and a rename only rewrites the names file. Each
+ * record holds a ring of Days day buckets; the bucket of a day is
+ * days[day % Days], and a bucket stamped with an older day is cleared
+ * before it is reused, so old days roll off without any cleanup pass. A
+ * window query reads at most Days buckets, whatever the age of the account.
+ *
+ * Day counters are 16 bits and saturate.
+ *
+ * Several instances may map the same file. Every public call holds the
+ * file's lock (filePath.lock). A rebuild marks the table it replaces as
+ * retired, and every new name or rename bumps a generation in the header;
+ * an instance remaps a retired table, and rereads the names when the
+ * generation is not the one it last saw. Not thread safe within a process.
+ */
+class StatsBuckets {
+ public:
+  /// days kept per user, enough for a 30 day window that includes today
+  static const int Days = 32;
+
+  /**
+   * @brief Construct a table for a file, call open() before use
+   *
+   * @param filePath path of the bucket file, names go to filePath.names
+   */
+  explicit StatsBuckets(const QString& filePath);
+
+  /**
+   * @brief Unmap and close the file
+   */
+  ~StatsBuckets();
+
+  /**
+   * @brief Map the table and read the names, creating both if needed
+   *
+   * @param initialCapacity slots of a new table, a power of two
+   * @return `bool` true if the table is mapped
+   */
+  bool open(quint32 initialCapacity = 256);
+
+  /**
+   * @brief Whether the table is mapped
+   *
+   * @return `bool` true after a successful open()
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Add counters to a day of a user, adding the user if needed
+   *
+   * @param username username of the user
+   * @param day the day, as a Julian day number
+   * @param delta the counters to add
+   * @return `bool` false if the user could not be added or the table is
+   * closed
+   */
+  bool add(const QString& username, qint64 day, const StatsCounters& delta);
+
+  /**
+   * @brief Sum the counters of a user over the days ending today
+   *
+   * @param username username of the user
+   * @param today the last day of the window, as a Julian day number
+   * @param days length of the window, at most Days
+   * @return `StatsCounters` the totals, zero for an unknown user
+   */
+  StatsCounters window(const QString& username, qint64 today, int days) const;
+
+  /**
+   * @brief Move the buckets of a user to a new name
+   * The id stays, only the names file is rewritten
+   *
+   * @param oldUsername the current username
+   * @param newUsername the new username
+   * @return `bool` true if the user had an id and the new name did not
+   */
+  bool rename(const QString& oldUsername, const QString& newUsername);
+
+  /**
+   * @brief Remove the buckets of a user
+   *
+   * @param username username of the user
+   * @return `bool` true if a record was removed
+   */
+  bool remove(const QString& username);
+
+ private:
+  /**
+   * @brief Counters of one day, stamped with the day they belong to
+   */
+  struct Bucket {
+    quint32 day;  ///< Julian day number, 0 for never used
+    quint16 gamesPlayed;
+    quint16 gamesWin;
+    quint16 guessTotal;
+    quint16 guessHit;
+  };
+
+  /**
+   * @brief Layout of the file header
+   */
+  struct Header {
+    char magic[4];
+    quint32 version;
+    quint32 capacity;    ///< number of records, a power of two
+    quint32 used;        ///< records holding a user
+    quint32 deleted;     ///< records left by remove()
+    quint32 retired;     ///< non-zero once a rebuild replaced the file
+    quint32 generation;  ///< bumped by every new name and rename
+    quint32 reserved[9];
+  };
+
+  /**
+   * @brief Layout of one record
+   */
+  struct Record {
+    quint32 id;     ///< the user's id in the names file
+    quint32 state;  ///< empty, used or deleted
+    Bucket days[Days];
+  };
+
+  static_assert(sizeof(Header) == 64, "StatsBuckets header must be 64 bytes");
+  static_assert(sizeof(Bucket) == 12, "StatsBuckets bucket must be 12 bytes");
+  static_assert(sizeof(Record) == 8 + Days * sizeof(Bucket),
+                "StatsBuckets record must not be padded");
+
+  /**
+   * @brief Slot an id starts probing at
+   *
+   * @param id a user id
+   * @return `quint64` a well mixed hash of the id
+   */
+  static quint64 hashId(quint32 id);
+
+  /**
+   * @brief Find the record of a user
+   *
+   * @param id the user's id
+   * @return `Record*` the record, nullptr if absent
+   */
+  Record* lookup(quint32 id) const;
+
+  /**
+   * @brief Find the record of a username, adding an id and an empty record
+   * if needed
+   *
+   * @param username username of the user
+   * @return `Record*` the record, nullptr if the name could not be saved or
+   * the table could not grow
+   */
+  Record* insert(const QString& username);
+
+  /**
+   * @brief Tombstone a record
+   *
+   * @param record a used record of the mapping
+   */
+  void erase(Record* record);
+
+  /**
+   * @brief Catch up with changes another instance made
+   * Remaps a retired table, then rereads the names if the generation
+   * changed. Caller holds the lock.
+   *
+   * @return `bool` true if a table is mapped
+   */
+  bool refresh() const;
+
+  /**
+   * @brief Record a change of the names made by this instance
+   */
+  void bumpGeneration();
+
+  /**
+   * @brief Write a table of the given size holding the current records
+   * Replaces the file atomically, retires the old table and maps the result.
+   * Caller holds the lock.
+   *
+   * @param capacity slots of the new table, a power of two
+   * @return `bool` true if the new table is mapped
+   */
+  bool rebuild(quint32 capacity);
+
+  /**
+   * @brief Map the open file and check its header
+   *
+   * @return `bool` true if the file holds a valid table
+   */
+  bool map() const;
+
+  /**
+   * @brief Unmap and close the file
+   */
+  void unmap() const;
+
+  /**
+   * @brief path of the bucket file
+   */
+  QString filePath;
+
+  /**
+   * @brief path of the lock shared with other instances
+   */
+  QString lockPath;
+
+  /**
+   * @brief the mapped file, const reads remap it once it is retired
+   */
+  mutable QFile file;
+
+  /**
+   * @brief start of the mapping, nullptr when closed
+   */
+  mutable uchar* data = nullptr;
+
+  /**
+   * @brief the header in the mapping
+   */
+  mutable Header* header = nullptr;
+
+  /**
+   * @brief the first record in the mapping
+   */
+  mutable Record* records = nullptr;
+
+  /**
+   * @brief generation of the table the names were read at
+   */
+  mutable quint32 seenGeneration = 0;
+
+  /**
+   * @brief ids of the users, from filePath.names
+   */
+  mutable UserIds userIds;
+};
+
+#endif  // STATSBUCKETS_H
@@ -0,0 +1,26 @@
+/**
+ * @file statscounters.h
+ * @author Team 9 - UWO CS 3307
+ * @brief The four counters every statistics file shares
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef STATSCOUNTERS_H
+#define STATSCOUNTERS_H
+
+#include <QtGlobal>  // For quint32
+
+/**
+ * @brief The four counters of a user, as stored in the mapped files
+ */
+struct StatsCounters {
+  quint32 gamesPlayed = 0;  ///< games_played
+  quint32 gamesWin = 0;     ///< games_win
+  quint32 guessTotal = 0;   ///< guess_total
+  quint32 guessHit = 0;     ///< guess_hit
+};
+
+#endif  // STATSCOUNTERS_H
@@ -0,0 +1,239 @@
+/**
+ * @file statsjournal.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Append-only binary journal of statistics changes
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef STATSJOURNAL_H
+#define STATSJOURNAL_H
+
+#include <QFile>      // For the append handle
+#include <QHash>      // For the username <-> id tables
+#include <QList>      // For the events since the last compaction
+#include <QLockFile>  // For owning the journal file
+#include <QMutex>     // For appends and compaction on different threads
+#include <QString>    // For usernames and paths
+
+/**
+ * @brief Append-only log of statistics events next to profile.json
+ *
+ * Every change to a number in a user entry (the counters, the role
+ * statistics and the ratings) is one small fixed-size record, so recording
+ * it costs O(1) no matter how many users the profile holds. The background
+ * profile writer folds the journal into profile.json and then compacts it.
+ *
+ * File layout: an 8 byte header ("CNJL", version) followed by records, each
+ * starting with a one byte type:
+ * - User:       id (u32), name length (u16), UTF-8 name
+ * - Stat:       seq (u64), user id (u32), field (u8), delta (i32),
+ *               timestamp in ms since epoch (i64)
+ * - Checkpoint: seq (u64)
+ *
+ * A profile file records, per journal file name, the last sequence number
+ * it contains (see ProfileCodec::JournalPositions). Replay applies only the
+ * newer records, so a crash between a snapshot write and the compaction
+ * never applies an event twice. Compaction keeps a checkpoint for the
+ * compacted sequence number, so numbering continues after a restart, and a
+ * new journal starts numbering from the clock so it never reuses a number
+ * a profile may still record. A torn record at the end of the file is
+ * discarded.
+ *
+ * Each running instance appends to a journal of its own: open() takes the
+ * journal's lock file and fails while another instance holds it, so ids,
+ * sequence numbers and compaction are never shared between processes. The
+ * profile store uses the first free slot (see slotPath) and adopts free
+ * journals an instance that crashed left records in.
+ */
+class StatsJournal {
+ public:
+  /**
+   * @brief The counter a stat record changes
+   */
+  enum Field : quint8 {
+    // "statistics"
+    GamesPlayed,
+    GamesWin,
+    GuessTotal,
+    GuessHit,
+
+    // "role_statistics", in the order of RoleStats
+    CluesGiven,
+    NumberedClues,
+    ClueWords,
+    CluesSolved,
+    AssassinsCaused,
+    CluesReceived,
+    CorrectGuesses,
+    BonusGuesses,
+    NeutralGuesses,
+    OpponentGuesses,
+    AssassinGuesses,
+
+    // "ratings", rating and deviation deltas are in RatingScale units
+    SpymasterRating,
+    SpymasterDeviation,
+    SpymasterGames,
+    OperativeRating,
+    OperativeDeviation,
+    OperativeGames,
+
+    FieldCount
+  };
+
+  /// rating and deviation deltas are stored in thousandths of a point
+  static const int RatingScale = 1000;
+
+  /// journals next to a profile, at most one per running instance
+  static const int MaxSlots = 16;
+
+  /**
+   * @brief One decoded stat record
+   */
+  struct Event {
+    quint64 seq = 0;            ///< position in the journal, increasing
+    QString journal;            ///< name() of the journal holding it
+    QString username;           ///< user whose counter changed
+    Field field = GamesPlayed;  ///< counter that changed
+    qint32 delta = 0;           ///< amount added to the counter
+    qint64 timestamp = 0;       ///< ms since epoch, the game's for Games
+  };
+
+  /**
+   * @brief Construct a journal for a file, call open() before use
+   *
+   * @param filePath path of the journal file
+   */
+  explicit StatsJournal(const QString& filePath);
+
+  /**
+   * @brief Take the journal's lock, read it into memory and open it for
+   * appending
+   * Creates the file if needed and cuts off a torn final record. The lock
+   * is held until the journal is destroyed.
+   *
+   * @return `bool` false if another instance owns the journal or it is
+   * unusable
+   */
+  bool open();
+
+  /**
+   * @brief Append a stat record
+   * Thread safe.
+   *
+   * @param username user whose counter changed
+   * @param field counter that changed
+   * @param delta amount added to the counter
+   * @param timestamp ms since epoch, now if 0
+   * @return `Event` the record, with seq 0 if it could not be written
+   */
+  Event append(const QString& username, Field field, qint32 delta,
+               qint64 timestamp = 0);
+
+  /**
+   * @brief Drop every record up to seq and rewrite the journal
+   * Call once a snapshot containing those events is on disk. Thread safe.
+   *
+   * @param seq last sequence number contained in the snapshot
+   * @return `bool` true if the journal was rewritten
+   */
+  bool compact(quint64 seq);
+
+  /**
+   * @brief Events that are not contained in a snapshot
+   * Thread safe.
+   *
+   * @param seq the position of this journal recorded in the snapshot
+   * @return `QList<Event>` events to apply on top of that snapshot, in order
+   */
+  QList<Event> eventsAfter(quint64 seq) const;
+
+  /**
+   * @brief Sequence number of the newest record
+   * Thread safe.
+   *
+   * @return `quint64` the last sequence number handed out
+   */
+  quint64 lastSequence() const;
+
+  /**
+   * @brief Name the profile records this journal's position under
+   *
+   * @return `QString` the file name of the journal
+   */
+  QString name() const;
+
+  /**
+   * @brief Path of one of the journals next to a profile
+   * Also numbers the other files an instance owns, like its StatsTable
+   *
+   * @param basePath path of the first journal, or of the first such file
+   * @param slot the slot, below MaxSlots
+   * @return `QString` basePath for slot 0, basePath.<slot> otherwise
+   */
+  static QString slotPath(const QString& basePath, int slot);
+
+ private:
+  /**
+   * @brief Id of a username, appending a user record the first time
+   * Caller holds the mutex.
+   *
+   * @param username the username
+   * @return `quint32` the id, 0 if the user record could not be written
+   */
+  quint32 userId(const QString& username);
+
+  /**
+   * @brief Append raw record bytes and push them to the OS
+   * Caller holds the mutex.
+   *
+   * @param record the encoded record
+   * @return `bool` true if every byte was written
+   */
+  bool writeRecord(const QByteArray& record);
+
+  /**
+   * @brief path of the journal file
+   */
+  QString filePath;
+
+  /**
+   * @brief append handle
+   */
+  QFile file;
+
+  /**
+   * @brief held while this instance owns the journal
+   */
+  QLockFile lock;
+
+  /**
+   * @brief guards every member below and the file
+   */
+  mutable QMutex mutex;
+
+  /**
+   * @brief username -> id of the user records in the file
+   */
+  QHash<QString, quint32> ids;
+
+  /**
+   * @brief next id to hand out
+   */
+  quint32 nextId = 1;
+
+  /**
+   * @brief last sequence number handed out
+   */
+  quint64 lastSeq = 0;
+
+  /**
+   * @brief stat records in the file, in order
+   */
+  QList<Event> events;
+};
+
+#endif  // STATSJOURNAL_H
@@ -0,0 +1,140 @@
+/**
+ * @file statssession.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Per-game buffer of statistics changes committed once at game end
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef STATSSESSION_H
+#define STATSSESSION_H
+
+#include <QHash>    // For per-user deltas
+#include <QString>  // For usernames
+
+#include "profilestore.h"  // For UserStats and the profile store
+
+/**
+ * @brief Collects hit/miss/win/loss and role deltas for one game
+ * Nothing touches the disk until commit(), which applies every delta with a
+ * single profile write.
+ */
+class StatsSession {
+ public:
+  /**
+   * @brief What a revealed card was, seen from the revealing team
+   */
+  enum Reveal { OwnAgent, OpponentAgent, Bystander, Assassin };
+
+  /**
+   * @brief Construct an empty session
+   *
+   * @param users the profile store the deltas are committed to, the one
+   * of User if null
+   */
+  explicit StatsSession(ProfileStore* users = nullptr);
+
+  /**
+   * @brief Record a correct guess for a user
+   *
+   * @param username username of the user
+   */
+  void hit(const QString& username);
+
+  /**
+   * @brief Record an incorrect guess for a user
+   *
+   * @param username username of the user
+   */
+  void miss(const QString& username);
+
+  /**
+   * @brief Record a won game for a user
+   *
+   * @param username username of the user
+   */
+  void won(const QString& username);
+
+  /**
+   * @brief Record a lost game for a user
+   *
+   * @param username username of the user
+   */
+  void lost(const QString& username);
+
+  /**
+   * @brief Record a clue, the reveals that follow are counted against it
+   *
+   * @param spymaster username of the spymaster giving the clue
+   * @param operative username of the operative receiving it
+   * @param number number of words, 0 for unlimited
+   */
+  void clue(const QString& spymaster, const QString& operative, int number);
+
+  /**
+   * @brief Record a card revealed on the current clue
+   * O(1): updates the operative and spymaster of that clue only
+   *
+   * @param card what the card was for the revealing team
+   */
+  void reveal(Reveal card);
+
+  /**
+   * @brief Whether any change is waiting to be committed
+   *
+   * @return `bool` true if there is nothing to commit
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Apply every recorded delta in one write and clear the session
+   *
+   * @return `bool` true if the deltas were written (or there were none)
+   */
+  bool commit();
+
+  /**
+   * @brief Forget every recorded delta without writing
+   */
+  void discard();
+
+ private:
+  /**
+   * @brief the profile store to commit to
+   */
+  ProfileStore* users;
+
+  /**
+   * @brief accumulated changes, keyed by username
+   */
+  QHash<QString, UserStats> deltas;
+
+  /**
+   * @brief accumulated role statistics changes, keyed by username
+   */
+  QHash<QString, RoleStats> roleDeltas;
+
+  /**
+   * @brief spymaster of the current clue, empty before the first one
+   */
+  QString clueSpymaster;
+
+  /**
+   * @brief operative of the current clue
+   */
+  QString clueOperative;
+
+  /**
+   * @brief number of the current clue, 0 for unlimited
+   */
+  int clueNumber = 0;
+
+  /**
+   * @brief own agents found on the current clue
+   */
+  int clueFound = 0;
+};
+
+#endif  // STATSSESSION_H
@@ -0,0 +1,235 @@
+/**
+ * @file statstable.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Memory-mapped table of fixed-size statistics records
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef STATSTABLE_H
+#define STATSTABLE_H
+
+#include <QFile>      // For the mapped file
+#include <QHash>      // For copies of every record
+#include <QLockFile>  // For owning the table file
+#include <QString>    // For usernames and paths
+
+#include "statscounters.h"  // For the four counters
+#include "userids.h"        // For the ids records are keyed by
+
+/**
+ * @brief Fixed-record statistics file mapped into memory
+ *
+ * The file is a 64 byte header followed by a power-of-two number of 24 byte
+ * records, each holding a user's four counters. Records are found by open
+ * addressing (linear probing) on the user's id, handed out by an in-memory
+ * UserIds, so a lookup is a hash probe and a few record probes and an
+ * increment is a store to mapped memory. The table is grown (rebuilt at
+ * twice the size) when more than half of the slots are taken.
+ *
+ * The table is a working copy, not a second source of truth: its owner
+ * reset()s and refills it whenever it reads the profile, and journals every
+ * change it makes to a record. Each table belongs to one instance: open()
+ * takes the table's lock file and fails while another instance holds it.
+ * Not thread safe; pointers returned by find() and insert() are valid until
+ * the next insert(), reserve() or reset().
+ */
+class StatsTable {
+ public:
+  /**
+   * @brief Construct a table for a file, call open() before use
+   *
+   * @param filePath path of the table file
+   */
+  explicit StatsTable(const QString& filePath);
+
+  /**
+   * @brief Unmap and close the file
+   */
+  ~StatsTable();
+
+  /**
+   * @brief Take the table's lock and map an empty table
+   * The lock is held until the table is destroyed.
+   *
+   * @param initialCapacity slots of the table, a power of two
+   * @return `bool` false if another instance owns the table or it could not
+   * be written
+   */
+  bool open(quint32 initialCapacity = 1024);
+
+  /**
+   * @brief Whether the table is mapped
+   *
+   * @return `bool` true after a successful open()
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Forget every record and name
+   * The mapping is cleared in place and keeps its size.
+   *
+   * @return `bool` true if an empty table is mapped
+   */
+  bool reset();
+
+  /**
+   * @brief Grow the table up front for a number of users
+   * Saves the rebuilds inserting them one by one would make.
+   *
+   * @param users how many users the table should hold
+   * @return `bool` true if the table has room for them
+   */
+  bool reserve(int users);
+
+  /**
+   * @brief Find the counters of a user
+   *
+   * @param username username of the user
+   * @return `StatsCounters*` counters in mapped memory, nullptr if absent
+   */
+  StatsCounters* find(const QString& username);
+
+  /**
+   * @brief Find the counters of a user
+   *
+   * @param username username of the user
+   * @return `const StatsCounters*` counters in mapped memory, nullptr if
+   * absent
+   */
+  const StatsCounters* find(const QString& username) const;
+
+  /**
+   * @brief Set the counters of a user, adding a record if there is none
+   *
+   * @param username username of the user
+   * @param counters the counters to store
+   * @return `StatsCounters*` counters in mapped memory, nullptr if the name
+   * could not be saved or the table could not grow
+   */
+  StatsCounters* insert(const QString& username,
+                        const StatsCounters& counters);
+
+  /**
+   * @brief Remove the record of a user
+   *
+   * @param username username of the user
+   * @return `bool` true if a record was removed
+   */
+  bool remove(const QString& username);
+
+  /**
+   * @brief Number of records in use
+   *
+   * @return `int` the number of users in the table
+   */
+  int size() const;
+
+  /**
+   * @brief Copy every record out of the mapping
+   *
+   * @return `QHash<QString, StatsCounters>` the counters by username
+   */
+  QHash<QString, StatsCounters> toHash() const;
+
+ private:
+  /**
+   * @brief Layout of the file header
+   */
+  struct Header {
+    char magic[4];
+    quint32 version;
+    quint32 capacity;  ///< number of records, a power of two
+    quint32 used;      ///< records holding a user
+    quint32 deleted;   ///< records left by remove()
+    quint32 reserved[11];
+  };
+
+  /**
+   * @brief Layout of one record
+   */
+  struct Record {
+    quint32 id;     ///< the user's id in the names file
+    quint32 state;  ///< empty, used or deleted
+    StatsCounters counters;
+  };
+
+  static_assert(sizeof(Header) == 64, "StatsTable header must be 64 bytes");
+  static_assert(sizeof(Record) == 24, "StatsTable record must be 24 bytes");
+
+  /**
+   * @brief Slot an id starts probing at
+   *
+   * @param id a user id
+   * @return `quint64` a well mixed hash of the id
+   */
+  static quint64 hashId(quint32 id);
+
+  /**
+   * @brief Find the record of a user
+   *
+   * @param id the user's id
+   * @return `Record*` the record, nullptr if absent
+   */
+  Record* lookup(quint32 id) const;
+
+  /**
+   * @brief Write a table of the given size holding the current records
+   * Replaces the file atomically and maps the result.
+   *
+   * @param capacity slots of the new table, a power of two
+   * @return `bool` true if the new table is mapped
+   */
+  bool rebuild(quint32 capacity);
+
+  /**
+   * @brief Map the open file and check its header
+   *
+   * @return `bool` true if the file holds a valid table
+   */
+  bool map();
+
+  /**
+   * @brief Unmap and close the file
+   */
+  void unmap();
+
+  /**
+   * @brief path of the table file
+   */
+  QString filePath;
+
+  /**
+   * @brief held while this instance owns the table
+   */
+  QLockFile lock;
+
+  /**
+   * @brief the mapped file
+   */
+  QFile file;
+
+  /**
+   * @brief start of the mapping, nullptr when closed
+   */
+  uchar* data = nullptr;
+
+  /**
+   * @brief the header in the mapping
+   */
+  Header* header = nullptr;
+
+  /**
+   * @brief the first record in the mapping
+   */
+  Record* records = nullptr;
+
+  /**
+   * @brief ids of the users, only in memory as the table is refilled anyway
+   */
+  UserIds userIds;
+};
+
+#endif  // STATSTABLE_H
@@ -0,0 +1,113 @@
+/**
+ * @file userids.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Small ids for usernames, saved to a names file
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef USERIDS_H
+#define USERIDS_H
+
+#include <QHash>    // For ids by username
+#include <QString>  // For usernames and paths
+#include <QVector>  // For usernames by id
+
+/**
+ * @brief Usernames numbered in the order they were first seen
+ *
+ * Lets a mapped table key its fixed-size records by a 32-bit id instead of
+ * the username, so a name of any length fits and a rename leaves the
+ * records alone. The names file is a 4 byte magic followed by one entry per
+ * id, a 16-bit big-endian length and the UTF-8 name; id 0 is never handed
+ * out. Ids are appended before they are used and never reused.
+ *
+ * Does no locking; an owner shared with other instances holds its own lock
+ * around every call and read()s again when another instance added a name.
+ */
+class UserIds {
+ public:
+  /**
+   * @brief Construct the ids of a names file, call read() or reset() first
+   *
+   * @param filePath path of the names file, empty to keep the names in
+   * memory only
+   */
+  explicit UserIds(const QString& filePath);
+
+  /**
+   * @brief Read every name from the file
+   * Cuts off a name torn by a crash mid-append.
+   *
+   * @return `bool` false if the file is missing or not a names file, or the
+   * names are kept in memory only
+   */
+  bool read();
+
+  /**
+   * @brief Forget every name and write an empty file
+   *
+   * @return `bool` true if the file was written
+   */
+  bool reset();
+
+  /**
+   * @brief Id of a username
+   *
+   * @param username the username
+   * @return `quint32` the id, 0 if the name has none
+   */
+  quint32 id(const QString& username) const;
+
+  /**
+   * @brief Id of a username, assigning and saving a new one if needed
+   *
+   * @param username the username
+   * @return `quint32` the id, 0 if the name could not be saved
+   */
+  quint32 add(const QString& username);
+
+  /**
+   * @brief Give the id of a username to a new name
+   *
+   * @param oldUsername the current username
+   * @param newUsername the new username, which must not have an id
+   * @return `bool` true if the names file was rewritten
+   */
+  bool rename(const QString& oldUsername, const QString& newUsername);
+
+  /**
+   * @brief Username of an id
+   *
+   * @param id an id from id() or add()
+   * @return `QString` the username, empty for an unknown id
+   */
+  QString name(quint32 id) const;
+
+ private:
+  /**
+   * @brief Write every name, in id order
+   *
+   * @return `bool` true if the names file was replaced
+   */
+  bool write() const;
+
+  /**
+   * @brief path of the names file
+   */
+  QString filePath;
+
+  /**
+   * @brief usernames by id, index 0 unused
+   */
+  QVector<QString> names;
+
+  /**
+   * @brief ids by username
+   */
+  QHash<QString, quint32> ids;
+};
+
+#endif  // USERIDS_H
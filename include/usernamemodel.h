@@ -0,0 +1,105 @@
+/**
+ * @file usernamemodel.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Shared sorted list model of every username
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef USERNAMEMODEL_H
+#define USERNAMEMODEL_H
+
+#include <QAbstractListModel>  // Base class for the shared model
+#include <QString>             // For usernames
+#include <QStringList>         // For the sorted list
+
+/**
+ * @brief Sorted list of usernames that every account dropdown binds to
+ * Owned by ProfileStore and kept up to date incrementally: new accounts and
+ * renames insert or move single rows, and a reload after the profile
+ * changes on disk only emits the rows that differ, so views keep their
+ * selection.
+ */
+class UsernameModel : public QAbstractListModel {
+  Q_OBJECT
+
+ public:
+  /**
+   * @brief Construct an empty model
+   *
+   * @param parent the owner of the model
+   */
+  explicit UsernameModel(QObject* parent = nullptr);
+
+  /**
+   * @brief Number of usernames
+   *
+   * @param parent unused, the model is a flat list
+   * @return `int` the number of rows
+   */
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+  /**
+   * @brief The username of a row
+   *
+   * @param index the row
+   * @param role Qt::DisplayRole or Qt::EditRole
+   * @return `QVariant` the username, or an invalid QVariant
+   */
+  QVariant data(const QModelIndex& index,
+                int role = Qt::DisplayRole) const override;
+
+  /**
+   * @brief Replace the list, emitting only the rows that changed
+   *
+   * @param usernames every username, in any order
+   */
+  void setUsernames(QStringList usernames);
+
+  /**
+   * @brief Insert a username at its sorted position
+   *
+   * @param username the username to add, ignored if already present
+   */
+  void addUsername(const QString& username);
+
+  /**
+   * @brief Remove a username
+   *
+   * @param username the username to remove
+   */
+  void removeUsername(const QString& username);
+
+  /**
+   * @brief Move a username to its new name
+   *
+   * @param oldUsername the current username
+   * @param newUsername the new username
+   */
+  void renameUsername(const QString& oldUsername, const QString& newUsername);
+
+  /**
+   * @brief The sorted usernames
+   *
+   * @return `const QStringList&` every username
+   */
+  const QStringList& usernames() const;
+
+ private:
+  /**
+   * @brief Row a username has, or would have if inserted
+   *
+   * @param username the username
+   * @return `int` the first row not sorting before username
+   */
+  int lowerBound(const QString& username) const;
+
+  /**
+   * @brief the usernames, sorted
+   */
+  QStringList sorted;
+};
+
+#endif  // USERNAMEMODEL_H
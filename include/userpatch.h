@@ -0,0 +1,122 @@
+/**
+ * @file userpatch.h
+ * @author Team 9 - UWO CS 3307
+ * @brief Field-level changes to one user entry, queued for the profile writer
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef USERPATCH_H
+#define USERPATCH_H
+
+#include <QJsonObject>  // For user entries and their default keys
+#include <QJsonValue>   // For entries that may not exist
+#include <QList>        // For the journaled changes
+
+#include "profilecodec.h"  // For the journal positions of an entry
+#include "statsjournal.h"  // For the journaled changes
+
+/**
+ * @brief The changes made to one user since the profile was last written
+ *
+ * The profile writer applies a patch to the entry it reads under the
+ * profile lock, not to a copy cached earlier, so changes another instance
+ * wrote in between are kept. A patch holds the journal records of the
+ * changes, each adding to one number of the entry, and default keys that
+ * are only set where the entry has none (a new account, the initial rating
+ * of a role). An entry is only added by a patch that creates the user.
+ *
+ * Records at or below the journal positions an entry records are already
+ * in it and are skipped, so a patch can be applied to a newer entry again.
+ */
+class UserPatch {
+ public:
+  /**
+   * @brief Add a journaled change
+   *
+   * @param event the record returned by StatsJournal::append
+   */
+  void addEvent(const StatsJournal::Event& event);
+
+  /**
+   * @brief Add keys to set where the entry has none
+   * Nested objects are merged key by key, keys added first win.
+   *
+   * @param defaults the default keys
+   */
+  void addDefaults(const QJsonObject& defaults);
+
+  /**
+   * @brief Add the entry, from the defaults, if the profile has no such user
+   */
+  void createUser();
+
+  /**
+   * @brief Add the changes of a newer patch for the same user
+   *
+   * @param newer the patch queued after this one
+   */
+  void merge(const UserPatch& newer);
+
+  /**
+   * @brief Whether the patch changes an entry holding these positions
+   *
+   * @param positions journal positions the entry contains
+   * @return `bool` true if it creates the user or has a newer record
+   */
+  bool changes(const ProfileCodec::JournalPositions& positions) const;
+
+  /**
+   * @brief Newest record of each journal the patch holds
+   *
+   * @return `ProfileCodec::JournalPositions` sequence numbers by journal
+   */
+  ProfileCodec::JournalPositions positions() const;
+
+  /**
+   * @brief Apply the patch to a user entry
+   *
+   * @param entry the user entry, undefined if the user is not in the profile
+   * @param positions journal positions the entry contains
+   * @return `QJsonValue` the patched entry, undefined if the user is gone
+   */
+  QJsonValue apply(const QJsonValue& entry,
+                   const ProfileCodec::JournalPositions& positions) const;
+
+  /**
+   * @brief Apply one journal record to a user entry
+   * A rating record needs the role's rating in the entry, see addDefaults.
+   *
+   * @param entry the user entry
+   * @param event the record
+   */
+  static void applyEvent(QJsonObject& entry, const StatsJournal::Event& event);
+
+ private:
+  /**
+   * @brief Set the keys of defaults that target does not have
+   *
+   * @param target the object to fill
+   * @param defaults the default keys
+   */
+  static void mergeDefaults(QJsonObject& target, const QJsonObject& defaults);
+
+  /**
+   * @brief journaled changes, in the order they were made
+   */
+  QList<StatsJournal::Event> events;
+
+  /**
+   * @brief keys set where the entry has none
+   */
+  QJsonObject defaults;
+
+  /**
+   * @brief whether the patch adds the user if the profile has none
+   */
+  bool creates = false;
+};
+
+#endif  // USERPATCH_H
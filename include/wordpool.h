@@ -0,0 +1,111 @@
+/**
+ * @file wordpool.h
+ * @author Team 9 - UWO CS 3307
+ * @brief The words boards are dealt from, loaded once per process
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#ifndef WORDPOOL_H
+#define WORDPOOL_H
+
+#include <QString>  // For the words
+#include <QVector>  // For the word storage
+
+#include "boardrandom.h"  // For sampling boards
+
+/**
+ * @brief Immutable list of every word a card can show
+ *
+ * Read from the word list resource the first time it is asked for and never
+ * changed afterwards, so GameBoard, MultiBoard and any bot share one copy
+ * and a new game costs the same however many games came before. Duplicate
+ * and blank lines are dropped when loading. If the resource cannot be read
+ * a built-in list of 25 words is used.
+ *
+ * Safe to read from any thread once instance() has returned.
+ */
+class WordPool {
+ public:
+  /**
+   * @brief The pool of the process, loading it on first use
+   *
+   * @return `const WordPool&` the shared pool
+   */
+  static const WordPool& instance();
+
+  /**
+   * @brief Number of words
+   *
+   * @return `int` the size of the pool
+   */
+  int size() const;
+
+  /**
+   * @brief One word
+   *
+   * @param index position in the pool, 0 <= index < size()
+   * @return `const QString&` the word
+   */
+  const QString& at(int index) const;
+
+  /**
+   * @brief First word, with end() a read-only span over the pool
+   *
+   * @return `const QString*` the first word
+   */
+  const QString* begin() const;
+
+  /**
+   * @brief One past the last word
+   *
+   * @return `const QString*` the end of the span
+   */
+  const QString* end() const;
+
+  /**
+   * @brief A fingerprint of the words and their order
+   * FNV-1a over the pool, so a board code can tell which list it was
+   * dealt from
+   *
+   * @return `quint32` equal for equal pools
+   */
+  quint32 fingerprint() const;
+
+  /**
+   * @brief Positions of distinct words picked uniformly at random
+   * Floyd's algorithm: count draws and no allocation, however large the
+   * pool. The positions are then shuffled, so their order is random too.
+   *
+   * @param indices receives count positions into the pool
+   * @param count how many words, at most size()
+   * @param rng the generator to draw from
+   * @return `bool` false if the pool has fewer than count words
+   */
+  bool sample(int* indices, int count, BoardRandom& rng) const;
+
+  WordPool(const WordPool&) = delete;
+  WordPool& operator=(const WordPool&) = delete;
+
+ private:
+  /**
+   * @brief Load the pool from a word list, one word per line
+   *
+   * @param path the word list, normally the resource
+   */
+  explicit WordPool(const QString& path);
+
+  /**
+   * @brief the words, in file order
+   */
+  QVector<QString> words;
+
+  /**
+   * @brief fingerprint() of the words, computed when loading
+   */
+  quint32 hash;
+};
+
+#endif  // WORDPOOL_H
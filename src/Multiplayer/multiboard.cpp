@@ -50,14 +50,9 @@ MultiBoard::MultiBoard(bool isHost, QWebSocketServer *server, QList<QWebSocket *
     // Setup UI and words
     if (m_isHost)
     {
-        loadWordsFromFile();
         generateGameGrid();
     }
 
-    // Initialize scores
-    redCardsRemaining = 9;
-    blueCardsRemaining = 8;
-
     setupUI();
 
     // Get current player's role
@@ -86,6 +81,15 @@ MultiBoard::MultiBoard(bool isHost, QWebSocketServer *server, QList<QWebSocket *
     connect(hint, &SpymasterHint::hintSubmitted, this, &MultiBoard::advanceTurnSpymaster);
     connect(guess, &OperatorGuess::guessSubmitted, this, &MultiBoard::advanceTurn);
 
+    // Start recording, m_turnOrder lists the roles in seat order
+    m_matchRecord.start();
+    for (auto it = m_playerRoles.constBegin(); it != m_playerRoles.constEnd(); ++it)
+    {
+        int seat = m_turnOrder.indexOf(it.value().toLower());
+        if (seat >= 0)
+            m_matchRecord.players[seat] = it.key();
+    }
+
     // Set up the board
     setupBoard();
     updateTurnDisplay();
@@ -117,6 +121,8 @@ void MultiBoard::displayHint(const QString &hint, int number)
     QString chatNumber = (number == 0) ? "∞" : QString::number(number);
     QString hintMessage = currSpymasterName + " gives clue " + hint + " " + chatNumber;
     chatBox->addSystemMessage(hintMessage, (m_currentTurnIndex == RED_SPY) ? ChatBox::RED_TEAM : ChatBox::BLUE_TEAM);
+    m_matchRecord.addClue(m_currentTurnIndex == RED_SPY ? RatingEngine::RedSpymaster : RatingEngine::BlueSpymaster,
+                          hint, number);
 }
 void MultiBoard::handleNewConnection()
 {
@@ -130,101 +136,46 @@ void MultiBoard::handleNewConnection()
     m_clients.append(client);
 }
 
-void MultiBoard::loadWordsFromFile()
+void MultiBoard::generateGameGrid()
 {
-
-    // Load words from file
-    QFile file("resources/wordlist-eng.txt");
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    // Words and key card land in fixed arrays, nothing is allocated
+    BoardDealer::Board board;
+    if (!BoardDealer::deal(board))
     {
-        qDebug() << "failed to open wordlist-eng.text file, using fallback";
-        // Fallback word list if file not found
-        wordList = QStringList() << "apple" << "banana" << "cat" << "dog" << "elephant"
-                                 << "fish" << "goat" << "horse" << "iguana" << "jelly"
-                                 << "kangaroo" << "lion" << "monkey" << "nest" << "owl"
-                                 << "penguin" << "queen" << "rabbit" << "snake" << "tiger"
-                                 << "umbrella" << "violin" << "whale" << "xray" << "zebra";
+        qDebug() << "Not enough words to generate a game grid"
+                 << WordPool::instance().size();
         return;
     }
 
-    // Read words from file
-    QTextStream in(&file);
-    while (!in.atEnd())
+    // The key card becomes one mask per agent, the words are what is sent
+    boardState = BoardState(board);
+    const WordPool &pool = WordPool::instance();
+    m_words.clear();
+    for (int cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell)
     {
-        QString line = in.readLine().trimmed();
-        if (!line.isEmpty())
-        {
-            wordList.append(line);
-        }
+        m_words.append(pool.at(board.words[cell]));
     }
-    qDebug() << "Loaded" << wordList.size() << "words";
-    file.close();
 }
 
-void MultiBoard::generateGameGrid()
+MultiBoard::CardType MultiBoard::cardType(int row, int col) const
 {
-    // Ensure we have enough words
-    if (wordList.size() < 25)
-    {
-        qDebug() << "Not enough words to generate a game grid" << wordList.size();
-        return;
-    }
-
-    // Shuffle words
-    for (int i = wordList.size() - 1; i > 0; --i)
-    {
-        int j = QRandomGenerator::global()->bounded(i + 1);
-        wordList.swapItemsAt(i, j);
-    }
-
-    // Assign card types (Codenames rules: 9 for starting team, 8 for other team, 1 assassin, 7 neutral)
-    int redCards = 9;
-    int blueCards = 8;
-    int assassinCards = 1;
-    int neutralCards = 7;
-
-   
-    // Shuffle card types
-
-    QList<CardType> cardTypes;
-    for (int i = 0; i < redCards; ++i)
-        cardTypes.append(RED_TEAM);
-    for (int i = 0; i < blueCards; ++i)
-        cardTypes.append(BLUE_TEAM);
-    for (int i = 0; i < neutralCards; ++i)
-        cardTypes.append(NEUTRAL);
-    for (int i = 0; i < assassinCards; ++i)
-        cardTypes.append(ASSASSIN);
-
-    for (int i = cardTypes.size() - 1; i > 0; --i)
-    {
-        int j = QRandomGenerator::global()->bounded(i + 1);
-        cardTypes.swapItemsAt(i, j);
-    }
+    return CardType(boardState.agentAt(row * GRID_SIZE + col));
+}
 
-    // Fill the grid
-    int wordIndex = 0;
-    for (int i = 0; i < GRID_SIZE; ++i)
-    {
-        for (int j = 0; j < GRID_SIZE; ++j)
-        {
-            gameGrid[i][j].word = wordList[wordIndex];
-            gameGrid[i][j].type = cardTypes[wordIndex];
-            gameGrid[i][j].revealed = false;
-            ++wordIndex;
-        }
-    }
+void MultiBoard::updateCardCounts()
+{
+    redCardText->setText("Red Cards Remaining: " + QString::number(boardState.remaining(BoardDealer::RedAgent)));
+    blueCardText->setText("Blue Cards Remaining: " + QString::number(boardState.remaining(BoardDealer::BlueAgent)));
 }
 
 void MultiBoard::sendInitialGameState()
 {
     // Clear existing lists
-    m_words.clear();
     m_tileColors.clear();
     QVector<int> cardTypes; 
 
     // Validate grid initialization
-    if (gameGrid[0][0].word.isEmpty())
+    if (m_words.size() != GRID_SIZE * GRID_SIZE)
     {
         qWarning() << "Game grid not initialized";
         return;
@@ -239,11 +190,13 @@ void MultiBoard::sendInitialGameState()
             for (int j = 0; j < GRID_SIZE; ++j)
             {
                 // Store words
-                QString word = gameGrid[i][j].word.simplified();
-                m_words.append(word.isEmpty() ? "UNKNOWN" : word);
+                QString &word = m_words[i * GRID_SIZE + j];
+                word = word.simplified();
+                if (word.isEmpty())
+                    word = "UNKNOWN";
 
                 // Store numerical type codes (0=RED, 1=BLUE, 2=NEUTRAL, 3=ASSASSIN)
-                cardTypes.append(static_cast<int>(gameGrid[i][j].type));
+                cardTypes.append(static_cast<int>(cardType(i, j)));
             }
         }
 
@@ -318,10 +271,10 @@ void MultiBoard::setupUI()
 
     QHBoxLayout *cardsRemainingLayout = new QHBoxLayout();
 
-    redCardText = new QLabel("Red Cards Remaining: " + QString::number(redCardsRemaining));
+    redCardText = new QLabel("Red Cards Remaining: " + QString::number(BoardDealer::RedAgents));
     redCardText->setStyleSheet("color: #ff9999; font-weight: bold; font-size: 16px;");
 
-    blueCardText = new QLabel("Blue Cards Remaining: " + QString::number(blueCardsRemaining));
+    blueCardText = new QLabel("Blue Cards Remaining: " + QString::number(BoardDealer::BlueAgents));
     blueCardText->setStyleSheet("color: #9999ff; font-weight: bold; font-size: 16px;");
 
     cardsRemainingLayout->addWidget(redCardText);
@@ -408,7 +361,7 @@ void MultiBoard::setupBoard()
                 }
 
                 // Safe word retrieval
-                QString word = gameGrid[i][j].word; // Use reconstructed word
+                QString word = m_words[index]; // Use reconstructed word
                 if (word.isEmpty())
                 {
                     qWarning() << "Empty word at index" << index;
@@ -432,7 +385,7 @@ void MultiBoard::setupBoard()
                     btn->setEnabled(false);
 
                     // Safe type checking
-                    CardType safeType = (index < GRID_SIZE * GRID_SIZE) ? gameGrid[i][j].type : NEUTRAL;
+                    CardType safeType = (index < GRID_SIZE * GRID_SIZE) ? cardType(i, j) : NEUTRAL;
 
                     // Set button styles
                     switch (safeType)
@@ -479,11 +432,11 @@ void MultiBoard::setupBoard()
 void MultiBoard::checkGameEnd()
 {
     // Check if the game has ended
-    users = User::instance();
+    users = User::instance()->store();
 
 
     // Red team wins
-    if (redCardsRemaining == 0)
+    if (boardState.cleared(BoardDealer::RedAgent))
     {
         if (m_currentRole == "red_spymaster" || m_currentRole == "red_operative")
         {
@@ -493,12 +446,13 @@ void MultiBoard::checkGameEnd()
         {
             users->lost(m_currentUsername);
         }
+        recordResult(true, MatchRecord::AllAgentsFound);
         QMessageBox::information(this, "Game Over", "Red team wins!");
     }
 
     // Blue team wins
 
-    if (blueCardsRemaining == 0)
+    if (boardState.cleared(BoardDealer::BlueAgent))
     {
         if (m_currentRole == "blue_spymaster" || m_currentRole == "blue_operative")
         {
@@ -508,10 +462,38 @@ void MultiBoard::checkGameEnd()
         {
             users->lost(m_currentUsername);
         }
+        recordResult(false, MatchRecord::AllAgentsFound);
         QMessageBox::information(this, "Game Over", "Blue team wins!");
     }
 }
 
+void MultiBoard::recordResult(bool redWon, MatchRecord::EndReason reason)
+{
+    // Every peer shares the same resources/ folder, so only the host rates
+    // and records the game; clients doing it too would count it twice
+    if (!m_isHost || m_gameRecorded)
+        return;
+    m_gameRecorded = true;
+
+    // The words are only final once the board is set up, so they are copied
+    // here rather than when the record is started
+    for (int i = 0; i < GRID_SIZE; ++i)
+    {
+        for (int j = 0; j < GRID_SIZE; ++j)
+        {
+            m_matchRecord.words[i * GRID_SIZE + j] = m_words.value(i * GRID_SIZE + j);
+            m_matchRecord.keyCard[i * GRID_SIZE + j] = quint8(cardType(i, j));
+        }
+    }
+    m_matchRecord.redWon = redWon;
+    m_matchRecord.endReason = reason;
+    m_matchRecord.endedAt = QDateTime::currentMSecsSinceEpoch();
+
+    users = User::instance()->store();
+    users->rateMatch(m_matchRecord.result());
+    users->recordMatch(m_matchRecord);
+}
+
 void MultiBoard::processMessage(const QString &message)
 {
 
@@ -562,25 +544,19 @@ void MultiBoard::processMessage(const QString &message)
         m_words = parts[0].split(",");
         QStringList typeCodes = parts[1].split(",");
 
-        // Convert type codes to gameGrid
-        int index = 0;
-        for (int i = 0; i < GRID_SIZE; ++i)
+        // Convert type codes to the board state
+        boardState.clear();
+        for (int cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell)
         {
-            for (int j = 0; j < GRID_SIZE; ++j)
-            {
-                if (index >= typeCodes.size())
-                    break;
-
-                bool ok;
-                int type = typeCodes[index].toInt(&ok);
-                gameGrid[i][j].type = static_cast<CardType>(ok ? type : NEUTRAL);
-                gameGrid[i][j].word = m_words.value(index, "");
-                gameGrid[i][j].revealed = false;
-                index++;
-            }
+            bool ok;
+            int type = typeCodes[cell].toInt(&ok);
+            if (!ok || type < RED_TEAM || type > ASSASSIN)
+                type = NEUTRAL;
+            boardState.setAgent(cell, static_cast<BoardDealer::Agent>(type));
         }
 
         setupBoard();
+        updateCardCounts();
     }
 
     // Tile Reveal Processor
@@ -675,13 +651,9 @@ void MultiBoard::processMessage(const QString &message)
 
     // Card Update Processor
 
-    else if (message.startsWith("RED")) {
-        redCardsRemaining--;
-        redCardText->setText("Red Cards Remaining: " + QString::number(redCardsRemaining));
-    }
-    else if (message.startsWith("BLUE")) {
-        blueCardsRemaining--;
-        blueCardText->setText("Blue Cards Remaining: " + QString::number(blueCardsRemaining));
+    else if (message.startsWith("RED") || message.startsWith("BLUE")) {
+        // The REVEAL before it already updated the board state
+        updateCardCounts();
     }
 }
 
@@ -817,7 +789,7 @@ void MultiBoard::handleTileClick()
     int row = index / GRID_SIZE;
     int col = index % GRID_SIZE;
     // Check if the tile has already been revealed
-    if (gameGrid[row][col].revealed)
+    if (boardState.isRevealed(row * GRID_SIZE + col))
         return;
     // Reveal the tile
     revealTile(row, col, true);
@@ -838,13 +810,21 @@ void MultiBoard::revealTile(int row, int col, bool broadcast)
     // Add the hint to the chat box
     QString currOperativeName = (m_currentTurnIndex == 1 || m_currentTurnIndex == 2) ? "Red Operative" : "Blue Operative";
     QString teamColor = (m_currentTurnIndex == 1 || m_currentTurnIndex == 2) ? "Red" : "Blue";
-    QString hintMessage = currOperativeName + " taps " + gameGrid[row][col].word;
+    QString hintMessage = currOperativeName + " taps " + m_words.value(row * GRID_SIZE + col);
     chatBox->addSystemMessage(hintMessage, (m_currentTurnIndex == RED_OP || m_currentTurnIndex == BLUE_SPY) ? ChatBox::RED_TEAM : ChatBox::BLUE_TEAM);
     }
 
-    // Setting the tile as revealed and disabling it
+    // Setting the tile as revealed, a reveal can arrive twice when it is
+    // echoed back so it is recorded once
+    bool firstReveal = boardState.reveal(row * GRID_SIZE + col);
+    if (firstReveal)
+    {
+        bool redOperative = m_currentTurnIndex == RED_OP || m_currentTurnIndex == BLUE_SPY;
+        m_matchRecord.addReveal(row * GRID_SIZE + col,
+                                redOperative ? RatingEngine::RedOperative : RatingEngine::BlueOperative);
+    }
 
-    gameGrid[row][col].revealed = true;
+    // Disabling the tile
     QPushButton *btn = m_tiles.at(row * GRID_SIZE + col);
     btn->setText("");
     btn->setEnabled(false);
@@ -869,26 +849,24 @@ void MultiBoard::revealTile(int row, int col, bool broadcast)
     }
 
     // Set card color based on type
-    switch (gameGrid[row][col].type)
+    CardType type = cardType(row, col);
+    switch (type)
     {
-        qDebug() << "Type: " << gameGrid[row][col].type;
+        qDebug() << "Type: " << type;
 
     // Set card color based on type
 
     case RED_TEAM:
 
         btn->setStyleSheet("background-color: #ff9999; color: black");
-        if (m_isHost)
+        if (m_isHost && firstReveal)
         {
-            // Decrement the number of red cards remaining
-            redCardsRemaining--;
+            // Have everyone refresh the red cards remaining
             sendToAll(QString("RED"));
-            redCardText->setText("Red Cards Remaining: " + QString::number(redCardsRemaining));
-
-
+            updateCardCounts();
 
             // Check if the red team has won
-            if (redCardsRemaining == 0)
+            if (boardState.cleared(BoardDealer::RedAgent))
             {
                 endGame("Red team wins!");
             }
@@ -897,16 +875,15 @@ void MultiBoard::revealTile(int row, int col, bool broadcast)
     case BLUE_TEAM:
         btn->setStyleSheet("background-color: #9999ff; color: black");
         
-        if (m_isHost)
+        if (m_isHost && firstReveal)
         {
-            // Decrement the number of blue cards remaining
-            blueCardsRemaining--;
+            // Have everyone refresh the blue cards remaining
             sendToAll(QString("BLUE"));
-            blueCardText->setText("Blue Cards Remaining: " + QString::number(blueCardsRemaining));
+            updateCardCounts();
             
             // Check if the blue team has won
             
-            if (blueCardsRemaining == 0)
+            if (boardState.cleared(BoardDealer::BlueAgent))
             {
                 endGame("Blue team wins!");
             }
@@ -924,8 +901,8 @@ void MultiBoard::revealTile(int row, int col, bool broadcast)
     }
     // Initial Broadcast
     if(broadcast) {
-    bool isCorrectCard = (currentTeam == "red" && gameGrid[row][col].type == RED_TEAM) ||
-                            (currentTeam == "blue" && gameGrid[row][col].type == BLUE_TEAM);
+    bool isCorrectCard = (currentTeam == "red" && type == RED_TEAM) ||
+                            (currentTeam == "blue" && type == BLUE_TEAM);
 
         if (!isCorrectCard || (maxGuesses > 0 && currentGuesses >= maxGuesses)) {
             if (!isCorrectCard) {
@@ -942,6 +919,14 @@ void MultiBoard::revealTile(int row, int col, bool broadcast)
 
 void MultiBoard::endGame(const QString &message)
 {
+    // Games that end without a winner are not recorded
+    if (message.startsWith("Red team wins") || message.startsWith("Blue team wins"))
+    {
+        bool assassin = boardState.assassinRevealed();
+        recordResult(message.startsWith("Red"),
+                     assassin ? MatchRecord::AssassinRevealed : MatchRecord::AllAgentsFound);
+    }
+
     if (!m_isHost)
     {
         // Client: Send message and transfer ownership back
@@ -118,21 +118,11 @@ void MultiMain::onConnected() {
 
 void MultiMain::onCreateRoomClicked()
 {
-    // Load usernames from the JSON file
-    User *user = User::instance();
-    QJsonObject jsonData = user->loadJsonFile();
-
-    // Get a list of usernames
-    QStringList usernames;
-    QJsonObject::const_iterator it = jsonData.constBegin();
-    while (it != jsonData.constEnd())
-    {
-        usernames.append(it.key()); // Extract username keys
-        ++it;
-    }
+    // Usernames come from the shared model, no need to read the profile
+    UsernameModel *usernames = User::instance()->store()->usernameModel();
 
     // If there are no usernames, show a message and return
-    if (usernames.isEmpty())
+    if (usernames->rowCount() == 0)
     {
         QMessageBox::warning(this, "No Users", "No user profiles found. Please create an account first.");
         return;
@@ -158,8 +148,8 @@ void MultiMain::onCreateRoomClicked()
     buttonLayout.addWidget(&cancelButton);
     layout.addLayout(&buttonLayout);
 
-    // Populate the combo box with usernames
-    comboBox.addItems(usernames);
+    // Show the usernames in the combo box
+    comboBox.setModel(usernames);
 
     // Connect buttons to dialog actions
     connect(&okButton, &QPushButton::clicked, &dialog, &QDialog::accept);
@@ -219,20 +209,11 @@ void MultiMain::onJoinRoomClicked()
     if (!ok)
         return;
 
-    // Load usernames from the JSON file
-    User *user = User::instance();
-    QJsonObject jsonData = user->loadJsonFile();
-
-    QStringList usernames;
-    QJsonObject::const_iterator it = jsonData.constBegin();
-    while (it != jsonData.constEnd())
-    {
-        usernames.append(it.key()); // Extract username keys
-        ++it;
-    }
+    // Usernames come from the shared model, no need to read the profile
+    UsernameModel *usernames = User::instance()->store()->usernameModel();
 
     // If there are no usernames, show a message and return
-    if (usernames.isEmpty())
+    if (usernames->rowCount() == 0)
     {
         QMessageBox::warning(this, "No Users", "No user profiles found. Please create an account first.");
         return;
@@ -256,8 +237,8 @@ void MultiMain::onJoinRoomClicked()
     buttonLayout.addWidget(&cancelButton);
     layout.addLayout(&buttonLayout);
 
-    // Populate the combo box with usernames
-    comboBox.addItems(usernames);
+    // Show the usernames in the combo box
+    comboBox.setModel(usernames);
 
     // Connect buttons to dialog actions
     connect(&okButton, &QPushButton::clicked, &dialog, &QDialog::accept);
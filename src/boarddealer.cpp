@@ -0,0 +1,138 @@
+/**
+ * @file boarddealer.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Deals the words and key card of a new board
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "boarddealer.h"
+
+#include <QDebug>
+#include <QRandomGenerator>
+#include <utility>
+
+namespace {
+
+// Every key card before the shuffle: the red, blue, bystander and assassin
+// counts of the Codenames rules
+struct KeyCardLayout {
+  quint8 agents[BoardDealer::Cells];
+
+  constexpr KeyCardLayout() : agents() {
+    int cell = 0;
+    for (int i = 0; i < BoardDealer::RedAgents; i++) {
+      agents[cell++] = BoardDealer::RedAgent;
+    }
+    for (int i = 0; i < BoardDealer::BlueAgents; i++) {
+      agents[cell++] = BoardDealer::BlueAgent;
+    }
+    for (int i = 0; i < BoardDealer::Bystanders; i++) {
+      agents[cell++] = BoardDealer::Bystander;
+    }
+    agents[cell] = BoardDealer::Assassin;
+  }
+};
+
+constexpr KeyCardLayout keyCardLayout;
+
+static_assert(BoardDealer::RedAgents + BoardDealer::BlueAgents +
+                      BoardDealer::Bystanders + 1 ==
+                  BoardDealer::Cells,
+              "Every card needs exactly one agent");
+
+// Crockford base32, no I, L, O or U so a code reads back unambiguously
+const char CodeAlphabet[] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+const int CodeLength = 8;
+
+// The byte of the word list a code carries, so a code is not silently
+// dealt from another list
+quint8 wordListTag() {
+  quint32 fingerprint = WordPool::instance().fingerprint();
+  return quint8(fingerprint ^ (fingerprint >> 8) ^ (fingerprint >> 16) ^
+                (fingerprint >> 24));
+}
+
+// Position of a code character in the alphabet, -1 if it is not one
+int codeDigit(QChar c) {
+  QChar upper = c.toUpper();
+  if (upper == QChar('O')) {
+    return 0;
+  }
+  if (upper == QChar('I') || upper == QChar('L')) {
+    return 1;
+  }
+  for (int digit = 0; digit < 32; digit++) {
+    if (upper == QChar(CodeAlphabet[digit])) {
+      return digit;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+bool BoardDealer::deal(Board& board) {
+  return deal(board, QRandomGenerator::global()->generate());
+}
+
+bool BoardDealer::deal(Board& board, quint32 seed) {
+  // Words first, then the key card, the order is part of what a seed means
+  BoardRandom rng(seed);
+  board.seed = seed;
+  if (!WordPool::instance().sample(board.words, Cells, rng)) {
+    return false;
+  }
+  dealKeyCard(board.keyCard, rng);
+  return true;
+}
+
+void BoardDealer::dealKeyCard(quint8 (&keyCard)[Cells], BoardRandom& rng) {
+  for (int i = 0; i < Cells; i++) {
+    keyCard[i] = keyCardLayout.agents[i];
+  }
+  for (int i = Cells - 1; i > 0; --i) {
+    std::swap(keyCard[i], keyCard[rng.bounded(quint32(i + 1))]);
+  }
+}
+
+QString BoardDealer::boardCode(quint32 seed) {
+  // 40 bits: the seed, then the word list tag
+  quint64 bits = (quint64(seed) << 8) | wordListTag();
+  QString code;
+  for (int i = CodeLength - 1; i >= 0; --i) {
+    code += QChar(CodeAlphabet[(bits >> (5 * i)) & 31]);
+    if (i == CodeLength / 2) {
+      code += QChar('-');
+    }
+  }
+  return code;
+}
+
+bool BoardDealer::seedFromCode(const QString& code, quint32* seed) {
+  quint64 bits = 0;
+  int digits = 0;
+  for (QChar c : code) {
+    if (c == QChar('-') || c.isSpace()) {
+      continue;
+    }
+    int digit = codeDigit(c);
+    if (digit < 0 || ++digits > CodeLength) {
+      qDebug() << "Malformed board code" << code;
+      return false;
+    }
+    bits = (bits << 5) | quint64(digit);
+  }
+  if (digits != CodeLength) {
+    qDebug() << "Malformed board code" << code;
+    return false;
+  }
+  if (quint8(bits) != wordListTag()) {
+    qDebug() << "Board code" << code << "was made with another word list";
+    return false;
+  }
+  *seed = quint32(bits >> 8);
+  return true;
+}
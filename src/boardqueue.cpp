@@ -0,0 +1,74 @@
+/**
+ * @file boardqueue.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Boards dealt ahead of time on a worker thread
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "boardqueue.h"
+
+#include <QDebug>
+#include <QtConcurrent>
+
+BoardQueue::BoardQueue(int depth, QObject* parent)
+    : QObject(parent), depth(depth), refilling(false) {
+  dealWatcher = new QFutureWatcher<QVector<BoardDealer::Board>>(this);
+  connect(dealWatcher, &QFutureWatcher<QVector<BoardDealer::Board>>::finished,
+          this, &BoardQueue::onBoardsDealt);
+  refill();
+}
+
+BoardQueue::~BoardQueue() { dealWatcher->waitForFinished(); }
+
+bool BoardQueue::take(BoardDealer::Board& board) {
+  bool ready = !boards.isEmpty();
+  if (ready) {
+    board = boards.dequeue();
+  }
+  refill();
+  return ready;
+}
+
+int BoardQueue::size() const { return boards.size(); }
+
+void BoardQueue::onBoardsDealt() {
+  refilling = false;
+  const QVector<BoardDealer::Board> dealt = dealWatcher->result();
+  for (const BoardDealer::Board& board : dealt) {
+    if (boards.size() < depth) {
+      boards.enqueue(board);
+    }
+  }
+
+  // Boards taken while this batch was dealt left room for more, but a pool
+  // too small to deal from must not be retried forever
+  if (!dealt.isEmpty()) {
+    refill();
+  }
+}
+
+void BoardQueue::refill() {
+  int missing = depth - boards.size();
+  if (missing <= 0 || refilling) {
+    return;
+  }
+
+  // WordPool and the global generator are safe to use from any thread
+  refilling = true;
+  dealWatcher->setFuture(QtConcurrent::run([missing]() {
+    QVector<BoardDealer::Board> dealt;
+    dealt.reserve(missing);
+    BoardDealer::Board board;
+    for (int i = 0; i < missing; i++) {
+      if (!BoardDealer::deal(board)) {
+        qDebug() << "Not enough words to deal boards ahead";
+        break;
+      }
+      dealt.append(board);
+    }
+    return dealt;
+  }));
+}
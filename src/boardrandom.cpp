@@ -0,0 +1,45 @@
+/**
+ * @file boardrandom.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief The random number generator boards are dealt with
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "boardrandom.h"
+
+namespace {
+
+// The constants of the reference pcg32, the stream is that of its examples
+const quint64 Multiplier = 6364136223846793005ULL;
+const quint64 Increment = (54ULL << 1) | 1;
+
+}  // namespace
+
+BoardRandom::BoardRandom(quint32 seed) : state(0) {
+  // pcg32_srandom: step, add the seed, step again
+  generate();
+  state += seed;
+  generate();
+}
+
+quint32 BoardRandom::generate() {
+  quint64 old = state;
+  state = old * Multiplier + Increment;
+  quint32 xorShifted = quint32(((old >> 18) ^ old) >> 27);
+  quint32 rotation = quint32(old >> 59);
+  return (xorShifted >> rotation) | (xorShifted << ((32 - rotation) & 31));
+}
+
+quint32 BoardRandom::bounded(quint32 bound) {
+  // Drop the values below 2^32 mod bound, the rest split evenly
+  quint32 threshold = (0u - bound) % bound;
+  for (;;) {
+    quint32 value = generate();
+    if (value >= threshold) {
+      return value % bound;
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/**
+ * @file boardstate.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief The key card and reveals of a board as bit masks
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "boardstate.h"
+
+static_assert(BoardState::Cells <= 32, "A board must fit in one mask");
+
+BoardState::BoardState() { clear(); }
+
+BoardState::BoardState(const BoardDealer::Board& board) {
+  clear();
+  for (int cell = 0; cell < Cells; cell++) {
+    masks[board.keyCard[cell]] |= bit(cell);
+  }
+}
+
+void BoardState::clear() {
+  for (quint32& mask : masks) {
+    mask = 0;
+  }
+  revealedMask = 0;
+}
+
+void BoardState::setAgent(int cell, BoardDealer::Agent agent) {
+  for (quint32& mask : masks) {
+    mask &= ~bit(cell);
+  }
+  masks[agent] |= bit(cell);
+}
+
+BoardDealer::Agent BoardState::agentAt(int cell) const {
+  if (masks[BoardDealer::RedAgent] & bit(cell)) {
+    return BoardDealer::RedAgent;
+  }
+  if (masks[BoardDealer::BlueAgent] & bit(cell)) {
+    return BoardDealer::BlueAgent;
+  }
+  if (masks[BoardDealer::Assassin] & bit(cell)) {
+    return BoardDealer::Assassin;
+  }
+  return BoardDealer::Bystander;
+}
+
+bool BoardState::reveal(int cell) {
+  if (revealedMask & bit(cell)) {
+    return false;
+  }
+  revealedMask |= bit(cell);
+  return true;
+}
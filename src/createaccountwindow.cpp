@@ -12,6 +12,8 @@
 
 #include "createaccountwindow.h"
 
+#include "user.h"
+
 CreateAccountWindow* CreateAccountWindow::instance = nullptr;
 
 CreateAccountWindow* CreateAccountWindow::getInstance(QWidget* parent) {
@@ -105,74 +107,20 @@ void CreateAccountWindow::onCreateAccountClicked() {
   if (username.isEmpty()) {
     statusLabel->setText("Please enter a username.");
   } else {
-    // For now, just show that the account is created
-    statusLabel->setText("Account Created.");
-    saveJsonFile(username);
-    emit accountCreated();
-  }
-}
-
-// Save JSON data
-void CreateAccountWindow::saveJsonFile(const QString& username) {
-  QFile file(jsonFilePath);
-  QDir dir = QFileInfo(file).absoluteDir();
-  QString absolutePath = dir.filePath(file.fileName());
-
-  QJsonObject jsonObject;
-
-  // Read existing JSON data (if any)
-  if (file.exists()) {
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-      qDebug() << "Failed to open" << absolutePath << " for reading.";
-      statusLabel->setText("Error: Could not read profile.json");
-      return;
-    }
-
-    QByteArray jsonData = file.readAll();
-    file.close();
-
-    QJsonDocument doc = QJsonDocument::fromJson(jsonData);
-    if (doc.isObject()) {
-      jsonObject = doc.object();  // Load existing data
-    }
-  }
-
-  // Check if user exists and preserve statistics
-  QJsonObject userObject;
-  QJsonObject statistics;
-
-  if (jsonObject.contains(username)) {
-    statusLabel->setText("Account " + username + " already exists");
-    userObject = jsonObject[username].toObject();
-    if (userObject.contains("statistics")) {
-      statistics =
-          userObject["statistics"].toObject();  // Preserve existing statistics
+    // The store writes the account and updates every username dropdown
+    ProfileStore* store = User::instance()->store();
+    switch (store->createAccount(username)) {
+      case ProfileStore::AccountCreated:
+        statusLabel->setText("Account Created.");
+        emit accountCreated(username);
+        break;
+      case ProfileStore::AccountExists:
+        statusLabel->setText("Account " + username + " already exists");
+        emit accountCreated(username);
+        break;
+      case ProfileStore::AccountFailed:
+        statusLabel->setText(store->lastError());
+        break;
     }
   }
-
-  // Initialize statistics if they don't exist
-  if (statistics.isEmpty()) {
-    statistics["games_played"] = 0;
-    statistics["games_win"] = 0;
-    statistics["guess_total"] = 0;
-    statistics["guess_hit"] = 0;
-  }
-
-  // Update user object
-  userObject["user_name"] = username;
-  userObject["statistics"] = statistics;
-
-  // Store the updated user object in the main JSON
-  jsonObject[username] = userObject;
-
-  // Write updated JSON data
-  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-    qDebug() << "Failed to write to" << absolutePath;
-    statusLabel->setText("Error: Could not write to profile.json");
-    return;
-  }
-
-  QJsonDocument newDoc(jsonObject);
-  file.write(newDoc.toJson());
-  file.close();
 }
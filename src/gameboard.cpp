@@ -9,8 +9,7 @@ GameBoard::GameBoard(const QString& redSpyMaster, const QString& redOperative,
       blueSpyMasterName(blueSpyMaster),
       blueOperativeName(blueOperative), 
       
-      redCardsRemaining(0),
-      blueCardsRemaining(0),
+      wordIds(),
       maxGuesses(0),
       currentGuesses(0)
 {
@@ -18,15 +17,20 @@ GameBoard::GameBoard(const QString& redSpyMaster, const QString& redOperative,
     // Set the window title and fixed size
     setWindowTitle("Codenames - Game Board");
     setFixedSize(1200, 800);
+
+    // Keep the next boards dealt in the background, so Start only binds one
+    boardQueue = new BoardQueue(3, this);
     
-    // Load words from the file and generate the game grid
-    loadWordsFromFile();
+    // Deal the words from the shared pool and generate the game grid
     generateGameGrid();
     setupUI();
 }
 
 // Destructor for the GameBoard class
-GameBoard::~GameBoard() {}
+GameBoard::~GameBoard() {
+    // Keep the guesses of an unfinished game
+    statsSession.commit();
+}
 
 void GameBoard::show() {
     // 
@@ -51,6 +55,11 @@ void GameBoard::setBlueOperativeName(const QString& name) {
     blueOperativeName = name;
 }
 
+void GameBoard::setNextSeed(quint32 seed) {
+    nextSeed = seed;
+    hasNextSeed = true;
+}
+
 void GameBoard::updateTeamLabels() {
  redTeamLabel->setText(
     "<b>Red Team</b><br>"
@@ -66,77 +75,38 @@ blueTeamLabel->setText(
 
 }
 
-void GameBoard::loadWordsFromFile() {
-    // Load words from file
-    QFile file(":/resources/wordlist-eng.txt");
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "failed to open wordlist-eng.text file, using fallback";
-        // Fallback word list if file not found
-        wordList = QStringList() << "apple" << "banana" << "cat" << "dog" << "elephant"
-                                << "fish" << "goat" << "horse" << "iguana" << "jelly"
-                                << "kangaroo" << "lion" << "monkey" << "nest" << "owl"
-                                << "penguin" << "queen" << "rabbit" << "snake" << "tiger"
-                                << "umbrella" << "violin" << "whale" << "xray" << "zebra";
-        return;
-    }
-
-    // Read words from file
-    QTextStream in(&file);
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (!line.isEmpty()) {
-            wordList.append(line);
-        }
-    }
-    file.close();
-}
-
 void GameBoard::generateGameGrid() {
-    // Ensure we have enough words
-    if (wordList.size() < 25) {
-        qDebug() << "Not enough words to generate a game grid" << wordList.size();
+    // Words and key card land in fixed arrays, nothing is allocated
+    // A board code given in PreGame applies to this board only, otherwise
+    // take one dealt ahead and deal here only if none is ready yet
+    BoardDealer::Board board;
+    bool dealt = hasNextSeed ? BoardDealer::deal(board, nextSeed)
+                             : boardQueue->take(board) || BoardDealer::deal(board);
+    hasNextSeed = false;
+    if (!dealt) {
+        qDebug() << "Not enough words to generate a game grid"
+                 << WordPool::instance().size();
         return;
     }
 
-    // Shuffle words
-    for (int i = wordList.size() - 1; i > 0; --i) {
-        int j = QRandomGenerator::global()->bounded(i + 1);
-        wordList.swapItemsAt(i, j);
-    }
+    // Show the code of the board so it can be shared or replayed
+    QString code = BoardDealer::boardCode(board.seed);
+    setWindowTitle("Codenames - Game Board " + code);
+    qDebug() << "Dealt board" << code;
 
-    // Assign card types (Codenames rules: 9 for starting team, 8 for other team, 1 assassin, 7 neutral)
-    int redCards = 9;
-    int blueCards = 8;
-    int assassinCards = 1;
-    int neutralCards = 7;
-
-    // Set remaining card counts
-    redCardsRemaining = redCards;
-    blueCardsRemaining = blueCards;
-
-    // Assign card types
-    QList<CardType> cardTypes;
-    for (int i = 0; i < redCards; ++i) cardTypes.append(RED_TEAM);
-    for (int i = 0; i < blueCards; ++i) cardTypes.append(BLUE_TEAM);
-    for (int i = 0; i < neutralCards; ++i) cardTypes.append(NEUTRAL);
-    for (int i = 0; i < assassinCards; ++i) cardTypes.append(ASSASSIN);
-
-    // Shuffle card types
-    for (int i = cardTypes.size() - 1; i > 0; --i) {
-        int j = QRandomGenerator::global()->bounded(i + 1);
-        cardTypes.swapItemsAt(i, j);
+    // The key card becomes one mask per agent, the words stay ids
+    boardState = BoardState(board);
+    for (int cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell) {
+        wordIds[cell] = board.words[cell];
     }
+}
 
-    // Fill the grid
-    int wordIndex = 0;
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            gameGrid[i][j].word = wordList[wordIndex];
-            gameGrid[i][j].type = cardTypes[wordIndex];
-            gameGrid[i][j].revealed = false;
-            ++wordIndex;
-        }
-    }
+const QString& GameBoard::cardWord(int row, int col) const {
+    return WordPool::instance().at(wordIds[row * GRID_SIZE + col]);
+}
+
+GameBoard::CardType GameBoard::cardType(int row, int col) const {
+    return CardType(boardState.agentAt(row * GRID_SIZE + col));
 }
 
 void GameBoard::setupUI() {
@@ -165,10 +135,10 @@ void GameBoard::setupUI() {
     blueTeamLabel->setStyleSheet("color: #9999ff;  font-size: 16px;");
     currentTurnLabel->setStyleSheet("color: white;  font-size: 20px; font-weight: bold;");
         
-    redScoreLabel = new QLabel("Red Cards Remaining: " + QString::number(redCardsRemaining));
+    redScoreLabel = new QLabel("Red Cards Remaining: " + QString::number(boardState.remaining(BoardDealer::RedAgent)));
     redScoreLabel->setStyleSheet("color: #ff9999; font-weight: bold; font-size: 16px;");
 
-    blueScoreLabel = new QLabel("Blue Cards remaining: " + QString::number(blueCardsRemaining));
+    blueScoreLabel = new QLabel("Blue Cards remaining: " + QString::number(boardState.remaining(BoardDealer::BlueAgent)));
     blueScoreLabel->setStyleSheet("color: #9999ff; font-weight: bold; font-size: 16px;");
 
 
@@ -200,12 +170,12 @@ void GameBoard::setupUI() {
     // Create cards and add them to the grid
     for (int i = 0; i < GRID_SIZE; ++i) {
         for (int j = 0; j < GRID_SIZE; ++j) {
-            cards[i][j] = new QPushButton(gameGrid[i][j].word);
+            cards[i][j] = new QPushButton(cardWord(i, j));
             cards[i][j]->setFixedSize(120, 80);
             gridLayout->addWidget(cards[i][j], i, j);
 
             // Set card styles
-            switch (gameGrid[i][j].type) {
+            switch (cardType(i, j)) {
                 case RED_TEAM:
                     cards[i][j]->setStyleSheet("background-color: #ff9999; color: black");
                     break;
@@ -271,75 +241,87 @@ void GameBoard::displayGuess() {
 }
 
 void GameBoard::onCardClicked(int row, int col) {
-    if (gameGrid[row][col].revealed) {
+    // Mark the card as revealed, unless it already was
+    if (!boardState.reveal(row * GRID_SIZE + col)) {
         return;
     }
     // Increment the guess count for this turn
     currentGuesses++;
 
-    // Mark the card as revealed and disable it
-    gameGrid[row][col].revealed = true;
+    // Disable the revealed card
     cards[row][col]->setText("");  // Clear the text to show the card is revealed
     cards[row][col]->setEnabled(false);
-
-    users = User::instance();
+    matchRecord.addReveal(row * GRID_SIZE + col, currentTurn);
+
+    // Counted against the clue being played, for both roles
+    CardType ownTeam = (currentTurn == RED_OP) ? RED_TEAM : BLUE_TEAM;
+    CardType type = cardType(row, col);
+    if (type == ASSASSIN) {
+        statsSession.reveal(StatsSession::Assassin);
+    } else if (type == NEUTRAL) {
+        statsSession.reveal(StatsSession::Bystander);
+    } else if (type == ownTeam) {
+        statsSession.reveal(StatsSession::OwnAgent);
+    } else {
+        statsSession.reveal(StatsSession::OpponentAgent);
+    }
 
     // Always reveal the card's true color, regardless of whether it's correct
-    switch (gameGrid[row][col].type) {
+    switch (type) {
         case RED_TEAM:
             if (currentTurn == RED_OP) {
-                users->hit(redOperativeName);
+                statsSession.hit(redOperativeName);
             } else if (currentTurn == BLUE_OP) {
-                users->miss(blueOperativeName);
+                statsSession.miss(blueOperativeName);
             }
             cards[row][col]->setStyleSheet("background-color: #ff9999; color: black");
             break;
         case BLUE_TEAM:
             if (currentTurn == BLUE_OP) {
-                users->hit(blueOperativeName);
+                statsSession.hit(blueOperativeName);
             } else if (currentTurn == RED_OP) {
-                users->miss(redOperativeName);
+                statsSession.miss(redOperativeName);
             }
             cards[row][col]->setStyleSheet("background-color: #9999ff; color: black");
             break;
         case NEUTRAL:
             if (currentTurn == RED_OP) {
-                users->miss(redOperativeName);
+                statsSession.miss(redOperativeName);
             } else if (currentTurn == BLUE_OP) {
-                users->miss(blueOperativeName);
+                statsSession.miss(blueOperativeName);
             }
             cards[row][col]->setStyleSheet("background-color: #f0f0f0; color: black");
             break;
         case ASSASSIN:
             if (currentTurn == RED_OP) {
-                users->miss(redOperativeName);
+                statsSession.miss(redOperativeName);
             } else if (currentTurn == BLUE_OP) {
-                users->miss(blueOperativeName);
+                statsSession.miss(blueOperativeName);
             }
             cards[row][col]->setStyleSheet("background-color: #333333; color: white");
             break;
     }
 
-    // Update scores 
-    if (gameGrid[row][col].type == RED_TEAM) {
-        redCardsRemaining--;
+    // Update scores, the counts follow from the revealed mask
+    if (type == RED_TEAM) {
         updateScores();
-        qDebug() << "Red team card selected. Red cards remaining:" << redCardsRemaining;
+        qDebug() << "Red team card selected. Red cards remaining:"
+                 << boardState.remaining(BoardDealer::RedAgent);
     } 
-    else if (gameGrid[row][col].type == BLUE_TEAM) {
-        blueCardsRemaining--;
+    else if (type == BLUE_TEAM) {
         updateScores();
-        qDebug() << "Blue team card selected. Blue cards remaining:" << blueCardsRemaining;
+        qDebug() << "Blue team card selected. Blue cards remaining:"
+                 << boardState.remaining(BoardDealer::BlueAgent);
     }
 
     // Add the guess to the chat box
     QString currOperativeName = (currentTurn == RED_OP) ? redOperativeName : blueOperativeName;
     QString teamColor = (currentTurn == RED_OP) ? "Red" : "Blue";
-    QString hintMessage = currOperativeName + " taps " + gameGrid[row][col].word;
+    QString hintMessage = currOperativeName + " taps " + cardWord(row, col);
     chatBox->addSystemMessage(hintMessage, (currentTurn == RED_OP) ? ChatBox::RED_TEAM : ChatBox::BLUE_TEAM);
 
-    bool correctCard = (currentTurn == RED_OP && gameGrid[row][col].type == RED_TEAM) || 
-                       (currentTurn == BLUE_OP && gameGrid[row][col].type == BLUE_TEAM);
+    bool correctCard = (currentTurn == RED_OP && type == RED_TEAM) || 
+                       (currentTurn == BLUE_OP && type == BLUE_TEAM);
 
     checkGameEnd();
 
@@ -366,7 +348,7 @@ void GameBoard::onCardClicked(int row, int col) {
     // Show the transition widget
     if (!correctCard) {
         qDebug() << "Wrong card selected by" << (currentTurn == RED_OP ? "Red team" : "Blue team")
-                 << "- Card type:" << gameGrid[row][col].type;
+                 << "- Card type:" << type;
         for (int i = 0; i < GRID_SIZE; ++i) {
             for (int j = 0; j < GRID_SIZE; ++j) {
                 cards[i][j]->setEnabled(false);
@@ -398,6 +380,9 @@ void GameBoard::displayHint(const QString& hint, int number) {
     QString chatNumber = (number == 0) ? "∞" : QString::number(number);
     QString hintMessage = currSpymasterName + " gives clue " + hint + " " + chatNumber;
     chatBox->addSystemMessage(hintMessage, (currentTurn == RED_SPY) ? ChatBox::RED_TEAM : ChatBox::BLUE_TEAM);
+    matchRecord.addClue(currentTurn, hint, number);
+    statsSession.clue(currSpymasterName,
+                      (currentTurn == RED_SPY) ? redOperativeName : blueOperativeName, number);
 
     nextTurn();
 }
@@ -413,7 +398,7 @@ void GameBoard::nextTurn() {
         
         for (int i = 0; i < GRID_SIZE; ++i) {
             for (int j = 0; j < GRID_SIZE; ++j) {
-                if (!gameGrid[i][j].revealed) {
+                if (!boardState.isRevealed(i * GRID_SIZE + j)) {
                     cards[i][j]->setEnabled(true);
                     cards[i][j]->setStyleSheet("background-color: #f0f0f0; color: black");
                 } 
@@ -435,7 +420,7 @@ void GameBoard::nextTurn() {
         for (int i = 0; i < GRID_SIZE; ++i) {
             for (int j = 0; j < GRID_SIZE; ++j) {
                 cards[i][j]->setEnabled(false);
-                switch (gameGrid[i][j].type) {
+                switch (cardType(i, j)) {
                     case RED_TEAM:
                         cards[i][j]->setStyleSheet("background-color: #ff9999; color: black");
                         break;
@@ -485,7 +470,7 @@ void GameBoard::onContinueClicked() {
         for (int i = 0; i < GRID_SIZE; ++i) {
             for (int j = 0; j < GRID_SIZE; ++j) {
                 cards[i][j]->setEnabled(false);
-                switch (gameGrid[i][j].type) {
+                switch (cardType(i, j)) {
                     case RED_TEAM:
                         cards[i][j]->setStyleSheet("background-color: #ff9999; color: black");
                         break;
@@ -538,7 +523,7 @@ void GameBoard::showTransition() {
     for (int i = 0; i < GRID_SIZE; ++i) {
         for (int j = 0; j < GRID_SIZE; ++j) {
             cards[i][j]->setEnabled(false);
-            if(gameGrid[i][j].revealed == false) {
+            if(!boardState.isRevealed(i * GRID_SIZE + j)) {
                 cards[i][j]->setStyleSheet("background-color: #f0f0f0; color: black");
             }
         }
@@ -555,61 +540,74 @@ void GameBoard::showTransition() {
 }
 
 void GameBoard::updateScores() {
-    redScoreLabel->setText("Red Cards Remaining: " + QString::number(redCardsRemaining));
-    blueScoreLabel->setText("Blue Cards Remaining: " + QString::number(blueCardsRemaining));
+    redScoreLabel->setText("Red Cards Remaining: " + QString::number(boardState.remaining(BoardDealer::RedAgent)));
+    blueScoreLabel->setText("Blue Cards Remaining: " + QString::number(boardState.remaining(BoardDealer::BlueAgent)));
 }
 
 void GameBoard::checkGameEnd() {
-    // Check if the game has ended
-    users = User::instance();
-
+    // Check if the game has ended, results are committed by endGame
     // Red team wins
-    if (redCardsRemaining == 0) {
-        users->won(redSpyMasterName);
-        users->won(redOperativeName);
-        users->lost(blueSpyMasterName);
-        users->lost(blueOperativeName);
+    if (boardState.cleared(BoardDealer::RedAgent)) {
+        statsSession.won(redSpyMasterName);
+        statsSession.won(redOperativeName);
+        statsSession.lost(blueSpyMasterName);
+        statsSession.lost(blueOperativeName);
+        recordResult(true, MatchRecord::AllAgentsFound);
         endGame("Red Team Wins!");
 
         return;
     }
     // Blue team wins
-    if (blueCardsRemaining == 0) {
-        users->won(blueSpyMasterName);
-        users->won(blueOperativeName);
-        users->lost(redSpyMasterName);
-        users->lost(redOperativeName);
+    if (boardState.cleared(BoardDealer::BlueAgent)) {
+        statsSession.won(blueSpyMasterName);
+        statsSession.won(blueOperativeName);
+        statsSession.lost(redSpyMasterName);
+        statsSession.lost(redOperativeName);
+        recordResult(false, MatchRecord::AllAgentsFound);
         endGame("Blue Team Wins!");
         
         return;
     }
 
     // Check if the assassin card has been revealed
-    for (int i = 0; i < GRID_SIZE; ++i) {
-        for (int j = 0; j < GRID_SIZE; ++j) {
-            if (gameGrid[i][j].revealed && gameGrid[i][j].type == ASSASSIN) {
-                if (currentTurn == RED_OP) {
-                    users->won(blueSpyMasterName);
-                    users->won(blueOperativeName);
-                    users->lost(redSpyMasterName);
-                    users->lost(redOperativeName);
-
-                    endGame("Blue Team Wins! Red Team hit the Assassin card.");
-                } else if (currentTurn == BLUE_OP) {
-                    users->won(redSpyMasterName);
-                    users->won(redOperativeName);
-                    users->lost(blueSpyMasterName);
-                    users->lost(blueOperativeName);
-
-                    endGame("Red Team Wins! Blue Team hit the Assassin card.");
-                }
-                return;
-            }
+    if (boardState.assassinRevealed()) {
+        if (currentTurn == RED_OP) {
+            statsSession.won(blueSpyMasterName);
+            statsSession.won(blueOperativeName);
+            statsSession.lost(redSpyMasterName);
+            statsSession.lost(redOperativeName);
+            recordResult(false, MatchRecord::AssassinRevealed);
+
+            endGame("Blue Team Wins! Red Team hit the Assassin card.");
+        } else if (currentTurn == BLUE_OP) {
+            statsSession.won(redSpyMasterName);
+            statsSession.won(redOperativeName);
+            statsSession.lost(blueSpyMasterName);
+            statsSession.lost(blueOperativeName);
+            recordResult(true, MatchRecord::AssassinRevealed);
+
+            endGame("Red Team Wins! Blue Team hit the Assassin card.");
         }
     }
 }
 
+void GameBoard::recordResult(bool redWon, MatchRecord::EndReason reason) {
+    matchRecord.redWon = redWon;
+    matchRecord.endReason = reason;
+    matchRecord.endedAt = QDateTime::currentMSecsSinceEpoch();
+    User::instance()->store()->rateMatch(matchRecord.result());
+}
+
 void GameBoard::endGame(const QString& message) {
+    // Write every statistic of this game in a single profile update
+    statsSession.commit();
+
+    // One append to the match history
+    if (matchRecord.endedAt != 0) {
+        User::instance()->store()->recordMatch(matchRecord);
+        matchRecord.endedAt = 0;
+    }
+
     // Disable all elements
     for (int i = 0; i < GRID_SIZE; ++i) {
         for (int j = 0; j < GRID_SIZE; ++j) {
@@ -635,17 +633,18 @@ void GameBoard::endGame(const QString& message) {
 }
 
 void GameBoard::resetGame() {
+    // Keep the guesses of a game that was closed before it finished
+    statsSession.commit();
 
-    // Load words from file
-    loadWordsFromFile();
+    // Deal a new board, the word pool is loaded once per process
     generateGameGrid();
 
     // Reset the UI elements
     for (int i = 0; i < GRID_SIZE; ++i) {
         for (int j = 0; j < GRID_SIZE; ++j) {
-            cards[i][j]->setText(gameGrid[i][j].word);
+            cards[i][j]->setText(cardWord(i, j));
             cards[i][j]->setEnabled(false);
-            switch (gameGrid[i][j].type) {
+            switch (cardType(i, j)) {
                 case RED_TEAM:
                     cards[i][j]->setStyleSheet("background-color: #ff9999; color: black");
                     break;
@@ -662,17 +661,21 @@ void GameBoard::resetGame() {
         }
     }
 
-    // Reset scores
-    redCardsRemaining = 0;
-    blueCardsRemaining = 0;
+    // Reset scores, nothing is revealed on the new board
+    updateScores();
 
+    // Start recording the new board, words and key card row by row
+    matchRecord.start();
+    matchRecord.players[RatingEngine::RedSpymaster] = redSpyMasterName;
+    matchRecord.players[RatingEngine::RedOperative] = redOperativeName;
+    matchRecord.players[RatingEngine::BlueSpymaster] = blueSpyMasterName;
+    matchRecord.players[RatingEngine::BlueOperative] = blueOperativeName;
     for (int i = 0; i < GRID_SIZE; ++i) {
         for (int j = 0; j < GRID_SIZE; ++j) {
-            if (gameGrid[i][j].type == RED_TEAM) redCardsRemaining++;
-            if (gameGrid[i][j].type == BLUE_TEAM) blueCardsRemaining++;
+            matchRecord.words[i * GRID_SIZE + j] = cardWord(i, j);
+            matchRecord.keyCard[i * GRID_SIZE + j] = quint8(cardType(i, j));
         }
     }
-    updateScores();
 
     // Reset turn and labels
     currentTurn = RED_SPY;
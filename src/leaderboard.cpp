@@ -0,0 +1,250 @@
+/**
+ * @file leaderboard.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Ranked indexes of the users by wins, win rate and hit rate
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "leaderboard.h"
+
+bool RankIndex::before(double score, const QString& username,
+                       const Node& node) {
+  if (score != node.score) {
+    return score > node.score;  // Higher scores rank first
+  }
+  return username < node.username;
+}
+
+int RankIndex::sizeOf(int node) const {
+  return node < 0 ? 0 : nodes[node].size;
+}
+
+void RankIndex::update(int node) {
+  nodes[node].size = 1 + sizeOf(nodes[node].left) + sizeOf(nodes[node].right);
+}
+
+quint32 RankIndex::nextPriority() {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+int RankIndex::merge(int left, int right) {
+  if (left < 0) {
+    return right;
+  }
+  if (right < 0) {
+    return left;
+  }
+
+  if (nodes[left].priority > nodes[right].priority) {
+    nodes[left].right = merge(nodes[left].right, right);
+    update(left);
+    return left;
+  }
+  nodes[right].left = merge(left, nodes[right].left);
+  update(right);
+  return right;
+}
+
+void RankIndex::split(int node, double score, const QString& username,
+                      int& left, int& right) {
+  if (node < 0) {
+    left = right = -1;
+    return;
+  }
+
+  if (before(score, username, nodes[node])) {
+    // The node and its right subtree rank after the key
+    split(nodes[node].left, score, username, left, nodes[node].left);
+    right = node;
+  } else {
+    split(nodes[node].right, score, username, nodes[node].right, right);
+    left = node;
+  }
+  update(node);
+}
+
+void RankIndex::insert(double score, const QString& username) {
+  int node;
+  if (!freeNodes.empty()) {
+    node = freeNodes.back();
+    freeNodes.pop_back();
+  } else {
+    node = int(nodes.size());
+    nodes.push_back(Node());
+  }
+  nodes[node] = Node{score, username, nextPriority(), -1, -1, 1};
+
+  int left, right;
+  split(root, score, username, left, right);
+  root = merge(merge(left, node), right);
+}
+
+int RankIndex::eraseFrom(int node, double score, const QString& username) {
+  if (node < 0) {
+    return -1;  // Not in the index
+  }
+
+  Node& current = nodes[node];
+  if (current.score == score && current.username == username) {
+    int joined = merge(current.left, current.right);
+    nodes[node].username.clear();
+    freeNodes.push_back(node);
+    return joined;
+  }
+
+  if (before(score, username, current)) {
+    int left = eraseFrom(current.left, score, username);
+    nodes[node].left = left;
+  } else {
+    int right = eraseFrom(current.right, score, username);
+    nodes[node].right = right;
+  }
+  update(node);
+  return node;
+}
+
+void RankIndex::erase(double score, const QString& username) {
+  root = eraseFrom(root, score, username);
+}
+
+int RankIndex::position(double score, const QString& username) const {
+  int position = 0;
+  int node = root;
+  while (node >= 0) {
+    const Node& current = nodes[node];
+    if (current.score == score && current.username == username) {
+      return position + sizeOf(current.left);
+    }
+    if (before(score, username, current)) {
+      node = current.left;
+    } else {
+      position += sizeOf(current.left) + 1;
+      node = current.right;
+    }
+  }
+  return position;
+}
+
+void RankIndex::collect(int node, int count,
+                        QList<LeaderboardEntry>& entries) const {
+  if (node < 0 || entries.size() >= count) {
+    return;
+  }
+
+  const Node& current = nodes[node];
+  collect(current.left, count, entries);
+  if (entries.size() < count) {
+    LeaderboardEntry entry;
+    entry.rank = entries.size() + 1;
+    entry.username = current.username;
+    entry.score = current.score;
+    entries.append(entry);
+  }
+  collect(current.right, count, entries);
+}
+
+QList<LeaderboardEntry> RankIndex::top(int count) const {
+  QList<LeaderboardEntry> entries;
+  collect(root, count, entries);
+  return entries;
+}
+
+int RankIndex::size() const { return sizeOf(root); }
+
+void RankIndex::clear() {
+  nodes.clear();
+  freeNodes.clear();
+  root = -1;
+}
+
+bool Leaderboard::scoreOf(Metric metric, const StatsCounters& counters,
+                          double& score) {
+  switch (metric) {
+    case Wins:
+      score = counters.gamesWin;
+      return true;
+    case WinRate:
+      if (counters.gamesPlayed < MinGames) {
+        return false;
+      }
+      score = double(counters.gamesWin) / double(counters.gamesPlayed);
+      return true;
+    case HitRate:
+      if (counters.guessTotal < MinGuesses) {
+        return false;
+      }
+      score = double(counters.guessHit) / double(counters.guessTotal);
+      return true;
+    case MetricCount:
+      break;
+  }
+  return false;
+}
+
+void Leaderboard::update(const QString& username,
+                         const StatsCounters& counters) {
+  remove(username);
+
+  for (int metric = 0; metric < MetricCount; metric++) {
+    double score;
+    if (scoreOf(Metric(metric), counters, score)) {
+      indexes[metric].insert(score, username);
+    }
+  }
+  ranked.insert(username, counters);
+}
+
+void Leaderboard::remove(const QString& username) {
+  auto it = ranked.find(username);
+  if (it == ranked.end()) {
+    return;
+  }
+
+  for (int metric = 0; metric < MetricCount; metric++) {
+    double score;
+    if (scoreOf(Metric(metric), it.value(), score)) {
+      indexes[metric].erase(score, username);
+    }
+  }
+  ranked.erase(it);
+}
+
+void Leaderboard::rename(const QString& oldUsername,
+                         const QString& newUsername) {
+  auto it = ranked.find(oldUsername);
+  if (it == ranked.end()) {
+    return;
+  }
+
+  StatsCounters counters = it.value();
+  remove(oldUsername);
+  update(newUsername, counters);
+}
+
+void Leaderboard::clear() {
+  ranked.clear();
+  for (RankIndex& index : indexes) {
+    index.clear();
+  }
+}
+
+QList<LeaderboardEntry> Leaderboard::top(Metric metric, int count) const {
+  return indexes[metric].top(count);
+}
+
+int Leaderboard::rank(Metric metric, const QString& username) const {
+  auto it = ranked.find(username);
+  double score;
+  if (it == ranked.end() || !scoreOf(metric, it.value(), score)) {
+    return 0;
+  }
+  return indexes[metric].position(score, username) + 1;
+}
+
+int Leaderboard::size(Metric metric) const { return indexes[metric].size(); }
@@ -0,0 +1,171 @@
+/**
+ * @file leaderboardwindow.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief The screen to show the best users and the rank of a user
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "leaderboardwindow.h"
+
+LeaderboardWindow::LeaderboardWindow(QWidget* parent) : QWidget(parent) {
+  this->setFixedSize(1000, 800);
+
+  // Center the window on the screen
+  QScreen* screen = QGuiApplication::primaryScreen();
+  if (screen) {
+    QRect screenGeometry = screen->geometry();
+    int x = (screenGeometry.width() - this->width()) / 2;
+    int y = (screenGeometry.height() - this->height()) / 2;
+    this->move(x, y);
+  }
+
+  users = User::instance()->store();
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+
+  QString buttonStyles =
+      "QPushButton {"
+      "   background-color:rgb(65, 42, 213);"
+      "   color: white;"
+      "   border-radius: 5px;"
+      "   border: 2px solid #412AD5;"
+      "   padding: 5px;"
+      "   font-weight: bold;"
+      "   font-size: 20px;"
+      "}"
+      "QPushButton:hover {"
+      "   background-color: rgb(54, 35, 177);"  // Hover background color
+      "}";
+
+  QString comboBoxStyle =
+      "QComboBox {"
+      "   background-color: #2a2a2a;"
+      "   color: white;"
+      "   border-radius: 5px;"
+      "   border: 2px solid #412AD5;"
+      "   padding: 5px;"
+      "   font-size: 16px;"
+      "}"
+      "QComboBox::drop-down {"
+      "   background-color: #2a2a2a;"
+      "   border: 2px solid #412AD5;"
+      "}"
+      "QComboBox QAbstractItemView {"
+      "   background-color: #2a2a2a;"
+      "   color: white;"
+      "   border: 2px solid #412AD5;"
+      "   selection-background-color: rgb(54, 35, 177);"
+      "}";
+
+  // Back to Main Button Styling
+  backToMainButton = new QPushButton("Back to Main Menu", this);
+  backToMainButton->setFixedSize(220, 50);
+  backToMainButton->setStyleSheet(buttonStyles);
+  layout->addWidget(backToMainButton);
+
+  // The order matches Leaderboard::Metric
+  metricComboBox = new QComboBox(this);
+  metricComboBox->addItem("Games Won");
+  metricComboBox->addItem(QString("Win Rate (%1+ games)")
+                              .arg(Leaderboard::MinGames));
+  metricComboBox->addItem(QString("Guess Hit Rate (%1+ guesses)")
+                              .arg(Leaderboard::MinGuesses));
+  metricComboBox->setStyleSheet(comboBoxStyle);
+  layout->addWidget(metricComboBox);
+
+  // Top-K Table Styling
+  topTable = new QTableWidget(0, 3, this);
+  topTable->setHorizontalHeaderLabels({"Rank", "Player", "Score"});
+  topTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+  topTable->verticalHeader()->hide();
+  topTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  topTable->setSelectionMode(QAbstractItemView::NoSelection);
+  topTable->setStyleSheet("color: white; font-size: 18px;");
+  layout->addWidget(topTable);
+
+  QHBoxLayout* rankLayout = new QHBoxLayout();
+
+  // The shared model is kept up to date, so this is only done once
+  usernameComboBox = new QComboBox(this);
+  usernameComboBox->setModel(users->usernameModel());
+  usernameComboBox->setStyleSheet(comboBoxStyle);
+  rankLayout->addWidget(usernameComboBox);
+
+  userRankLabel = new QLabel("Rank: N/A", this);
+  userRankLabel->setStyleSheet("color: white; font-size: 18px;");
+  rankLayout->addWidget(userRankLabel);
+  layout->addLayout(rankLayout);
+
+  setLayout(layout);
+
+  connect(backToMainButton, &QPushButton::clicked, this,
+          &LeaderboardWindow::goBackToMain);
+  connect(metricComboBox,
+          QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &LeaderboardWindow::refresh);
+  connect(usernameComboBox,
+          QOverload<int>::of(&QComboBox::currentIndexChanged), this,
+          &LeaderboardWindow::showUserRank);
+}
+
+Leaderboard::Metric LeaderboardWindow::selectedMetric() const {
+  return Leaderboard::Metric(metricComboBox->currentIndex());
+}
+
+QString LeaderboardWindow::formatScore(double score) const {
+  if (selectedMetric() == Leaderboard::Wins) {
+    return QString::number(qint64(score));
+  }
+  return QString::number(score * 100, 'f', 2) + "%";
+}
+
+void LeaderboardWindow::refresh() {
+  // Read straight from the index, O(K) instead of sorting every user
+  QList<LeaderboardEntry> entries =
+      users->leaderboard()->top(selectedMetric(), TopCount);
+
+  topTable->setRowCount(entries.size());
+  for (int row = 0; row < entries.size(); row++) {
+    const LeaderboardEntry& entry = entries.at(row);
+    topTable->setItem(row, 0,
+                      new QTableWidgetItem(QString::number(entry.rank)));
+    topTable->setItem(row, 1, new QTableWidgetItem(entry.username));
+    topTable->setItem(row, 2, new QTableWidgetItem(formatScore(entry.score)));
+  }
+
+  showUserRank();
+}
+
+void LeaderboardWindow::showUserRank() {
+  QString username = usernameComboBox->currentText().trimmed();
+  if (username.isEmpty()) {
+    userRankLabel->setText("Rank: N/A");
+    return;
+  }
+
+  const Leaderboard* leaderboard = users->leaderboard();
+  int rank = leaderboard->rank(selectedMetric(), username);
+  if (rank == 0) {
+    userRankLabel->setText("Rank: not ranked yet");
+    return;
+  }
+
+  userRankLabel->setText(QString("Rank: %1 of %2")
+                             .arg(rank)
+                             .arg(leaderboard->size(selectedMetric())));
+}
+
+void LeaderboardWindow::goBackToMain() {
+  this->hide();
+  emit backToMainWindow();
+}
+
+void LeaderboardWindow::show() {
+  refresh();
+  QWidget::show();
+  qDebug() << "Leaderboard shown";
+}
@@ -81,6 +81,17 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   shadowEffectAccount->setColor(Qt::black);  // Shadow color
   createAccountButton->setGraphicsEffect(shadowEffectAccount);
 
+  // Button to open the leaderboard
+  leaderboardButton = new QPushButton("Leaderboard", centralWidget);
+  leaderboardButton->setFixedSize(200, 50);
+  leaderboardButton->move(400, 575);  // Below the Create Account button
+  QGraphicsDropShadowEffect* shadowEffectLeaderboard =
+      new QGraphicsDropShadowEffect;
+  shadowEffectLeaderboard->setBlurRadius(5);     // Blur radius
+  shadowEffectLeaderboard->setOffset(0, 3);      // Shadow offset
+  shadowEffectLeaderboard->setColor(Qt::black);  // Shadow color
+  leaderboardButton->setGraphicsEffect(shadowEffectLeaderboard);
+
   // Styling
   titleLabel->setStyleSheet("font-weight: bold; font-size: 50px;");
 
@@ -104,6 +115,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   tutorialButton->setStyleSheet(buttonStyles);
   statsButton->setStyleSheet(buttonStyles);
   createAccountButton->setStyleSheet(buttonStyles);
+  leaderboardButton->setStyleSheet(buttonStyles);
 
   // Create the PreGame window
   preGameWindow = new PreGame();
@@ -129,6 +141,12 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   connect(statsWindow, &StatisticsWindow::backToMainWindow, this,
           &MainWindow::showMainWindow);
 
+  leaderboardWindow = new LeaderboardWindow();
+  connect(leaderboardButton, &QPushButton::clicked, this,
+          &MainWindow::openLeaderboard);
+  connect(leaderboardWindow, &LeaderboardWindow::backToMainWindow, this,
+          &MainWindow::showMainWindow);
+
   createAccountWindow = CreateAccountWindow::getInstance();
   connect(createAccountButton, &QPushButton::clicked, this,
           &MainWindow::openCreateAccount);
@@ -183,6 +201,11 @@ void MainWindow::openStatsWindow() {
   statsWindow->show();
 }
 
+void MainWindow::openLeaderboard() {
+  this->hide();
+  leaderboardWindow->show();
+}
+
 void MainWindow::openCreateAccount() {
   this->hide();
   createAccountWindow->setPreviousScreen(this);
@@ -0,0 +1,725 @@
+/**
+ * @file matchhistory.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Append-only, segmented binary history of finished games
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "matchhistory.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QStringList>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char logMagic[4] = {'C', 'N', 'M', 'R'};
+const char segmentMagic[4] = {'C', 'N', 'M', 'C'};
+const quint16 historyVersion = 1;
+const int logHeaderSize = 16;      // magic, version, reserved, first game
+const int segmentHeaderSize = 24;  // ... then game count, column count
+const int directoryEntrySize = 20;  // column id, offset, length
+const char* activeName = "active.cnmr";
+const char* lockName = "history.lock";
+const int lockTimeoutMs = 5000;  // As long as the profile lock waits
+
+/**
+ * Columns of a segment. Fixed-width columns hold one value per game
+ * (Players and Words hold 4 and 25 string ids per game). The clue and
+ * reveal columns hold one value per clue or reveal, and ClueIndex /
+ * RevealIndex hold count + 1 offsets into them.
+ */
+enum Column : quint32 {
+  StartedAt,    // i64
+  EndedAt,      // i64
+  Winner,       // u8, 1 for red
+  EndReason,    // u8
+  Players,      // u32 string id x 4
+  Words,        // u32 string id x 25
+  KeyCard,      // u8 x 25
+  ClueIndex,    // u32 x (count + 1)
+  ClueSeat,     // u8
+  ClueNumber,   // u8
+  ClueAt,       // i32
+  ClueWord,     // u32 string id
+  RevealIndex,  // u32 x (count + 1)
+  RevealCell,   // u8
+  RevealSeat,   // u8
+  RevealAt,     // i32
+  Strings,      // u32 n, u32 offsets x (n + 1), UTF-8 bytes
+  ColumnCount
+};
+
+QByteArray encodeLogHeader(quint64 firstGame) {
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out.writeRawData(logMagic, sizeof(logMagic));
+  out << historyVersion << quint16(0) << firstGame;
+  return bytes;
+}
+
+template <typename T>
+void put(QByteArray& column, T value) {
+  uchar bytes[sizeof(T)];
+  qToBigEndian(value, bytes);
+  column.append(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+/**
+ * A mapped segment, with each column located by the directory
+ */
+class SegmentReader {
+ public:
+  explicit SegmentReader(const QString& path) : file(path) {}
+
+  bool open(quint32 expectedCount) {
+    if (!file.open(QIODevice::ReadOnly)) {
+      return false;
+    }
+    qint64 size = file.size();
+    data = size > 0 ? file.map(0, size) : nullptr;
+    if (!data || size < segmentHeaderSize ||
+        memcmp(data, segmentMagic, sizeof(segmentMagic)) != 0) {
+      return false;
+    }
+    count = qFromBigEndian<quint32>(data + 16);
+    quint32 columns = qFromBigEndian<quint32>(data + 20);
+    if (count != expectedCount ||
+        segmentHeaderSize + qint64(columns) * directoryEntrySize > size) {
+      return false;
+    }
+
+    std::fill(begins, begins + ColumnCount, nullptr);
+    for (quint32 i = 0; i < columns; i++) {
+      const uchar* entry = data + segmentHeaderSize + i * directoryEntrySize;
+      quint32 id = qFromBigEndian<quint32>(entry);
+      quint64 offset = qFromBigEndian<quint64>(entry + 4);
+      quint64 length = qFromBigEndian<quint64>(entry + 12);
+      if (offset > quint64(size) || length > quint64(size) - offset) {
+        return false;
+      }
+      if (id < ColumnCount) {
+        begins[id] = data + offset;
+        lengths[id] = length;
+      }
+    }
+    return true;
+  }
+
+  // The column, or null if it is missing or shorter than needed
+  const uchar* column(Column id, quint64 minLength) const {
+    return begins[id] && lengths[id] >= minLength ? begins[id] : nullptr;
+  }
+
+  bool readStrings(QStringList& strings) const {
+    const uchar* column = this->column(Strings, 4);
+    if (!column) {
+      return false;
+    }
+    quint32 n = qFromBigEndian<quint32>(column);
+    quint64 bytesAt = 4 + (quint64(n) + 1) * 4;
+    if (lengths[Strings] < bytesAt) {
+      return false;
+    }
+    strings.clear();
+    strings.reserve(int(n));
+    for (quint32 i = 0; i < n; i++) {
+      quint32 begin = qFromBigEndian<quint32>(column + 4 + i * 4);
+      quint32 end = qFromBigEndian<quint32>(column + 8 + i * 4);
+      if (begin > end || bytesAt + end > lengths[Strings]) {
+        return false;
+      }
+      strings.append(QString::fromUtf8(
+          reinterpret_cast<const char*>(column + bytesAt + begin),
+          int(end - begin)));
+    }
+    return true;
+  }
+
+  quint32 count = 0;
+
+ private:
+  QFile file;
+  const uchar* data = nullptr;
+  const uchar* begins[ColumnCount];
+  quint64 lengths[ColumnCount];
+};
+
+// Look up a string id, tolerating ids past the dictionary
+QString stringAt(const QStringList& strings, quint32 id) {
+  return id < quint32(strings.size()) ? strings.at(int(id)) : QString();
+}
+
+}  // namespace
+
+void MatchRecord::start() {
+  *this = MatchRecord();
+  startedAt = QDateTime::currentMSecsSinceEpoch();
+}
+
+void MatchRecord::addClue(int seat, const QString& word, int number) {
+  Clue clue;
+  clue.seat = quint8(seat);
+  clue.number = quint8(std::max(0, std::min(number, 255)));
+  clue.atMs = qint32(QDateTime::currentMSecsSinceEpoch() - startedAt);
+  clue.word = word;
+  clues.append(clue);
+}
+
+void MatchRecord::addReveal(int cell, int seat) {
+  Reveal reveal;
+  reveal.cell = quint8(cell);
+  reveal.seat = quint8(seat);
+  reveal.atMs = qint32(QDateTime::currentMSecsSinceEpoch() - startedAt);
+  reveals.append(reveal);
+}
+
+MatchResult MatchRecord::result() const {
+  MatchResult result;
+  for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+    result.players[seat] = players[seat];
+  }
+  result.redWon = redWon;
+  result.timestamp = endedAt;
+  return result;
+}
+
+MatchHistory::MatchHistory(const QString& dirPath) : dirPath(dirPath) {}
+
+QByteArray MatchHistory::encodeRow(const MatchRecord& record) {
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out << record.startedAt << record.endedAt << quint8(record.redWon ? 1 : 0)
+      << record.endReason;
+  for (const QString& player : record.players) {
+    out << player.toUtf8();
+  }
+  for (int cell = 0; cell < MatchRecord::Cells; cell++) {
+    out << record.words[cell].toUtf8() << record.keyCard[cell];
+  }
+  out << quint32(record.clues.size());
+  for (const MatchRecord::Clue& clue : record.clues) {
+    out << clue.seat << clue.number << clue.atMs << clue.word.toUtf8();
+  }
+  out << quint32(record.reveals.size());
+  for (const MatchRecord::Reveal& reveal : record.reveals) {
+    out << reveal.cell << reveal.seat << reveal.atMs;
+  }
+  return bytes;
+}
+
+bool MatchHistory::decodeRow(const QByteArray& row, MatchRecord& record) {
+  QDataStream in(row);
+  quint8 redWon = 0;
+  QByteArray text;
+  in >> record.startedAt >> record.endedAt >> redWon >> record.endReason;
+  record.redWon = redWon != 0;
+  for (QString& player : record.players) {
+    in >> text;
+    player = QString::fromUtf8(text);
+  }
+  for (int cell = 0; cell < MatchRecord::Cells; cell++) {
+    in >> text >> record.keyCard[cell];
+    record.words[cell] = QString::fromUtf8(text);
+  }
+
+  // Counts are bounded by the row size so a corrupt count cannot allocate
+  quint32 count = 0;
+  in >> count;
+  if (in.status() != QDataStream::Ok || count > quint32(row.size())) {
+    return false;
+  }
+  record.clues.resize(int(count));
+  for (MatchRecord::Clue& clue : record.clues) {
+    in >> clue.seat >> clue.number >> clue.atMs >> text;
+    clue.word = QString::fromUtf8(text);
+  }
+  in >> count;
+  if (in.status() != QDataStream::Ok || count > quint32(row.size())) {
+    return false;
+  }
+  record.reveals.resize(int(count));
+  for (MatchRecord::Reveal& reveal : record.reveals) {
+    in >> reveal.cell >> reveal.seat >> reveal.atMs;
+  }
+  return in.status() == QDataStream::Ok && in.atEnd();
+}
+
+bool MatchHistory::resetActive(quint64 firstGame) const {
+  QByteArray header = encodeLogHeader(firstGame);
+  if (!active.resize(0) || !active.seek(0) ||
+      active.write(header) != header.size() || !active.flush()) {
+    qDebug() << "Failed to reset" << active.fileName();
+    return false;
+  }
+  activeFirst = firstGame;
+  activeCount = 0;
+  activeEnd = logHeaderSize;
+  return true;
+}
+
+bool MatchHistory::open() {
+  QDir dir(dirPath);
+  if (!dir.mkpath(".")) {
+    qDebug() << "Failed to create" << QFileInfo(dirPath).absoluteFilePath();
+    return false;
+  }
+
+  QLockFile lock(dir.filePath(lockName));
+  if (!lock.tryLock(lockTimeoutMs)) {
+    qDebug() << "Timed out waiting for the match history lock";
+    return false;
+  }
+
+  // Unbuffered, reads must see what other instances appended
+  active.setFileName(dir.filePath(activeName));
+  if (!active.open(QIODevice::ReadWrite | QIODevice::Unbuffered)) {
+    qDebug() << "Failed to open" << QFileInfo(active).absoluteFilePath();
+    return false;
+  }
+  if (!load()) {
+    return false;
+  }
+
+  if (activeCount >= quint32(SegmentGames)) {
+    seal();
+  }
+  return true;
+}
+
+bool MatchHistory::load() const {
+  QDir dir(dirPath);
+
+  // Segment names are zero-padded, so name order is game order
+  segments.clear();
+  quint64 sealedEnd = 0;
+  const QStringList names =
+      dir.entryList({"segment-*.cnmc"}, QDir::Files, QDir::Name);
+  for (const QString& name : names) {
+    QFile file(dir.filePath(name));
+    QByteArray header;
+    if (file.open(QIODevice::ReadOnly)) {
+      header = file.read(segmentHeaderSize);
+    }
+    if (header.size() < segmentHeaderSize ||
+        !header.startsWith(QByteArray(segmentMagic, sizeof(segmentMagic)))) {
+      qDebug() << "Skipping unreadable match history segment" << name;
+      continue;
+    }
+    const uchar* bytes = reinterpret_cast<const uchar*>(header.constData());
+    Segment segment;
+    segment.path = file.fileName();
+    segment.firstGame = qFromBigEndian<quint64>(bytes + 8);
+    segment.count = qFromBigEndian<quint32>(bytes + 16);
+    segments.append(segment);
+    sealedEnd = std::max(sealedEnd, segment.firstGame + segment.count);
+  }
+
+  QByteArray header;
+  if (active.seek(0)) {
+    header = active.read(logHeaderSize);
+  }
+  if (header.size() < logHeaderSize ||
+      !header.startsWith(QByteArray(logMagic, sizeof(logMagic)))) {
+    if (!header.isEmpty()) {
+      qDebug() << "Unrecognised match history log, starting a new one";
+    }
+    return resetActive(sealedEnd);
+  }
+  activeFirst = qFromBigEndian<quint64>(
+      reinterpret_cast<const uchar*>(header.constData()) + 8);
+
+  // A crash between writing a segment and emptying the log leaves games
+  // that are already sealed
+  if (activeFirst < sealedEnd) {
+    return resetActive(sealedEnd);
+  }
+
+  // Count rows by their length prefixes, a short one was torn by a crash
+  qint64 size = active.size();
+  qint64 goodEnd = logHeaderSize;
+  activeCount = 0;
+  while (goodEnd + 4 <= size) {
+    uchar prefix[4];
+    if (!active.seek(goodEnd) ||
+        active.read(reinterpret_cast<char*>(prefix), 4) != 4) {
+      break;
+    }
+    qint64 length = qFromBigEndian<quint32>(prefix);
+    if (goodEnd + 4 + length > size) {
+      break;
+    }
+    goodEnd += 4 + length;
+    activeCount++;
+  }
+  if (goodEnd < size) {
+    qDebug() << "Dropping a torn match history record";
+    active.resize(goodEnd);
+  }
+  activeEnd = goodEnd;
+  return true;
+}
+
+bool MatchHistory::refresh() const {
+  if (!active.isOpen()) {
+    return false;
+  }
+
+  // Appends grow the log and a seal restarts it at a later first game, so
+  // an unchanged size and first game mean nothing was added
+  uchar header[logHeaderSize];
+  if (active.seek(0) &&
+      active.read(reinterpret_cast<char*>(header), logHeaderSize) ==
+          logHeaderSize &&
+      memcmp(header, logMagic, sizeof(logMagic)) == 0 &&
+      qFromBigEndian<quint64>(header + 8) == activeFirst &&
+      active.size() == activeEnd) {
+    return true;
+  }
+  return load();
+}
+
+bool MatchHistory::snapshot(QList<Segment>& sealed,
+                            QVector<MatchRecord>& records) const {
+  QLockFile lock(QDir(dirPath).filePath(lockName));
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    qDebug() << "Reading the match history without the latest games";
+  }
+
+  // Segments are never rewritten, they are read after the lock is released
+  sealed = segments;
+  return readActive(records);
+}
+
+bool MatchHistory::append(const MatchRecord& record) {
+  if (!active.isOpen()) {
+    return false;
+  }
+
+  QByteArray row = encodeRow(record);
+  QByteArray bytes;
+  put(bytes, quint32(row.size()));
+  bytes.append(row);
+
+  QLockFile lock(QDir(dirPath).filePath(lockName));
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    qDebug() << "Failed to lock" << active.fileName();
+    return false;
+  }
+
+  // One write per game, at the end of the log other instances left
+  if (!active.seek(activeEnd) || active.write(bytes) != bytes.size() ||
+      !active.flush()) {
+    qDebug() << "Failed to append to" << active.fileName();
+    return false;
+  }
+  activeEnd += bytes.size();
+  activeCount++;
+
+  if (activeCount >= quint32(SegmentGames)) {
+    seal();
+  }
+  return true;
+}
+
+quint64 MatchHistory::gameCount() const {
+  QLockFile lock(QDir(dirPath).filePath(lockName));
+  if (lock.tryLock(lockTimeoutMs)) {
+    refresh();
+  }
+
+  quint64 count = activeCount;
+  for (const Segment& segment : segments) {
+    count += segment.count;
+  }
+  return count;
+}
+
+bool MatchHistory::readActive(QVector<MatchRecord>& records) const {
+  QFile file(active.fileName());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  QByteArray data = file.readAll();
+  const uchar* bytes = reinterpret_cast<const uchar*>(data.constData());
+
+  records.clear();
+  records.reserve(int(activeCount));
+  qint64 at = logHeaderSize;
+  for (quint32 i = 0; i < activeCount; i++) {
+    if (at + 4 > data.size()) {
+      return false;
+    }
+    qint64 length = qFromBigEndian<quint32>(bytes + at);
+    if (at + 4 + length > data.size()) {
+      return false;
+    }
+    MatchRecord record;
+    if (!decodeRow(data.mid(int(at + 4), int(length)), record)) {
+      qDebug() << "Skipping a malformed match history record";
+    } else {
+      records.append(record);
+    }
+    at += 4 + length;
+  }
+  return true;
+}
+
+bool MatchHistory::seal() {
+  QVector<MatchRecord> records;
+  if (!readActive(records) || records.isEmpty()) {
+    return false;
+  }
+
+  QByteArray columns[ColumnCount];
+  QHash<QString, quint32> ids;
+  QStringList strings;
+  auto intern = [&ids, &strings](const QString& text) {
+    auto it = ids.find(text);
+    if (it == ids.end()) {
+      it = ids.insert(text, quint32(strings.size()));
+      strings.append(text);
+    }
+    return it.value();
+  };
+
+  put(columns[ClueIndex], quint32(0));
+  put(columns[RevealIndex], quint32(0));
+  quint32 clueCount = 0;
+  quint32 revealCount = 0;
+  for (const MatchRecord& record : records) {
+    put(columns[StartedAt], record.startedAt);
+    put(columns[EndedAt], record.endedAt);
+    put(columns[Winner], quint8(record.redWon ? 1 : 0));
+    put(columns[EndReason], record.endReason);
+    for (const QString& player : record.players) {
+      put(columns[Players], intern(player));
+    }
+    for (int cell = 0; cell < MatchRecord::Cells; cell++) {
+      put(columns[Words], intern(record.words[cell]));
+      put(columns[KeyCard], record.keyCard[cell]);
+    }
+    for (const MatchRecord::Clue& clue : record.clues) {
+      put(columns[ClueSeat], clue.seat);
+      put(columns[ClueNumber], clue.number);
+      put(columns[ClueAt], clue.atMs);
+      put(columns[ClueWord], intern(clue.word));
+    }
+    clueCount += quint32(record.clues.size());
+    put(columns[ClueIndex], clueCount);
+    for (const MatchRecord::Reveal& reveal : record.reveals) {
+      put(columns[RevealCell], reveal.cell);
+      put(columns[RevealSeat], reveal.seat);
+      put(columns[RevealAt], reveal.atMs);
+    }
+    revealCount += quint32(record.reveals.size());
+    put(columns[RevealIndex], revealCount);
+  }
+
+  QByteArray text;
+  put(columns[Strings], quint32(strings.size()));
+  put(columns[Strings], quint32(0));
+  for (const QString& string : strings) {
+    text.append(string.toUtf8());
+    put(columns[Strings], quint32(text.size()));
+  }
+  columns[Strings].append(text);
+
+  // Header and directory, then the columns back to back
+  QByteArray header;
+  header.append(segmentMagic, sizeof(segmentMagic));
+  put(header, historyVersion);
+  put(header, quint16(0));
+  put(header, quint64(activeFirst));
+  put(header, quint32(records.size()));
+  put(header, quint32(ColumnCount));
+  quint64 offset = segmentHeaderSize + ColumnCount * directoryEntrySize;
+  for (quint32 id = 0; id < ColumnCount; id++) {
+    put(header, id);
+    put(header, offset);
+    put(header, quint64(columns[id].size()));
+    offset += quint64(columns[id].size());
+  }
+
+  Segment segment;
+  segment.path = QDir(dirPath).filePath(
+      QString("segment-%1.cnmc").arg(activeFirst, 12, 10, QChar('0')));
+  segment.firstGame = activeFirst;
+  segment.count = quint32(records.size());
+
+  QSaveFile file(segment.path);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qDebug() << "Failed to open" << segment.path;
+    return false;
+  }
+  file.write(header);
+  for (const QByteArray& column : columns) {
+    file.write(column);
+  }
+  if (!file.commit()) {
+    qDebug() << "Failed to write" << segment.path;
+    return false;
+  }
+
+  segments.append(segment);
+  return resetActive(activeFirst + activeCount);
+}
+
+QVector<MatchResult> MatchHistory::results() const {
+  QList<Segment> sealed;
+  QVector<MatchRecord> records;
+  snapshot(sealed, records);
+
+  quint64 count = quint64(records.size());
+  for (const Segment& segment : sealed) {
+    count += segment.count;
+  }
+  QVector<MatchResult> results;
+  results.reserve(int(count));
+
+  for (const Segment& segment : sealed) {
+    SegmentReader reader(segment.path);
+    QStringList strings;
+    if (!reader.open(segment.count) || !reader.readStrings(strings)) {
+      qDebug() << "Skipping unreadable match history segment" << segment.path;
+      continue;
+    }
+    quint32 count = reader.count;
+    const uchar* players = reader.column(Players, quint64(count) * 16);
+    const uchar* winners = reader.column(Winner, count);
+    const uchar* endedAt = reader.column(EndedAt, quint64(count) * 8);
+    if (!players || !winners || !endedAt) {
+      continue;
+    }
+
+    for (quint32 game = 0; game < count; game++) {
+      MatchResult result;
+      for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+        result.players[seat] = stringAt(
+            strings, qFromBigEndian<quint32>(players + (game * 4 + seat) * 4));
+      }
+      result.redWon = winners[game] != 0;
+      result.timestamp = qFromBigEndian<qint64>(endedAt + game * 8);
+      results.append(result);
+    }
+  }
+
+  for (const MatchRecord& record : records) {
+    results.append(record.result());
+  }
+  return results;
+}
+
+bool MatchHistory::forEachGame(
+    const std::function<bool(const MatchRecord&)>& visit) const {
+  QList<Segment> sealed;
+  QVector<MatchRecord> records;
+  bool complete = snapshot(sealed, records);
+
+  for (const Segment& segment : sealed) {
+    SegmentReader reader(segment.path);
+    QStringList strings;
+    if (!reader.open(segment.count) || !reader.readStrings(strings)) {
+      qDebug() << "Skipping unreadable match history segment" << segment.path;
+      complete = false;
+      continue;
+    }
+    quint32 count = reader.count;
+    const uchar* clueIndex = reader.column(ClueIndex, (quint64(count) + 1) * 4);
+    const uchar* revealIndex =
+        reader.column(RevealIndex, (quint64(count) + 1) * 4);
+    if (!clueIndex || !revealIndex) {
+      complete = false;
+      continue;
+    }
+    quint32 clues = qFromBigEndian<quint32>(clueIndex + count * 4);
+    quint32 reveals = qFromBigEndian<quint32>(revealIndex + count * 4);
+
+    const uchar* startedAt = reader.column(StartedAt, quint64(count) * 8);
+    const uchar* endedAt = reader.column(EndedAt, quint64(count) * 8);
+    const uchar* winners = reader.column(Winner, count);
+    const uchar* endReasons = reader.column(EndReason, count);
+    const uchar* players = reader.column(Players, quint64(count) * 16);
+    const uchar* words = reader.column(Words, quint64(count) * 100);
+    const uchar* keyCards = reader.column(KeyCard, quint64(count) * 25);
+    const uchar* clueSeats = reader.column(ClueSeat, clues);
+    const uchar* clueNumbers = reader.column(ClueNumber, clues);
+    const uchar* clueAt = reader.column(ClueAt, quint64(clues) * 4);
+    const uchar* clueWords = reader.column(ClueWord, quint64(clues) * 4);
+    const uchar* revealCells = reader.column(RevealCell, reveals);
+    const uchar* revealSeats = reader.column(RevealSeat, reveals);
+    const uchar* revealAt = reader.column(RevealAt, quint64(reveals) * 4);
+    if (!startedAt || !endedAt || !winners || !endReasons || !players ||
+        !words || !keyCards || !clueSeats || !clueNumbers || !clueAt ||
+        !clueWords || !revealCells || !revealSeats || !revealAt) {
+      complete = false;
+      continue;
+    }
+
+    MatchRecord record;
+    for (quint32 game = 0; game < count; game++) {
+      record.startedAt = qFromBigEndian<qint64>(startedAt + game * 8);
+      record.endedAt = qFromBigEndian<qint64>(endedAt + game * 8);
+      record.redWon = winners[game] != 0;
+      record.endReason = endReasons[game];
+      for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+        record.players[seat] = stringAt(
+            strings, qFromBigEndian<quint32>(players + (game * 4 + seat) * 4));
+      }
+      for (int cell = 0; cell < MatchRecord::Cells; cell++) {
+        quint32 index = game * MatchRecord::Cells + cell;
+        record.words[cell] =
+            stringAt(strings, qFromBigEndian<quint32>(words + index * 4));
+        record.keyCard[cell] = keyCards[index];
+      }
+
+      quint32 first = qFromBigEndian<quint32>(clueIndex + game * 4);
+      quint32 last =
+          std::min(qFromBigEndian<quint32>(clueIndex + (game + 1) * 4), clues);
+      record.clues.clear();
+      for (quint32 i = first; i < last; i++) {
+        MatchRecord::Clue clue;
+        clue.seat = clueSeats[i];
+        clue.number = clueNumbers[i];
+        clue.atMs = qFromBigEndian<qint32>(clueAt + i * 4);
+        clue.word = stringAt(strings, qFromBigEndian<quint32>(clueWords + i * 4));
+        record.clues.append(clue);
+      }
+
+      first = qFromBigEndian<quint32>(revealIndex + game * 4);
+      last = std::min(qFromBigEndian<quint32>(revealIndex + (game + 1) * 4),
+                      reveals);
+      record.reveals.clear();
+      for (quint32 i = first; i < last; i++) {
+        MatchRecord::Reveal reveal;
+        reveal.cell = revealCells[i];
+        reveal.seat = revealSeats[i];
+        reveal.atMs = qFromBigEndian<qint32>(revealAt + i * 4);
+        record.reveals.append(reveal);
+      }
+
+      if (!visit(record)) {
+        return complete;
+      }
+    }
+  }
+
+  for (const MatchRecord& record : records) {
+    if (!visit(record)) {
+      break;
+    }
+  }
+  return complete;
+}
@@ -0,0 +1,502 @@
+/**
+ * @file pairstats.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Memory-mapped win records of teammate and opponent pairs
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "pairstats.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char pairsMagic[4] = {'C', 'N', 'P', 'S'};
+const char namesMagic[4] = {'C', 'N', 'P', 'N'};
+const quint32 pairsVersion = 1;
+const int lockTimeoutMs = 5000;  // As long as the profile lock waits
+
+// The relation is kept in the top bit of the higher id
+const quint32 relationBit = 0x80000000u;
+
+QString namesPath(const QString& filePath) { return filePath + ".names"; }
+
+QByteArray encodeName(const QString& username) {
+  QByteArray name = username.toUtf8();
+  QByteArray entry;
+  QDataStream out(&entry, QIODevice::WriteOnly);
+  out << quint16(name.size());
+  out.writeRawData(name.constData(), name.size());
+  return entry;
+}
+
+}  // namespace
+
+PairStats::PairStats(const QString& filePath)
+    : filePath(filePath), lockPath(filePath + ".lock") {}
+
+PairStats::~PairStats() { unmap(); }
+
+bool PairStats::isOpen() const { return data != nullptr; }
+
+quint64 PairStats::hashKey(quint32 low, quint32 high) {
+  // splitmix64 finalizer, ids are small and sequential
+  quint64 key = (quint64(low) << 32) | high;
+  key ^= key >> 30;
+  key *= 0xBF58476D1CE4E5B9ULL;
+  key ^= key >> 27;
+  key *= 0x94D049BB133111EBULL;
+  key ^= key >> 31;
+  return key;
+}
+
+bool PairStats::open(quint32 initialCapacity) {
+  unmap();
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs)) {
+    qDebug() << "Timed out waiting for" << QFileInfo(lockPath).fileName();
+    return false;
+  }
+
+  // Names first, the table refers to users by their position in it
+  if (!readNames()) {
+    names = {QString()};
+    ids.clear();
+    if (!writeNames()) {
+      qDebug() << "Failed to write"
+               << QFileInfo(namesPath(filePath)).absoluteFilePath();
+      return false;
+    }
+  }
+
+  file.setFileName(filePath);
+  if (!(file.exists() && file.open(QIODevice::ReadWrite) && map())) {
+    if (file.exists()) {
+      qDebug() << "Invalid pair statistics, recreating"
+               << QFileInfo(filePath).absoluteFilePath();
+    }
+    unmap();
+
+    quint32 capacity = 16;
+    while (capacity < initialCapacity) {
+      capacity *= 2;
+    }
+    if (!rebuild(capacity)) {
+      return false;
+    }
+  }
+
+  listPartners();
+  seenGeneration = header->generation;
+  return true;
+}
+
+bool PairStats::readNames() const {
+  QFile namesFile(namesPath(filePath));
+  if (!namesFile.open(QIODevice::ReadWrite)) {
+    return false;
+  }
+  QByteArray bytes = namesFile.readAll();
+  if (!bytes.startsWith(QByteArray(namesMagic, sizeof(namesMagic)))) {
+    return false;
+  }
+
+  names = {QString()};
+  ids.clear();
+  int pos = sizeof(namesMagic);
+  while (pos + 2 <= bytes.size()) {
+    int length = (uchar(bytes[pos]) << 8) | uchar(bytes[pos + 1]);
+    if (pos + 2 + length > bytes.size()) {
+      break;  // Torn by a crash mid-append
+    }
+    QString username = QString::fromUtf8(bytes.constData() + pos + 2, length);
+    ids.insert(username, quint32(names.size()));
+    names.append(username);
+    pos += 2 + length;
+  }
+  if (pos < bytes.size()) {
+    namesFile.resize(pos);
+  }
+  return true;
+}
+
+void PairStats::listPartners() const {
+  partners[Teammates].clear();
+  partners[Opponents].clear();
+
+  // Ids the names do not know mean the two files are out of step, and the
+  // table starts over
+  quint32 knownIds = quint32(names.size());
+  for (quint32 i = 0; i < header->capacity; i++) {
+    const Record& record = pairs[i];
+    if (record.low == 0) {
+      continue;
+    }
+    quint32 high = record.high & ~relationBit;
+    Relation relation = (record.high & relationBit) ? Opponents : Teammates;
+    if (record.low >= knownIds || high >= knownIds) {
+      qDebug() << "Pair statistics do not match their names, clearing";
+      std::memset(pairs, 0, header->capacity * sizeof(Record));
+      header->used = 0;
+      header->generation++;
+      partners[Teammates].clear();
+      partners[Opponents].clear();
+      break;
+    }
+    partners[relation][record.low].append(high);
+    partners[relation][high].append(record.low);
+  }
+}
+
+bool PairStats::refresh() const {
+  if (data && header->retired != 0) {
+    // Another instance rebuilt the table, its pairs are in the new file
+    unmap();
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadWrite) || !map()) {
+      qDebug() << "Failed to map" << QFileInfo(filePath).absoluteFilePath();
+      unmap();
+      return false;
+    }
+  }
+  if (!data) {
+    return false;
+  }
+
+  // Another instance added names or pairs since they were read
+  if (header->generation != seenGeneration) {
+    if (!readNames()) {
+      qDebug() << "Failed to read"
+               << QFileInfo(namesPath(filePath)).absoluteFilePath();
+      return false;
+    }
+    listPartners();
+    seenGeneration = header->generation;
+  }
+  return true;
+}
+
+void PairStats::bumpGeneration() {
+  header->generation++;
+  seenGeneration = header->generation;
+}
+
+bool PairStats::map() const {
+  qint64 fileSize = file.size();
+  if (fileSize < qint64(sizeof(Header))) {
+    return false;
+  }
+
+  data = file.map(0, fileSize);
+  if (!data) {
+    return false;
+  }
+
+  header = reinterpret_cast<Header*>(data);
+  pairs = reinterpret_cast<Record*>(data + sizeof(Header));
+
+  quint32 capacity = header->capacity;
+  qint64 expectedSize =
+      qint64(sizeof(Header)) + qint64(capacity) * qint64(sizeof(Record));
+  bool valid = std::memcmp(header->magic, pairsMagic, sizeof(pairsMagic)) == 0 &&
+               header->version == pairsVersion && capacity >= 16 &&
+               (capacity & (capacity - 1)) == 0 && fileSize == expectedSize;
+  if (!valid) {
+    unmap();
+    return false;
+  }
+
+  // The file at filePath is the current table, even if a rebuild that
+  // failed to replace it marked it retired
+  header->retired = 0;
+  return true;
+}
+
+void PairStats::unmap() const {
+  if (data) {
+    file.unmap(data);
+  }
+  data = nullptr;
+  header = nullptr;
+  pairs = nullptr;
+  file.close();
+}
+
+PairStats::Record* PairStats::lookup(quint32 low, quint32 high) const {
+  quint32 mask = header->capacity - 1;
+  for (quint32 i = hashKey(low, high) & mask, probes = 0; probes <= mask;
+       i = (i + 1) & mask, probes++) {
+    Record& record = pairs[i];
+    if (record.low == 0) {
+      return nullptr;  // End of the probe chain
+    }
+    if (record.low == low && record.high == high) {
+      return &record;
+    }
+  }
+  return nullptr;
+}
+
+void PairStats::addGame(quint32 a, quint32 b, Relation relation, bool aWon) {
+  if (a == 0 || b == 0 || a == b) {
+    return;
+  }
+
+  quint32 low = std::min(a, b);
+  quint32 high = std::max(a, b) | (relation == Opponents ? relationBit : 0);
+  Record* record = lookup(low, high);
+  if (!record) {
+    // Keep at least half of the slots empty so probe chains stay short
+    if ((header->used + 1) * 2 > header->capacity &&
+        !rebuild(header->capacity * 2)) {
+      return;
+    }
+
+    quint32 mask = header->capacity - 1;
+    quint32 i = hashKey(low, high) & mask;
+    while (pairs[i].low != 0) {
+      i = (i + 1) & mask;
+    }
+    record = &pairs[i];
+    record->low = low;
+    record->high = high;
+    record->games = 0;
+    record->wins = 0;
+    header->used++;
+
+    partners[relation][low].append(std::max(a, b));
+    partners[relation][std::max(a, b)].append(low);
+    bumpGeneration();
+  }
+
+  // Teammates share the win, opponents store the lower id's side
+  record->games++;
+  bool counted = (relation == Teammates || low == a) ? aWon : !aWon;
+  if (counted) {
+    record->wins++;
+  }
+}
+
+void PairStats::recordGame(const MatchResult& match) {
+  if (!data) {
+    return;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    qDebug() << "Failed to record a game in the pair statistics";
+    return;
+  }
+
+  quint32 seats[RatingEngine::SeatCount] = {};
+  for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+    if (!match.players[seat].isEmpty()) {
+      seats[seat] = idOf(match.players[seat]);
+    }
+  }
+
+  quint32 redSpymaster = seats[RatingEngine::RedSpymaster];
+  quint32 redOperative = seats[RatingEngine::RedOperative];
+  quint32 blueSpymaster = seats[RatingEngine::BlueSpymaster];
+  quint32 blueOperative = seats[RatingEngine::BlueOperative];
+
+  addGame(redSpymaster, redOperative, Teammates, match.redWon);
+  addGame(blueSpymaster, blueOperative, Teammates, !match.redWon);
+  for (quint32 red : {redSpymaster, redOperative}) {
+    for (quint32 blue : {blueSpymaster, blueOperative}) {
+      addGame(red, blue, Opponents, match.redWon);
+    }
+  }
+}
+
+PairRecord PairStats::record(const QString& username, const QString& other,
+                             Relation relation) const {
+  PairRecord result;
+  result.other = other;
+  if (!data) {
+    return result;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    return result;
+  }
+  return recordOf(ids.value(username), ids.value(other), other, relation);
+}
+
+PairRecord PairStats::recordOf(quint32 id, quint32 otherId,
+                               const QString& other, Relation relation) const {
+  PairRecord result;
+  result.other = other;
+  if (id == 0 || otherId == 0 || id == otherId) {
+    return result;
+  }
+
+  quint32 low = std::min(id, otherId);
+  quint32 high =
+      std::max(id, otherId) | (relation == Opponents ? relationBit : 0);
+  const Record* found = lookup(low, high);
+  if (!found) {
+    return result;
+  }
+
+  result.games = found->games;
+  result.wins = (relation == Teammates || id == low)
+                    ? found->wins
+                    : found->games - found->wins;
+  result.winRate = result.games ? float(result.wins) / result.games : 0;
+  return result;
+}
+
+QVector<PairRecord> PairStats::records(const QString& username,
+                                       Relation relation,
+                                       quint32 minGames) const {
+  QVector<PairRecord> result;
+  if (!data) {
+    return result;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    return result;
+  }
+  quint32 id = ids.value(username);
+  if (id == 0) {
+    return result;
+  }
+
+  // Only this user's pairs are read, never the whole table
+  const QVector<quint32> others = partners[relation].value(id);
+  result.reserve(others.size());
+  for (quint32 otherId : others) {
+    PairRecord pair = recordOf(id, otherId, names.at(int(otherId)), relation);
+    if (pair.games >= minGames) {
+      result.append(pair);
+    }
+  }
+
+  std::sort(result.begin(), result.end(),
+            [](const PairRecord& a, const PairRecord& b) {
+              if (a.winRate != b.winRate) {
+                return a.winRate > b.winRate;
+              }
+              return a.games > b.games;
+            });
+  return result;
+}
+
+bool PairStats::rename(const QString& oldUsername,
+                       const QString& newUsername) {
+  if (!data) {
+    return false;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh() ||
+      !ids.contains(oldUsername) || ids.contains(newUsername)) {
+    return false;
+  }
+
+  quint32 id = ids.take(oldUsername);
+  ids.insert(newUsername, id);
+  names[int(id)] = newUsername;
+  if (!writeNames()) {
+    // Keep the names that are on disk
+    ids.remove(newUsername);
+    ids.insert(oldUsername, id);
+    names[int(id)] = oldUsername;
+    return false;
+  }
+  bumpGeneration();
+  return true;
+}
+
+quint32 PairStats::idOf(const QString& username) {
+  auto it = ids.constFind(username);
+  if (it != ids.constEnd()) {
+    return it.value();
+  }
+
+  if (username.toUtf8().size() > 0xFFFF) {
+    return 0;
+  }
+  QByteArray entry = encodeName(username);
+
+  // Appended before use, so a record never refers to an unsaved id
+  QFile namesFile(namesPath(filePath));
+  if (!namesFile.open(QIODevice::Append) ||
+      namesFile.write(entry) != entry.size() || !namesFile.flush()) {
+    qDebug() << "Failed to save the pair statistics id of" << username;
+    return 0;
+  }
+
+  quint32 id = quint32(names.size());
+  names.append(username);
+  ids.insert(username, id);
+  bumpGeneration();
+  return id;
+}
+
+bool PairStats::writeNames() const {
+  QByteArray bytes(namesMagic, sizeof(namesMagic));
+  for (int id = 1; id < names.size(); id++) {
+    bytes += encodeName(names.at(id));
+  }
+
+  QSaveFile saveFile(namesPath(filePath));
+  return saveFile.open(QIODevice::WriteOnly) &&
+         saveFile.write(bytes) == bytes.size() && saveFile.commit();
+}
+
+bool PairStats::rebuild(quint32 capacity) {
+  QByteArray bytes(int(sizeof(Header) + capacity * sizeof(Record)), '\0');
+  Header* newHeader = reinterpret_cast<Header*>(bytes.data());
+  Record* newRecords =
+      reinterpret_cast<Record*>(bytes.data() + sizeof(Header));
+  std::memcpy(newHeader->magic, pairsMagic, sizeof(pairsMagic));
+  newHeader->version = pairsVersion;
+  newHeader->capacity = capacity;
+
+  // Reinsert every pair at its slot in the larger table
+  if (data) {
+    newHeader->generation = header->generation;
+    quint32 mask = capacity - 1;
+    for (quint32 i = 0; i < header->capacity; i++) {
+      const Record& record = pairs[i];
+      if (record.low == 0) {
+        continue;
+      }
+      quint32 slot = hashKey(record.low, record.high) & mask;
+      while (newRecords[slot].low != 0) {
+        slot = (slot + 1) & mask;
+      }
+      newRecords[slot] = record;
+      newHeader->used++;
+    }
+
+    // Instances still mapping the old table remap before their next access
+    header->retired = 1;
+  }
+
+  unmap();
+
+  QSaveFile saveFile(filePath);
+  bool written = saveFile.open(QIODevice::WriteOnly) &&
+                 saveFile.write(bytes) == bytes.size() && saveFile.commit();
+  if (!written) {
+    qDebug() << "Failed to write" << QFileInfo(filePath).absoluteFilePath();
+  }
+
+  // On failure the old table is still on disk, map it again
+  file.setFileName(filePath);
+  return file.open(QIODevice::ReadWrite) && map() && written;
+}
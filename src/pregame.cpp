@@ -23,7 +23,7 @@ PreGame::PreGame(QWidget* parent) : QWidget(parent), gameBoard(nullptr) {
     this->move(x, y);
   }
 
-  users = User::instance();
+  users = User::instance()->store();
   createAccountWindow = CreateAccountWindow::getInstance();
 
   // Create pregame window UI elements manually
@@ -53,9 +53,6 @@ PreGame::PreGame(QWidget* parent) : QWidget(parent), gameBoard(nullptr) {
   // Connect start button to a slot
   connect(startButton, &QPushButton::clicked, this, &PreGame::startGame);
 
-  connect(createAccountWindow, &CreateAccountWindow::accountCreated, this,
-          &PreGame::populateUserDropdowns);
-
   // Add labels for the teams
   QLabel* redLabel = new QLabel("RED", this);
   redLabel->setStyleSheet("font-weight: bold; color: red; font-size: 24px;");
@@ -98,6 +95,16 @@ PreGame::PreGame(QWidget* parent) : QWidget(parent), gameBoard(nullptr) {
   layout->addLayout(teamsLayout);
   layout->setAlignment(teamsLayout, Qt::AlignCenter);
 
+  // Optional board code, shared by players who want the same board
+  QHBoxLayout* boardCodeLayout = new QHBoxLayout();
+  boardCodeLayout->addWidget(new QLabel("Board Code: ", this));
+  boardCodeEdit = new QLineEdit(this);
+  boardCodeEdit->setPlaceholderText("Random");
+  boardCodeEdit->setMaxLength(16);
+  boardCodeLayout->addWidget(boardCodeEdit);
+  layout->addLayout(boardCodeLayout);
+  layout->setAlignment(boardCodeLayout, Qt::AlignCenter);
+
   // Set the alignment of buttonsLayout in the main layout (center it)
   layout->addLayout(buttonsLayout);
   layout->setAlignment(buttonsLayout, Qt::AlignCenter);
@@ -112,7 +119,7 @@ PreGame::PreGame(QWidget* parent) : QWidget(parent), gameBoard(nullptr) {
   connect(gameBoard, &GameBoard::gameEnded, this, &PreGame::handleGameEnd);
   gameBoard->hide();
 
-  populateUserDropdowns();
+  bindUserDropdowns();
 
   // Button Styling
   QString buttonStyles =
@@ -140,21 +147,13 @@ PreGame::~PreGame() {
   delete gameBoard;
 }
 
-void PreGame::populateUserDropdowns() {
-  QJsonObject json = users->loadJsonFile();
-  usernames = json.keys();
-
-  redTeamSpyMasterComboBox->clear();
-  redTeamSpyMasterComboBox->addItems(usernames);
-
-  redTeamOperativeComboBox->clear();
-  redTeamOperativeComboBox->addItems(usernames);
-
-  blueTeamSpyMasterComboBox->clear();
-  blueTeamSpyMasterComboBox->addItems(usernames);
-
-  blueTeamOperativeComboBox->clear();
-  blueTeamOperativeComboBox->addItems(usernames);
+void PreGame::bindUserDropdowns() {
+  // New and renamed accounts show up without reloading the profile
+  UsernameModel* usernames = users->usernameModel();
+  redTeamSpyMasterComboBox->setModel(usernames);
+  redTeamOperativeComboBox->setModel(usernames);
+  blueTeamSpyMasterComboBox->setModel(usernames);
+  blueTeamOperativeComboBox->setModel(usernames);
 }
 
 void PreGame::goBackToMain() {
@@ -185,6 +184,19 @@ void PreGame::startGame() {
     return;
   }
 
+  // An empty code deals a random board
+  QString boardCode = boardCodeEdit->text().trimmed();
+  if (!boardCode.isEmpty()) {
+    quint32 seed;
+    if (!BoardDealer::seedFromCode(boardCode, &seed)) {
+      QMessageBox::critical(this, "Error",
+                            "Invalid board code, or it was made with a "
+                            "different word list!");
+      return;
+    }
+    gameBoard->setNextSeed(seed);
+  }
+
   gameBoard->setRedSpyMasterName(redSpyMaster);
   gameBoard->setRedOperativeName(redOperative);
   gameBoard->setBlueSpyMasterName(blueSpyMaster);
@@ -198,7 +210,6 @@ void PreGame::startGame() {
 
 void PreGame::show() {
   qDebug() << "Returning to PreGame screen";
-  populateUserDropdowns();
   QWidget::show();
   qDebug() << "Pregame shown";
 }
@@ -0,0 +1,192 @@
+/**
+ * @file profilecodec.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Reads and writes the profile in JSON or binary CBOR form
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "profilecodec.h"
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtEndian>
+
+namespace {
+
+// Encoded form of QCborKnownTags::Signature, the CBOR "magic number"
+const char cborSignature[3] = {'\xD9', '\xD9', '\xF7'};
+
+// Head of a two or three element array, then of an 8 byte unsigned integer
+const char arrayOfTwo = '\x82';
+const char arrayOfThree = '\x83';
+const char eightByteInteger = '\x1B';
+
+}  // namespace
+
+QString ProfileCodec::cborPath(const QString& jsonPath) {
+  QFileInfo info(jsonPath);
+  return info.path() + "/" + info.completeBaseName() + ".cbor";
+}
+
+QString ProfileCodec::lockPath(const QString& jsonPath) {
+  QFileInfo info(jsonPath);
+  return info.path() + "/" + info.completeBaseName() + ".lock";
+}
+
+QString ProfileCodec::checksumPath(const QString& jsonPath) {
+  QFileInfo info(jsonPath);
+  return info.path() + "/" + info.completeBaseName() + ".checksum";
+}
+
+QByteArray ProfileCodec::checksum(const QByteArray& encoded) {
+  return QCryptographicHash::hash(encoded, QCryptographicHash::Sha1).toHex();
+}
+
+bool ProfileCodec::recordChecksum(const QString& jsonPath,
+                                  const QByteArray& encoded) {
+  QSaveFile file(checksumPath(jsonPath));
+  QByteArray sum = checksum(encoded);
+  return file.open(QIODevice::WriteOnly) && file.write(sum) == sum.size() &&
+         file.commit();
+}
+
+QByteArray ProfileCodec::storedChecksum(const QString& jsonPath) {
+  QFile file(checksumPath(jsonPath));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return QByteArray();
+  }
+  return file.readAll().trimmed();
+}
+
+QString ProfileCodec::activePath(const QString& jsonPath) {
+  QString path = cborPath(jsonPath);
+  return QFile::exists(path) ? path : jsonPath;
+}
+
+ProfileCodec::Format ProfileCodec::detect(const QByteArray& data) {
+  return data.startsWith(QByteArray(cborSignature, sizeof(cborSignature)))
+             ? Cbor
+             : Json;
+}
+
+bool ProfileCodec::decode(const QByteArray& data, QJsonObject& profile,
+                          quint64* generation, JournalPositions* positions) {
+  if (generation) {
+    *generation = 0;
+  }
+  if (positions) {
+    positions->clear();
+  }
+
+  if (detect(data) == Json) {
+    QJsonDocument doc = QJsonDocument::fromJson(data);
+    if (!doc.isObject()) {
+      return false;
+    }
+    profile = doc.object();
+    return true;
+  }
+
+  QCborParserError error;
+  QCborValue value = QCborValue::fromCbor(data, &error);
+  if (error.error != QCborError::NoError) {
+    qDebug() << "Invalid CBOR profile:" << error.errorString();
+    return false;
+  }
+
+  value = value.taggedValue();  // Strip the self-describe tag
+
+  // [generation, profile, positions]
+  QCborArray array = value.toArray();
+  if (!value.isArray() || array.size() < 2 || array.size() > 3 ||
+      !array.at(0).isInteger() || !array.at(1).isMap()) {
+    return false;
+  }
+  if (generation) {
+    *generation = quint64(array.at(0).toInteger());
+  }
+  if (positions && array.size() == 3) {
+    const QCborMap map = array.at(2).toMap();
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+      positions->insert(it.key().toString(), quint64(it.value().toInteger()));
+    }
+  }
+  profile = array.at(1).toMap().toJsonObject();
+  return true;
+}
+
+quint64 ProfileCodec::readGeneration(const QString& path) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return 0;
+  }
+
+  QByteArray header = file.read(GenerationHeader);
+  QByteArray prefix(cborSignature, sizeof(cborSignature));
+  if (header.size() != GenerationHeader || !header.startsWith(prefix) ||
+      (header[3] != arrayOfTwo && header[3] != arrayOfThree) ||
+      header[4] != eightByteInteger) {
+    return 0;
+  }
+  return qFromBigEndian<quint64>(header.constData() + 5);
+}
+
+QByteArray ProfileCodec::encode(const QJsonObject& profile, Format format,
+                                quint64 generation,
+                                const JournalPositions& positions) {
+  if (format == Json) {
+    return QJsonDocument(profile).toJson(QJsonDocument::Indented);
+  }
+
+  // The header is written by hand so the generation always takes 8 bytes
+  // and sits at the same offset
+  QByteArray data(cborSignature, sizeof(cborSignature));
+  data.append(positions.isEmpty() ? arrayOfTwo : arrayOfThree);
+  data.append(eightByteInteger);
+  uchar bytes[8];
+  qToBigEndian(generation, bytes);
+  data.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+  data.append(QCborValue(QCborMap::fromJsonObject(profile)).toCbor());
+  if (!positions.isEmpty()) {
+    QCborMap map;
+    for (auto it = positions.constBegin(); it != positions.constEnd(); ++it) {
+      map.insert(it.key(), qint64(it.value()));
+    }
+    data.append(QCborValue(map).toCbor());
+  }
+  return data;
+}
+
+bool ProfileCodec::save(const QString& jsonPath, const QByteArray& encoded) {
+  QSaveFile file(cborPath(jsonPath));
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(encoded) != encoded.size() || !file.commit()) {
+    return false;
+  }
+
+  // A stale checksum only costs a scan at the next startup
+  if (!recordChecksum(jsonPath, encoded)) {
+    qDebug() << "Failed to record the profile checksum";
+  }
+
+  // Keep the old JSON profile around, but never read it again
+  if (QFile::exists(jsonPath)) {
+    QString backupPath = jsonPath + ".migrated";
+    QFile::remove(backupPath);
+    if (QFile::rename(jsonPath, backupPath)) {
+      qDebug() << "Migrated" << QFileInfo(jsonPath).absoluteFilePath()
+               << "to CBOR";
+    }
+  }
+  return true;
+}
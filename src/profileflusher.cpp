@@ -0,0 +1,324 @@
+/**
+ * @file profileflusher.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Write-behind queue that saves profile changes on a background thread
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "profileflusher.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QMutexLocker>
+
+#include "profilecodec.h"
+
+namespace {
+
+// Keep the newer position of every journal
+void mergePositions(ProfileCodec::JournalPositions& positions,
+                    const ProfileCodec::JournalPositions& newer) {
+  for (auto it = newer.constBegin(); it != newer.constEnd(); ++it) {
+    if (it.value() > positions.value(it.key())) {
+      positions.insert(it.key(), it.value());
+    }
+  }
+}
+
+// Newest journal records held by any patch of a batch
+ProfileCodec::JournalPositions batchPositions(
+    const QHash<QString, UserPatch>& batch) {
+  ProfileCodec::JournalPositions positions;
+  for (const UserPatch& patch : batch) {
+    mergePositions(positions, patch.positions());
+  }
+  return positions;
+}
+
+}  // namespace
+
+ProfileFlusher::ProfileFlusher(const QString& filePath,
+                               const QString& shardDirPath,
+                               const QList<StatsJournal*>& journals,
+                               int intervalMs)
+    : QObject(nullptr),
+      filePath(filePath),
+      shards(shardDirPath),
+      journals(journals),
+      intervalMs(intervalMs) {}
+
+void ProfileFlusher::start() {
+  timer = new QTimer(this);
+  timer->setInterval(intervalMs);
+  connect(timer, &QTimer::timeout, this, &ProfileFlusher::flush);
+  timer->start();
+}
+
+void ProfileFlusher::setFlushInterval(int intervalMs) {
+  this->intervalMs = intervalMs;
+  if (timer) {
+    timer->setInterval(intervalMs);
+  }
+}
+
+void ProfileFlusher::enqueue(const QString& username,
+                             const UserPatch& patch) {
+  QMutexLocker locker(&mutex);
+  auto queued = pending.find(username);
+  if (queued != pending.end()) {
+    queued->merge(patch);
+    stats.coalescedUpdates++;
+  } else {
+    pending.insert(username, patch);
+  }
+  stats.queuedUpdates++;
+  stats.queueDepth = pending.size();
+}
+
+void ProfileFlusher::enqueue(const QHash<QString, UserPatch>& patches) {
+  QMutexLocker locker(&mutex);
+  for (auto it = patches.constBegin(); it != patches.constEnd(); ++it) {
+    auto queued = pending.find(it.key());
+    if (queued != pending.end()) {
+      queued->merge(it.value());
+      stats.coalescedUpdates++;
+    } else {
+      pending.insert(it.key(), it.value());
+    }
+  }
+  stats.queuedUpdates += patches.size();
+  stats.queueDepth = pending.size();
+}
+
+QHash<QString, UserPatch> ProfileFlusher::pendingPatches() const {
+  QMutexLocker locker(&mutex);
+  QHash<QString, UserPatch> patches = inFlight;
+  for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+    auto written = patches.find(it.key());
+    if (written != patches.end()) {
+      written->merge(it.value());  // Newer than the in-flight patch
+    } else {
+      patches.insert(it.key(), it.value());
+    }
+  }
+  return patches;
+}
+
+bool ProfileFlusher::isOwnWrite(qint64 size, const QDateTime& modified) const {
+  QMutexLocker locker(&mutex);
+  return size == lastWriteSize && modified == lastWriteTime;
+}
+
+bool ProfileFlusher::isOwnGeneration(quint64 generation) const {
+  QMutexLocker locker(&mutex);
+  return generation != 0 && generation == lastWriteGeneration &&
+         !lastWriteForeign;
+}
+
+FlushCounters ProfileFlusher::counters() const {
+  QMutexLocker locker(&mutex);
+  return stats;
+}
+
+bool ProfileFlusher::refreshBaseDocument(bool& foreign) {
+  foreign = false;
+  QString path = ProfileCodec::activePath(filePath);
+  if (!QFileInfo::exists(path)) {
+    baseValid = false;
+    return false;
+  }
+
+  // Skip the read when the file is still the generation we wrote
+  quint64 generation = ProfileCodec::readGeneration(path);
+  if (baseValid && generation != 0 && generation == baseGeneration) {
+    return true;
+  }
+
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    baseValid = false;
+    return false;
+  }
+
+  QByteArray data = file.readAll();
+  file.close();
+
+  QJsonObject document;
+  ProfileCodec::JournalPositions positions;
+  if (!ProfileCodec::decode(data, document, &generation, &positions)) {
+    baseValid = false;
+    return false;
+  }
+
+  // Read from disk, so it may hold changes the readers have not seen
+  foreign = true;
+  baseDocument = document;
+  basePositions = positions;
+  baseGeneration = generation;
+  baseValid = true;
+  return true;
+}
+
+bool ProfileFlusher::writeSnapshot(const QHash<QString, UserPatch>& batch) {
+  // Applied to the current file so changes made by others are kept
+  bool foreign = false;
+  if (!refreshBaseDocument(foreign)) {
+    return false;
+  }
+
+  for (auto it = batch.constBegin(); it != batch.constEnd(); ++it) {
+    QJsonValue entry =
+        it.value().apply(baseDocument.value(it.key()), basePositions);
+    if (entry.isObject()) {
+      baseDocument.insert(it.key(), entry);
+    }
+  }
+
+  // The snapshot says what it contains, so a crash before the compaction
+  // does not replay those records
+  mergePositions(basePositions, batchPositions(batch));
+
+  quint64 generation = baseGeneration + 1;
+  QByteArray snapshot = ProfileCodec::encode(baseDocument, ProfileCodec::Cbor,
+                                             generation, basePositions);
+
+  if (!ProfileCodec::save(filePath, snapshot)) {
+    baseValid = false;  // baseDocument no longer matches the disk
+    return false;
+  }
+  baseGeneration = generation;
+
+  QMutexLocker locker(&mutex);
+  lastWriteGeneration = generation;
+  lastWriteForeign = foreign;
+  return true;
+}
+
+bool ProfileFlusher::refreshBaseIndex() {
+  // Always re-read under the lock, a stamp check can miss a write made by
+  // another instance within the same second
+  QStringList usernames;
+  if (!shards.readIndex(usernames)) {
+    return false;
+  }
+
+  baseIndex = usernames;
+  baseIndexSet.clear();
+  for (const QString& username : usernames) {
+    baseIndexSet.insert(username);
+  }
+  return true;
+}
+
+bool ProfileFlusher::writeShards(const QHash<QString, UserPatch>& batch) {
+  if (!refreshBaseIndex()) {
+    return false;
+  }
+
+  // User files first, so the index never lists a user without a file. Each
+  // file is re-read under the lock and records the journal positions it
+  // contains for replay.
+  bool indexChanged = false;
+  for (auto it = batch.constBegin(); it != batch.constEnd(); ++it) {
+    QJsonObject stored;
+    ProfileCodec::JournalPositions positions;
+    bool listed = baseIndexSet.contains(it.key());
+    bool exists = listed && QFileInfo::exists(shards.userPath(it.key()));
+    if (exists && !shards.readUser(it.key(), stored, &positions)) {
+      return false;  // Retried, rather than writing over the user
+    }
+
+    QJsonValue entry = it.value().apply(
+        exists ? QJsonValue(stored) : QJsonValue(QJsonValue::Undefined),
+        positions);
+    if (!entry.isObject()) {
+      continue;
+    }
+    mergePositions(positions, it.value().positions());
+    if (!shards.writeUser(it.key(), entry.toObject(), positions)) {
+      return false;
+    }
+    if (!listed) {
+      baseIndex.append(it.key());
+      baseIndexSet.insert(it.key());
+      indexChanged = true;
+    }
+  }
+
+  return !indexChanged || shards.writeIndex(baseIndex);
+}
+
+void ProfileFlusher::flush() {
+  QHash<QString, UserPatch> batch;
+  {
+    QMutexLocker locker(&mutex);
+    if (pending.isEmpty()) {
+      return;
+    }
+    batch.swap(pending);
+    inFlight = batch;
+    stats.queueDepth = 0;
+  }
+
+  QElapsedTimer elapsed;
+  elapsed.start();
+
+  // Serialise with writers in other processes from read to replace
+  bool sharded = shards.isEnabled();
+  bool written = false;
+  {
+    QLockFile lock(ProfileCodec::lockPath(filePath));
+    if (lock.tryLock(ProfileCodec::LockTimeoutMs)) {
+      written = sharded ? writeShards(batch) : writeSnapshot(batch);
+    } else {
+      qDebug() << "Timed out waiting for the profile lock";
+    }
+  }
+
+  qint64 latencyUs = elapsed.nsecsElapsed() / 1000;
+  QFileInfo info(sharded ? shards.indexPath()
+                         : ProfileCodec::cborPath(filePath));
+
+  QMutexLocker locker(&mutex);
+  if (!written) {
+    // Put the batch back in front of anything queued meanwhile
+    for (auto it = batch.begin(); it != batch.end(); ++it) {
+      auto queued = pending.constFind(it.key());
+      if (queued != pending.constEnd()) {
+        it->merge(queued.value());
+      }
+      pending.insert(it.key(), it.value());
+    }
+    inFlight.clear();
+    stats.queueDepth = pending.size();
+    stats.failedFlushes++;
+    locker.unlock();
+
+    qDebug() << "Failed to flush profile to" << info.absoluteFilePath();
+    emit flushFailed("Error: Could not write to profile.json");
+    return;
+  }
+
+  lastWriteTime = info.lastModified();
+  lastWriteSize = info.size();
+  inFlight.clear();
+  stats.flushes++;
+  stats.lastFlushLatencyUs = latencyUs;
+  stats.maxFlushLatencyUs = std::max(stats.maxFlushLatencyUs, latencyUs);
+  locker.unlock();
+
+  // The profile now holds every journal record of the batch, and every
+  // older record was in an earlier batch
+  ProfileCodec::JournalPositions flushedPositions = batchPositions(batch);
+  for (StatsJournal* journal : journals) {
+    quint64 seq = flushedPositions.value(journal->name());
+    if (seq > 0) {
+      journal->compact(seq);
+    }
+  }
+}
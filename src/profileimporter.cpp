@@ -0,0 +1,275 @@
+/**
+ * @file profileimporter.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Streams the users of a profile dump in fixed-size batches
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "profileimporter.h"
+
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+
+#include "profilecodec.h"
+
+namespace {
+
+// Decode one raw JSON value, wrapped so scalars parse too
+bool parseJsonValue(const QByteArray& raw, QJsonValue& value) {
+  QJsonDocument doc = QJsonDocument::fromJson("[" + raw + "]");
+  if (!doc.isArray() || doc.array().size() != 1) {
+    return false;
+  }
+  value = doc.array().at(0);
+  return true;
+}
+
+quint32 readCounter(const QJsonObject& statistics, const char* key) {
+  return quint32(std::max(statistics[key].toInt(), 0));
+}
+
+}  // namespace
+
+ProfileImporter::ProfileImporter(const QString& dumpPath, int batchSize)
+    : file(dumpPath), batchSize(std::max(batchSize, 1)) {}
+
+quint64 ProfileImporter::usersRead() const { return readCount; }
+
+quint64 ProfileImporter::usersSkipped() const { return skippedCount; }
+
+QString ProfileImporter::errorString() const { return error; }
+
+bool ProfileImporter::run(const BatchHandler& handler) {
+  this->handler = handler;
+  error.clear();
+  batch.clear();
+  buffer.clear();
+  bufferPos = 0;
+  readCount = 0;
+  skippedCount = 0;
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    return fail("could not open " + file.fileName());
+  }
+
+  // Only the first bytes are needed to tell the formats apart
+  bool ok = ProfileCodec::detect(file.peek(3)) == ProfileCodec::Cbor
+                ? runCbor()
+                : runJson();
+  file.close();
+
+  batch.clear();
+  buffer.clear();
+  return ok;
+}
+
+bool ProfileImporter::runJson() {
+  if (nextToken() != '{') {
+    return fail("the dump is not a profile object");
+  }
+
+  int c = nextToken();
+  if (c == '}') {
+    return nextToken() == -1 ? flushBatch() : fail("data after the profile");
+  }
+
+  QByteArray raw;
+  while (true) {
+    if (c != '"') {
+      return fail("expected a username");
+    }
+    raw.clear();
+    QJsonValue key;
+    if (!readJsonString(raw) || !parseJsonValue(raw, key)) {
+      return fail("malformed username");
+    }
+    QString username = key.toString();
+    if (nextToken() != ':') {
+      return fail("expected ':' after " + username);
+    }
+
+    // Only this user's bytes are held, then decoded on their own
+    raw.clear();
+    int terminator = 0;
+    QJsonValue value;
+    if (!readJsonValue(raw, terminator) || !parseJsonValue(raw, value)) {
+      return fail("malformed user " + username);
+    }
+    if (!addUser(username, value.toObject())) {
+      return false;
+    }
+
+    if (terminator == '}') {
+      break;
+    }
+    c = nextToken();
+  }
+
+  if (nextToken() != -1) {
+    return fail("data after the profile");
+  }
+  return flushBatch();
+}
+
+bool ProfileImporter::runCbor() {
+  QCborStreamReader reader(&file);
+
+  // The self-describe tag, then the array holding the generation first
+  if (reader.isTag() && reader.toTag() == QCborKnownTags::Signature) {
+    reader.next();
+  }
+  if (!reader.isArray() || !reader.enterContainer() ||
+      !reader.isUnsignedInteger()) {
+    return fail("malformed profile header");
+  }
+  reader.next();
+  if (!reader.isMap() || !reader.enterContainer()) {
+    return fail("the dump is not a profile map");
+  }
+
+  while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+    if (!reader.isString()) {
+      return fail("expected a username");
+    }
+    QString username;
+    auto chunk = reader.readString();
+    while (chunk.status == QCborStreamReader::Ok) {
+      username += chunk.data;
+      chunk = reader.readString();
+    }
+    if (chunk.status == QCborStreamReader::Error) {
+      return fail("malformed username");
+    }
+
+    // One map entry at a time, the rest of the dump stays on disk
+    QCborValue value = QCborValue::fromCbor(reader);
+    if (reader.lastError() != QCborError::NoError) {
+      break;
+    }
+    if (!addUser(username, value.toJsonValue().toObject())) {
+      return false;
+    }
+  }
+
+  if (reader.lastError() != QCborError::NoError) {
+    return fail(reader.lastError().toString());
+  }
+  return flushBatch();
+}
+
+int ProfileImporter::nextByte() {
+  if (bufferPos >= buffer.size()) {
+    buffer.resize(ReadChunk);
+    qint64 count = file.read(buffer.data(), ReadChunk);
+    buffer.resize(int(std::max<qint64>(count, 0)));
+    bufferPos = 0;
+    if (buffer.isEmpty()) {
+      return -1;
+    }
+  }
+  return uchar(buffer[bufferPos++]);
+}
+
+int ProfileImporter::nextToken() {
+  int c = nextByte();
+  while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+    c = nextByte();
+  }
+  return c;
+}
+
+bool ProfileImporter::readJsonString(QByteArray& raw) {
+  raw.append('"');
+  while (raw.size() <= MaxUserBytes) {
+    int c = nextByte();
+    if (c == -1) {
+      return fail("the dump ends inside a string");
+    }
+    raw.append(char(c));
+
+    // An escaped character never ends the string
+    if (c == '\\') {
+      c = nextByte();
+      if (c == -1) {
+        return fail("the dump ends inside a string");
+      }
+      raw.append(char(c));
+    } else if (c == '"') {
+      return true;
+    }
+  }
+  return fail("a user is larger than the import limit");
+}
+
+bool ProfileImporter::readJsonValue(QByteArray& raw, int& terminator) {
+  int depth = 0;
+  while (raw.size() <= MaxUserBytes) {
+    int c = nextByte();
+    if (c == -1) {
+      return fail("the dump ends inside a user");
+    }
+    if (c == '"') {
+      if (!readJsonString(raw)) {
+        return false;
+      }
+      continue;
+    }
+
+    // Brackets inside strings were consumed above, so depth is exact
+    if (depth == 0 && (c == ',' || c == '}')) {
+      terminator = c;
+      return true;
+    }
+    if (c == '{' || c == '[') {
+      depth++;
+    } else if (c == '}' || c == ']') {
+      depth--;
+    }
+    raw.append(char(c));
+  }
+  return fail("a user is larger than the import limit");
+}
+
+bool ProfileImporter::addUser(const QString& username,
+                              const QJsonObject& user) {
+  if (!user["statistics"].isObject()) {
+    skippedCount++;
+    return true;
+  }
+
+  QJsonObject statistics = user["statistics"].toObject();
+  StatsCounters& counters = batch[username];
+  counters.gamesPlayed += readCounter(statistics, "games_played");
+  counters.gamesWin += readCounter(statistics, "games_win");
+  counters.guessTotal += readCounter(statistics, "guess_total");
+  counters.guessHit += readCounter(statistics, "guess_hit");
+  readCount++;
+
+  if (batch.size() >= batchSize) {
+    return flushBatch();
+  }
+  return true;
+}
+
+bool ProfileImporter::flushBatch() {
+  if (batch.isEmpty()) {
+    return true;
+  }
+
+  bool accepted = handler(batch);
+  batch.clear();
+  return accepted ? true : fail("the import was stopped");
+}
+
+bool ProfileImporter::fail(const QString& message) {
+  if (error.isEmpty()) {
+    error = message;
+  }
+  return false;
+}
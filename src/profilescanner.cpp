@@ -0,0 +1,219 @@
+/**
+ * @file profilescanner.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Checks, repairs and compacts the profile in the background
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "profilescanner.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QLockFile>
+#include <QSaveFile>
+#include <climits>
+#include <cmath>
+
+#include "profilecodec.h"
+
+namespace {
+
+const char* const counterKeys[] = {"games_played", "games_win", "guess_total",
+                                   "guess_hit"};
+
+bool readFile(const QString& path, QByteArray& data) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  data = file.readAll();
+  return true;
+}
+
+// A counter as the getters read it, clamped to a non-negative integer
+int repairedCounter(const QJsonValue& value) {
+  if (!value.isDouble()) {
+    return 0;
+  }
+  double number = std::floor(value.toDouble());
+  if (number < 0 || std::isnan(number)) {
+    return 0;
+  }
+  return number > INT_MAX ? INT_MAX : int(number);
+}
+
+}  // namespace
+
+ProfileScanner::ProfileScanner(const QString& jsonPath) : jsonPath(jsonPath) {}
+
+QString ProfileScanner::quarantinePath(const QString& jsonPath) {
+  QFileInfo info(jsonPath);
+  return info.path() + "/" + info.completeBaseName() + ".quarantine.json";
+}
+
+ProfileScanner::Report ProfileScanner::run() {
+  Report report;
+  QByteArray data;
+  if (!QFile::exists(ProfileCodec::activePath(jsonPath))) {
+    report.skipped = true;  // Nothing to check before the first account
+    return report;
+  }
+
+  // The common case: unchanged since our last save, no lock, no decode
+  QByteArray stored = ProfileCodec::storedChecksum(jsonPath);
+  if (!readFile(ProfileCodec::activePath(jsonPath), data)) {
+    report.error = "could not read the profile";
+    return report;
+  }
+  if (!stored.isEmpty() && stored == ProfileCodec::checksum(data)) {
+    report.skipped = true;
+    return report;
+  }
+
+  QLockFile lock(ProfileCodec::lockPath(jsonPath));
+  if (!lock.tryLock(ProfileCodec::LockTimeoutMs)) {
+    report.error = "timed out waiting for the profile lock";
+    return report;
+  }
+
+  // Another writer may have saved since, check what is on disk now
+  QString path = ProfileCodec::activePath(jsonPath);
+  if (!readFile(path, data)) {
+    report.error = "could not read the profile";
+    return report;
+  }
+  stored = ProfileCodec::storedChecksum(jsonPath);
+  if (!stored.isEmpty() && stored == ProfileCodec::checksum(data)) {
+    report.skipped = true;
+    return report;
+  }
+
+  QJsonObject profile;
+  quint64 generation = 0;
+  ProfileCodec::JournalPositions positions;
+  if (!ProfileCodec::decode(data, profile, &generation, &positions)) {
+    // Nothing can be saved from it here, keep a copy for a manual repair
+    QString copyPath =
+        path + ".corrupt-" + QString::number(QDateTime::currentMSecsSinceEpoch());
+    QFile::copy(path, copyPath);
+    report.error = "the profile does not decode, copied to " + copyPath;
+    return report;
+  }
+
+  QJsonObject bad;
+  for (auto it = profile.begin(); it != profile.end();) {
+    report.users++;
+    QJsonObject entry = it.value().toObject();
+    bool repaired = false;
+    if (!it.value().isObject() || !checkEntry(it.key(), entry, repaired)) {
+      bad.insert(it.key(), it.value());
+      it = profile.erase(it);
+      continue;
+    }
+    if (repaired) {
+      *it = entry;
+      report.repaired.append(it.key());
+    }
+    ++it;
+  }
+  report.quarantined = bad.size();
+
+  // Entries are only dropped once they are safe in the quarantine
+  if (!bad.isEmpty() && !quarantine(bad)) {
+    report.error = "could not write " + quarantinePath(jsonPath);
+    return report;
+  }
+
+  // Clean and already compact, the checksum lets the next startup skip
+  bool compact =
+      ProfileCodec::detect(data) == ProfileCodec::Cbor && generation != 0;
+  if (bad.isEmpty() && report.repaired.isEmpty() && compact) {
+    if (!ProfileCodec::recordChecksum(jsonPath, data)) {
+      report.error = "could not record the profile checksum";
+    }
+    return report;
+  }
+
+  // The rewrite holds every journal record the old file held
+  QByteArray encoded = ProfileCodec::encode(profile, ProfileCodec::Cbor,
+                                            generation + 1, positions);
+
+  if (!ProfileCodec::save(jsonPath, encoded)) {
+    report.error = "could not write the profile";
+    return report;
+  }
+  report.rewritten = true;
+  return report;
+}
+
+bool ProfileScanner::checkEntry(const QString& username, QJsonObject& entry,
+                                bool& repaired) {
+  if (username.isEmpty()) {
+    return false;  // Cannot be logged in to or looked up
+  }
+
+  if (entry["user_name"].toString() != username) {
+    entry["user_name"] = username;
+    repaired = true;
+  }
+
+  // Counters the getters would misread are reset to what they would show
+  QJsonObject statistics = entry["statistics"].toObject();
+  if (!entry["statistics"].isObject()) {
+    repaired = true;
+  }
+  for (const char* key : counterKeys) {
+    int counter = repairedCounter(statistics[key]);
+    if (!statistics[key].isDouble() || statistics[key].toDouble() != counter) {
+      statistics[key] = counter;
+      repaired = true;
+    }
+  }
+
+  // A rate above 100% can only come from a damaged entry
+  if (statistics["games_win"].toInt() > statistics["games_played"].toInt()) {
+    statistics["games_win"] = statistics["games_played"].toInt();
+    repaired = true;
+  }
+  if (statistics["guess_hit"].toInt() > statistics["guess_total"].toInt()) {
+    statistics["guess_hit"] = statistics["guess_total"].toInt();
+    repaired = true;
+  }
+
+  if (repaired) {
+    entry["statistics"] = statistics;
+  }
+  return true;
+}
+
+bool ProfileScanner::quarantine(const QJsonObject& entries) {
+  QString path = quarantinePath(jsonPath);
+  QJsonObject kept;
+  QByteArray existing;
+  if (readFile(path, existing)) {
+    kept = QJsonDocument::fromJson(existing).object();
+  }
+
+  // Never overwrite an entry quarantined by an earlier scan
+  QString stamp = QString::number(QDateTime::currentMSecsSinceEpoch());
+  for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+    QString key = kept.contains(it.key()) ? it.key() + "@" + stamp : it.key();
+    kept.insert(key, it.value());
+  }
+
+  QByteArray json = QJsonDocument(kept).toJson(QJsonDocument::Compact);
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size() ||
+      !file.commit()) {
+    return false;
+  }
+  qDebug() << "Quarantined" << entries.size() << "profile entries in"
+           << QFileInfo(path).absoluteFilePath();
+  return true;
+}
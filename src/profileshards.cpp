@@ -0,0 +1,119 @@
+/**
+ * @file profileshards.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Optional profile layout with one small file per user
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "profileshards.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+namespace {
+
+// Where user files kept their journal position before it moved to the
+// header, always the position of the first journal
+const char journalSeqKey[] = "journal_seq";
+const char legacyJournal[] = "profile.journal";
+
+}  // namespace
+
+ProfileShards::ProfileShards(const QString& dirPath) : dirPath(dirPath) {}
+
+bool ProfileShards::isEnabled() const { return QFile::exists(indexPath()); }
+
+QString ProfileShards::indexPath() const { return dirPath + "/index"; }
+
+QString ProfileShards::userPath(const QString& username) const {
+  // Hex keeps any username a valid, case-sensitive file name
+  return dirPath + "/" + QString::fromLatin1(username.toUtf8().toHex()) +
+         ".cbor";
+}
+
+bool ProfileShards::readIndex(QStringList& usernames) const {
+  QFile file(indexPath());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  usernames.clear();
+  while (!file.atEnd()) {
+    QString username = QString::fromUtf8(file.readLine()).trimmed();
+    if (!username.isEmpty()) {
+      usernames.append(username);
+    }
+  }
+  return true;
+}
+
+bool ProfileShards::writeIndex(const QStringList& usernames) const {
+  QByteArray data;
+  for (const QString& username : usernames) {
+    data += username.toUtf8();
+    data += '\n';
+  }
+
+  QSaveFile file(indexPath());
+  return file.open(QIODevice::WriteOnly) &&
+         file.write(data) == data.size() && file.commit();
+}
+
+bool ProfileShards::readUser(const QString& username, QJsonObject& userObject,
+                             ProfileCodec::JournalPositions* positions) const {
+  QFile file(userPath(username));
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  QJsonObject stored;
+  if (!ProfileCodec::decode(file.readAll(), stored, nullptr, positions)) {
+    qDebug() << "Invalid profile file for user:" << username;
+    return false;
+  }
+
+  if (positions && stored.contains(journalSeqKey)) {
+    positions->insert(legacyJournal,
+                      quint64(stored.value(journalSeqKey).toDouble()));
+  }
+  stored.remove(journalSeqKey);
+  userObject = stored;
+  return true;
+}
+
+bool ProfileShards::writeUser(
+    const QString& username, const QJsonObject& userObject,
+    const ProfileCodec::JournalPositions& positions) const {
+  QByteArray data =
+      ProfileCodec::encode(userObject, ProfileCodec::Cbor, 0, positions);
+
+  QSaveFile file(userPath(username));
+  return file.open(QIODevice::WriteOnly) &&
+         file.write(data) == data.size() && file.commit();
+}
+
+bool ProfileShards::removeUser(const QString& username) const {
+  QString path = userPath(username);
+  return !QFile::exists(path) || QFile::remove(path);
+}
+
+bool ProfileShards::create(
+    const QJsonObject& profile,
+    const ProfileCodec::JournalPositions& positions) const {
+  if (!QDir().mkpath(dirPath)) {
+    return false;
+  }
+
+  for (auto it = profile.constBegin(); it != profile.constEnd(); ++it) {
+    if (!writeUser(it.key(), it.value().toObject(), positions)) {
+      qDebug() << "Failed to write profile file for user:" << it.key();
+      return false;
+    }
+  }
+  return writeIndex(profile.keys());
+}
@@ -0,0 +1,1685 @@
+/**
+ * @file profilestore.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Headless store of user profiles, statistics and game records
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "profilestore.h"
+
+#include <QtConcurrent>
+
+namespace {
+
+void addCounters(UserStats& stats, const UserStats& delta) {
+  stats.gamesPlayed += delta.gamesPlayed;
+  stats.gamesWin += delta.gamesWin;
+  stats.guessTotal += delta.guessTotal;
+  stats.guessHit += delta.guessHit;
+}
+
+bool sameCounters(const UserStats& a, const UserStats& b) {
+  return a.gamesPlayed == b.gamesPlayed && a.gamesWin == b.gamesWin &&
+         a.guessTotal == b.guessTotal && a.guessHit == b.guessHit;
+}
+
+// Read one role's rating from the "ratings" object of a user
+Rating ratingFromJson(const QJsonValue& value, const Rating& initial) {
+  if (!value.isObject()) {
+    return initial;
+  }
+
+  QJsonObject object = value.toObject();
+  Rating rating;
+  rating.rating = object["rating"].toDouble(initial.rating);
+  rating.deviation = object["deviation"].toDouble(initial.deviation);
+  rating.games = quint32(object["games"].toInt());
+  rating.lastPlayed = qint64(object["last_played"].toDouble());
+  return rating;
+}
+
+QJsonObject ratingToJson(const Rating& rating) {
+  QJsonObject object;
+  object["rating"] = rating.rating;
+  object["deviation"] = rating.deviation;
+  object["games"] = (int)rating.games;
+  object["last_played"] = double(rating.lastPlayed);
+  return object;
+}
+
+// The "ratings" object of a user
+QJsonObject ratingsToJson(const PlayerRatings& ratings) {
+  QJsonObject object;
+  object["spymaster"] = ratingToJson(ratings.spymaster);
+  object["operative"] = ratingToJson(ratings.operative);
+  return object;
+}
+
+// Counter fields of "role_statistics", by role object
+const char* const roleNames[] = {"spymaster", "operative"};
+
+struct RoleField {
+  int role;  ///< index into roleNames
+  const char* key;
+  unsigned int RoleStats::*counter;
+};
+
+const RoleField roleFields[] = {
+    {0, "clues_given", &RoleStats::cluesGiven},
+    {0, "numbered_clues", &RoleStats::numberedClues},
+    {0, "clue_words", &RoleStats::clueWords},
+    {0, "clues_solved", &RoleStats::cluesSolved},
+    {0, "assassins_caused", &RoleStats::assassinsCaused},
+    {1, "clues_received", &RoleStats::cluesReceived},
+    {1, "correct_guesses", &RoleStats::correctGuesses},
+    {1, "bonus_guesses", &RoleStats::bonusGuesses},
+    {1, "neutral_guesses", &RoleStats::neutralGuesses},
+    {1, "opponent_guesses", &RoleStats::opponentGuesses},
+    {1, "assassin_guesses", &RoleStats::assassinGuesses},
+};
+
+RoleStats roleStatsFromJson(const QJsonValue& value) {
+  QJsonObject roles[2] = {value.toObject()[roleNames[0]].toObject(),
+                          value.toObject()[roleNames[1]].toObject()};
+  RoleStats stats;
+  for (const RoleField& field : roleFields) {
+    stats.*field.counter = std::max(roles[field.role][field.key].toInt(), 0);
+  }
+  return stats;
+}
+
+QJsonObject roleStatsToJson(const RoleStats& stats) {
+  QJsonObject roles[2];
+  for (const RoleField& field : roleFields) {
+    roles[field.role][field.key] = (int)(stats.*field.counter);
+  }
+  QJsonObject object;
+  object[roleNames[0]] = roles[0];
+  object[roleNames[1]] = roles[1];
+  return object;
+}
+
+// The initial rating of a role, as patch defaults for a rating change
+QJsonObject ratingDefaults(int role, const Rating& initial) {
+  QJsonObject ratings;
+  ratings[roleNames[role]] = ratingToJson(initial);
+  QJsonObject defaults;
+  defaults["ratings"] = ratings;
+  return defaults;
+}
+
+// Role of a rating journal field, as an index into roleNames
+int ratingRole(StatsJournal::Field field) {
+  return (field - StatsJournal::SpymasterRating) / 3;
+}
+
+// Fill a snapshot and its rates, stats may be null for an unknown user
+StatsSnapshot makeSnapshot(const QString& username, const UserStats* stats) {
+  StatsSnapshot snapshot;
+  snapshot.username = username;
+  if (!stats) {
+    return snapshot;
+  }
+
+  snapshot.found = true;
+  snapshot.counters = *stats;
+  if (stats->gamesPlayed > 0) {
+    snapshot.winRate = (float)stats->gamesWin / (float)stats->gamesPlayed;
+  }
+  if (stats->guessTotal > 0) {
+    snapshot.hitRate = (float)stats->guessHit / (float)stats->guessTotal;
+  }
+  return snapshot;
+}
+
+// Build the entry of a new user, keeping the statistics of an existing one
+QJsonObject makeUserObject(const QString& username,
+                           const QJsonObject& existing) {
+  QJsonObject userObject = existing;
+  QJsonObject statistics;
+  if (userObject.contains("statistics")) {
+    statistics =
+        userObject["statistics"].toObject();  // Preserve existing statistics
+  }
+
+  // Initialize statistics if they don't exist
+  if (statistics.isEmpty()) {
+    statistics["games_played"] = 0;
+    statistics["games_win"] = 0;
+    statistics["guess_total"] = 0;
+    statistics["guess_hit"] = 0;
+  }
+
+  // Update user object
+  userObject["user_name"] = username;
+  userObject["statistics"] = statistics;
+  return userObject;
+}
+
+}  // namespace
+
+ProfileStore::ProfileStore(const QString& dirPath, QObject* parent)
+    : QObject(parent),
+      jsonFilePath(dirPath + "/profile.json"),
+      statsBucketsFilePath(dirPath + "/stats.buckets"),
+      statsTableFilePath(dirPath + "/stats.table"),
+      pairStatsFilePath(dirPath + "/stats.pairs"),
+      shardDirPath(dirPath + "/profiles"),
+      journalFilePath(dirPath + "/profile.journal"),
+      historyDirPath(dirPath + "/history") {
+  // Stat changes are journaled first, so a crash never loses them. Each
+  // instance appends to the first free journal; free journals holding
+  // records, left by an instance that crashed, are adopted and replayed.
+  statsJournal = nullptr;
+  for (int slot = 0; slot < StatsJournal::MaxSlots; slot++) {
+    QString path = StatsJournal::slotPath(journalFilePath, slot);
+    if (statsJournal && !QFileInfo::exists(path)) {
+      continue;
+    }
+    StatsJournal* journal = new StatsJournal(path);
+    if (!journal->open()) {
+      delete journal;  // In use by another instance
+    } else if (!statsJournal) {
+      statsJournal = journal;
+    } else if (!journal->eventsAfter(0).isEmpty()) {
+      adoptedJournals.append(journal);
+    } else {
+      delete journal;
+    }
+  }
+  if (!statsJournal) {
+    qDebug() << "Statistics journal unavailable, updates are not crash-safe";
+    statsJournal = new StatsJournal(journalFilePath);
+  }
+
+  // Counters are changed in place in a mapped table of this instance's
+  // own, the journal is what makes those changes durable
+  statsTable = nullptr;
+  for (int slot = 0; slot < StatsJournal::MaxSlots && !statsTable; slot++) {
+    StatsTable* table =
+        new StatsTable(StatsJournal::slotPath(statsTableFilePath, slot));
+    if (table->open()) {
+      statsTable = table;
+    } else {
+      delete table;  // In use by another instance
+    }
+  }
+  if (!statsTable) {
+    QString privatePath =
+        QDir::temp().filePath(QString("codenames-%1.table")
+                                  .arg(QCoreApplication::applicationPid()));
+    qDebug() << "Every statistics table is in use, using" << privatePath;
+    statsTable = new StatsTable(privatePath);
+    statsTable->open();
+  }
+
+  // Daily counters roll over on their own, one ring of days per user
+  statsBuckets = new StatsBuckets(statsBucketsFilePath);
+  if (!statsBuckets->open()) {
+    qDebug() << "Statistics buckets unavailable, recent statistics are empty";
+  }
+
+  // Pairs of players, updated once per finished game
+  pairStats = new PairStats(pairStatsFilePath);
+  if (!pairStats->open()) {
+    qDebug() << "Pair statistics unavailable, partners are not tracked";
+  }
+
+  // Finished games are appended here, analytics scan it by column
+  history = new MatchHistory(historyDirPath);
+  if (!history->open()) {
+    qDebug() << "Match history unavailable, games are not recorded";
+  }
+
+  // Optional per-user layout, used once its index exists
+  profileShards = new ProfileShards(shardDirPath);
+
+  // Profile writes are queued and flushed by a background thread
+  profileFlusher = new ProfileFlusher(jsonFilePath, shardDirPath,
+                                      QList<StatsJournal*>{statsJournal} +
+                                          adoptedJournals);
+  profileFlusherThread = new QThread(this);
+  profileFlusher->moveToThread(profileFlusherThread);
+  connect(profileFlusherThread, &QThread::started, profileFlusher,
+          &ProfileFlusher::start);
+  connect(profileFlusherThread, &QThread::finished, profileFlusher,
+          &QObject::deleteLater);
+  connect(profileFlusher, &ProfileFlusher::flushFailed, this,
+          &ProfileStore::statusMessage);
+  connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this,
+          &ProfileStore::shutdownProfileFlusher);
+  profileFlusherThread->start();
+
+  if (QCoreApplication::arguments().contains("--sharded-profiles")) {
+    enableShardedProfiles();
+  }
+
+  // Changes a crash kept out of the profile, before the scan can rewrite it
+  replayStatsJournal();
+
+  // Watch the profile so edits made outside this class invalidate the cache
+  profileWatcher = new QFileSystemWatcher(this);
+  watchProfileFile();
+  connect(profileWatcher, &QFileSystemWatcher::fileChanged, this,
+          &ProfileStore::onProfileFileChanged);
+  connect(profileWatcher, &QFileSystemWatcher::directoryChanged, this,
+          &ProfileStore::onProfileFileChanged);
+
+  // Check the profile on a worker thread, the windows show meanwhile. The
+  // sharded layout has no single file to check.
+  if (!profileShards->isEnabled()) {
+    profileScanWatcher = new QFutureWatcher<ProfileScanner::Report>(this);
+    connect(profileScanWatcher,
+            &QFutureWatcher<ProfileScanner::Report>::finished, this,
+            &ProfileStore::onProfileScanned);
+    QString scannedPath = jsonFilePath;
+    profileScanWatcher->setFuture(QtConcurrent::run(
+        [scannedPath]() { return ProfileScanner(scannedPath).run(); }));
+  }
+
+  // Load usernames once, afterwards the model is updated incrementally
+  usernameListModel = new UsernameModel(this);
+  usernameListModel->setUsernames(loadUsernames());
+
+  // Built when first asked for
+  rankings = new Leaderboard();
+
+  if (QCoreApplication::arguments().contains("--recompute-ratings")) {
+    recomputeRatings();
+  }
+}
+
+UsernameModel* ProfileStore::usernameModel() const {
+  return usernameListModel;
+}
+
+ProfileStore::~ProfileStore() {
+  shutdownProfileFlusher();
+  delete statsJournal;
+  qDeleteAll(adoptedJournals);
+  delete statsTable;
+  delete profileShards;
+  delete statsBuckets;
+  delete pairStats;
+  delete rankings;
+  delete history;
+}
+
+void ProfileStore::shutdownProfileFlusher() {
+  if (!profileFlusherThread->isRunning()) {
+    return;
+  }
+
+  // Block until every queued change is on disk
+  QMetaObject::invokeMethod(profileFlusher, "flush",
+                            Qt::BlockingQueuedConnection);
+  profileFlusherThread->quit();
+  profileFlusherThread->wait();
+}
+
+void ProfileStore::setProfileFlushInterval(int intervalMs) {
+  QMetaObject::invokeMethod(profileFlusher, "setFlushInterval",
+                            Qt::QueuedConnection, Q_ARG(int, intervalMs));
+}
+
+FlushCounters ProfileStore::profileFlushCounters() const {
+  return profileFlusher->counters();
+}
+
+QString ProfileStore::profileFilePath() const {
+  if (profileShards->isEnabled()) {
+    return profileShards->indexPath();
+  }
+  return ProfileCodec::activePath(jsonFilePath);
+}
+
+void ProfileStore::watchProfileFile() {
+  QFileInfo info(profileFilePath());
+  QString filePath = info.absoluteFilePath();
+  QString dirPath = info.absolutePath();
+
+  if (info.exists() && !profileWatcher->files().contains(filePath)) {
+    profileWatcher->addPath(filePath);
+  }
+  // Watching the directory catches the file being created or replaced
+  if (QFileInfo::exists(dirPath) &&
+      !profileWatcher->directories().contains(dirPath)) {
+    profileWatcher->addPath(dirPath);
+  }
+}
+
+void ProfileStore::onProfileFileChanged(const QString& path) {
+  Q_UNUSED(path);
+
+  // Atomic saves replace the file, which removes it from the watcher
+  watchProfileFile();
+
+  QFileInfo info(profileFilePath());
+  if (info.exists() && profileShards->isEnabled()) {
+    if (profileFlusher->isOwnWrite(info.size(), info.lastModified())) {
+      return;  // Our own write, the cache already holds this content
+    }
+  } else if (info.exists()) {
+    // Only the header is read and no lock is taken: the cache is current
+    // if it holds this generation or this generation is our own write
+    quint64 generation = ProfileCodec::readGeneration(info.filePath());
+    if ((profileCacheValid && generation != 0 &&
+         generation == profileGeneration) ||
+        profileFlusher->isOwnGeneration(generation)) {
+      return;
+    }
+  }
+
+  // Someone else changed the profile, only the differing rows are updated
+  QStringList previousUsers = usernameListModel->usernames();
+  QHash<QString, UserStats> previousStats = statsTable->toHash();
+  invalidateProfileCache();
+  usernameListModel->setUsernames(loadUsernames());
+  rankChangedUsers(previousUsers, previousStats);
+}
+
+void ProfileStore::onProfileScanned() {
+  ProfileScanner::Report report = profileScanWatcher->result();
+  if (!report.error.isEmpty()) {
+    qDebug() << "Profile scan failed:" << report.error;
+    return;
+  }
+  if (report.skipped) {
+    qDebug() << "Profile checksum matches, scan skipped";
+    return;
+  }
+
+  qDebug() << "Profile scan checked" << report.users << "users |"
+           << report.repaired.size() << "repaired |" << report.quarantined
+           << "quarantined";
+  if (!report.rewritten) {
+    return;
+  }
+
+  QStringList previousUsers = usernameListModel->usernames();
+  QHash<QString, UserStats> previousStats = statsTable->toHash();
+  invalidateProfileCache();
+  usernameListModel->setUsernames(loadUsernames());
+  rankChangedUsers(previousUsers, previousStats);
+}
+
+void ProfileStore::invalidateProfileCache() {
+  profileCacheValid = false;
+  profileJson = QJsonObject();
+  staleJsonStats.clear();
+  profileIndex.clear();
+  profilePositions.clear();
+  shardPositions.clear();
+}
+
+void ProfileStore::ensureProfileCache() const {
+  if (profileCacheValid) {
+    return;
+  }
+
+  profileCacheValid = true;
+  profileJson = QJsonObject();
+  staleJsonStats.clear();
+  statsTable->reset();
+  profileIndex.clear();
+  profilePositions.clear();
+  shardPositions.clear();
+
+  // Taken before the files are read, so a flush finishing in between is
+  // still seen in one or the other
+  const QHash<QString, UserPatch> pending = profileFlusher->pendingPatches();
+
+  // Sharded profiles only read the index here, users load on first access
+  profileSharded = profileShards->isEnabled();
+  if (profileSharded) {
+    QStringList usernames;
+    if (!profileShards->readIndex(usernames)) {
+      profileStatus = ProfileUnreadable;
+      return;
+    }
+    for (const QString& username : usernames) {
+      profileIndex.insert(username);
+    }
+    overlayPendingPatches(pending);
+    profileStatus = ProfileOk;
+    return;
+  }
+
+  QFile file(profileFilePath());
+  if (!file.exists()) {
+    profileStatus = ProfileMissing;
+    return;
+  }
+
+  if (!file.open(QIODevice::ReadOnly)) {
+    profileStatus = ProfileUnreadable;
+    return;
+  }
+
+  QByteArray jsonData = file.readAll();
+  file.close();
+
+  // JSON or CBOR, whichever is on disk
+  if (!ProfileCodec::decode(jsonData, profileJson, &profileGeneration,
+                            &profilePositions)) {
+    profileJson = QJsonObject();
+    profileStatus = ProfileInvalid;
+    return;
+  }
+
+  statsTable->reserve(profileJson.size());
+
+  // Fill the typed table once so lookups are a single hash probe
+  for (auto it = profileJson.constBegin(); it != profileJson.constEnd(); ++it) {
+    UserStats stats;
+    if (parseUserStats(it.value(), stats)) {
+      statsTable->insert(it.key(), stats);
+    }
+  }
+
+  overlayPendingPatches(pending);
+  profileStatus = ProfileOk;
+}
+
+void ProfileStore::overlayPendingPatches(
+    const QHash<QString, UserPatch>& pending) const {
+  // Changes still waiting for the background writer, the positions skip
+  // the ones a flush finished meanwhile
+  for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+    loadShard(it.key());
+    QJsonValue entry =
+        it->apply(profileJson.value(it.key()), cachedPositions(it.key()));
+    if (entry.isObject()) {
+      applyCachedEntry(it.key(), entry);
+    }
+  }
+}
+
+void ProfileStore::loadShard(const QString& username) const {
+  if (!profileSharded || profileJson.contains(username) ||
+      !profileIndex.contains(username)) {
+    return;
+  }
+
+  QJsonObject userObject;
+  ProfileCodec::JournalPositions positions;
+  if (!profileShards->readUser(username, userObject, &positions)) {
+    qDebug() << "Failed to read" << profileShards->userPath(username);
+    return;
+  }
+
+  profileJson.insert(username, userObject);
+  shardPositions.insert(username, positions);
+  UserStats stats;
+  if (parseUserStats(userObject, stats)) {
+    statsTable->insert(username, stats);
+  }
+}
+
+bool ProfileStore::hasUser(const QString& username) const {
+  return profileSharded ? profileIndex.contains(username)
+                        : profileJson.contains(username);
+}
+
+void ProfileStore::replayStatsJournal() {
+  if (status() != ProfileOk) {
+    return;
+  }
+  const QList<StatsJournal*> journals =
+      QList<StatsJournal*>{statsJournal} + adoptedJournals;
+
+  // One patch per user, applied the way a queued one would be. Each
+  // journal's records are numbered on their own, positions are by journal.
+  QHash<QString, UserPatch> patches;
+  Rating initial = ratingEngine.initialRating();
+  for (StatsJournal* journal : journals) {
+    for (const StatsJournal::Event& event : journal->eventsAfter(0)) {
+      UserPatch& patch = patches[event.username];
+      if (event.field >= StatsJournal::SpymasterRating) {
+        patch.addDefaults(ratingDefaults(ratingRole(event.field), initial));
+      }
+      patch.addEvent(event);
+    }
+  }
+
+  for (auto it = patches.begin(); it != patches.end();) {
+    loadShard(it.key());
+    ProfileCodec::JournalPositions positions = cachedPositions(it.key());
+    if (!profileJson.contains(it.key()) || !it->changes(positions)) {
+      it = patches.erase(it);  // Already in the file, or the user is gone
+      continue;
+    }
+    applyCachedEntry(it.key(),
+                     it->apply(profileJson.value(it.key()), positions));
+    ++it;
+  }
+
+  if (patches.isEmpty()) {
+    return;
+  }
+
+  // Queue the replayed users so the next flush folds the journal in
+  profileFlusher->enqueue(patches);
+  qDebug() << "Replayed journaled changes for" << patches.size() << "users";
+}
+
+ProfileCodec::JournalPositions ProfileStore::cachedPositions(
+    const QString& username) const {
+  return profileSharded ? shardPositions.value(username) : profilePositions;
+}
+
+bool ProfileStore::parseUserStats(const QJsonValue& userObject,
+                                  UserStats& stats) {
+  QJsonObject user = userObject.toObject();
+  if (!user.contains("statistics") || !user["statistics"].isObject()) {
+    return false;  // Reported as "statistics missing" on lookup
+  }
+
+  QJsonObject statisticsObject = user["statistics"].toObject();
+  stats.gamesPlayed = std::max(statisticsObject["games_played"].toInt(), 0);
+  stats.gamesWin = std::max(statisticsObject["games_win"].toInt(), 0);
+  stats.guessTotal = std::max(statisticsObject["guess_total"].toInt(), 0);
+  stats.guessHit = std::max(statisticsObject["guess_hit"].toInt(), 0);
+  return true;
+}
+
+void ProfileStore::applyCachedEntry(const QString& username,
+                                    const QJsonValue& userObject) const {
+  // The entry holds the user's counters from now on
+  staleJsonStats.remove(username);
+  if (!userObject.isObject()) {
+    profileJson.remove(username);
+    statsTable->remove(username);
+    profileIndex.remove(username);
+    return;
+  }
+
+  profileJson.insert(username, userObject);
+  if (profileSharded) {
+    profileIndex.insert(username);
+  }
+
+  UserStats stats;
+  if (parseUserStats(userObject, stats)) {
+    statsTable->insert(username, stats);
+  } else {
+    statsTable->remove(username);
+  }
+}
+
+bool ProfileStore::checkProfileStatus() const {
+  ensureProfileCache();
+
+  switch (profileStatus) {
+    case ProfileMissing:
+      qDebug() << "Error: profile.json does not exist.";
+      setError("Error: No user data found.");
+      return false;
+    case ProfileUnreadable:
+      qDebug() << "Failed to open" << QFileInfo(profileFilePath()).absoluteFilePath()
+               << " for reading.";
+      setError("Error: Could not read profile.json");
+      return false;
+    case ProfileInvalid:
+      qDebug() << "Invalid JSON format.";
+      setError("Error: Invalid profile format.");
+      return false;
+    case ProfileOk:
+      break;
+  }
+  return true;
+}
+
+const UserStats* ProfileStore::cachedStats(const QString& username) const {
+  loadShard(username);
+  return statsTable->find(username);
+}
+
+const UserStats* ProfileStore::findStats(const QString& username) const {
+  if (!checkProfileStatus()) {
+    return nullptr;
+  }
+
+  const UserStats* stats = cachedStats(username);
+  if (!stats) {
+    if (!hasUser(username)) {
+      qDebug() << "User not found:" << username;
+      setError("Error: User does not exist.");
+    } else {
+      qDebug() << "Error: No statistics found for user:" << username;
+      setError("Error: User statistics missing.");
+    }
+  }
+  return stats;
+}
+
+void ProfileStore::writeStatsToJson(const QString& username,
+                                    const UserStats& stats) const {
+  // Update the document in place so unknown keys survive the rewrite
+  QJsonObject userObject = profileJson[username].toObject();
+  QJsonObject statisticsObject = userObject["statistics"].toObject();
+  statisticsObject["games_played"] = (int)stats.gamesPlayed;
+  statisticsObject["games_win"] = (int)stats.gamesWin;
+  statisticsObject["guess_total"] = (int)stats.guessTotal;
+  statisticsObject["guess_hit"] = (int)stats.guessHit;
+  userObject["statistics"] = statisticsObject;
+  profileJson[username] = userObject;
+}
+
+void ProfileStore::syncStatsToJson() const {
+  for (const QString& username : staleJsonStats) {
+    if (const UserStats* stats = statsTable->find(username)) {
+      writeStatsToJson(username, *stats);
+    }
+  }
+  staleJsonStats.clear();
+}
+
+void ProfileStore::journalStats(const QString& username,
+                                const UserStats& before,
+                                const UserStats& after, UserPatch& patch) {
+  const struct {
+    StatsJournal::Field field;
+    unsigned int before;
+    unsigned int after;
+  } changes[] = {
+      {StatsJournal::GamesPlayed, before.gamesPlayed, after.gamesPlayed},
+      {StatsJournal::GamesWin, before.gamesWin, after.gamesWin},
+      {StatsJournal::GuessTotal, before.guessTotal, after.guessTotal},
+      {StatsJournal::GuessHit, before.guessHit, after.guessHit},
+  };
+
+  for (const auto& change : changes) {
+    if (change.after != change.before) {
+      qint32 delta = qint32(qint64(change.after) - qint64(change.before));
+      patch.addEvent(statsJournal->append(username, change.field, delta));
+    }
+  }
+}
+
+void ProfileStore::storeStats(const QString& username, const UserStats& stats) {
+  UserStats* current = statsTable->find(username);
+  if (!current) {
+    return;
+  }
+
+  // Written in place, the profile document catches up when it is handed out
+  UserPatch patch;
+  journalStats(username, *current, stats, patch);
+  *current = stats;
+  staleJsonStats.insert(username);
+
+  // The journal makes the change durable, the snapshot is written later
+  profileFlusher->enqueue(username, patch);
+  rankStats(username);
+}
+
+QJsonObject ProfileStore::loadJsonFile() {
+  if (status() != ProfileOk || userCount() == 0) {
+    return QJsonObject();  // Return empty object on error or empty profile
+  }
+
+  // The whole document was asked for, so every user file has to be read
+  for (const QString& username : profileIndex) {
+    loadShard(username);
+  }
+  syncStatsToJson();
+  return profileJson;
+}
+
+QStringList ProfileStore::loadUsernames() {
+  if (status() != ProfileOk) {
+    return QStringList();
+  }
+
+  // Only the index is read for a sharded profile
+  QStringList usernames;
+  if (profileSharded) {
+    usernames = profileIndex.values();
+  } else {
+    usernames = profileJson.keys();
+  }
+  usernames.sort();
+  return usernames;
+}
+
+ProfileStore::ProfileStatus ProfileStore::status() const {
+  ensureProfileCache();
+  return profileStatus;
+}
+
+int ProfileStore::userCount() const {
+  if (status() != ProfileOk) {
+    return 0;
+  }
+  return profileSharded ? profileIndex.size() : profileJson.size();
+}
+
+QJsonObject ProfileStore::userEntry(const QString& username) const {
+  ensureProfileCache();
+  loadShard(username);
+  syncStatsToJson();
+  return profileJson.value(username).toObject();
+}
+
+QString ProfileStore::lastError() const { return errorText; }
+
+void ProfileStore::setError(const QString& message) const {
+  errorText = message;
+}
+
+void ProfileStore::reportError(const QString& message) {
+  setError(message);
+  emit statusMessage(message);
+}
+
+ProfileStore::AccountResult ProfileStore::createAccount(
+    const QString& username) {
+  AccountResult result = AccountCreated;
+  bool written = rewriteProfile({username}, [&](QJsonObject& users) {
+    // Check if user exists and preserve statistics
+    QJsonObject userObject;
+    if (users.contains(username)) {
+      result = AccountExists;
+      userObject = users[username].toObject();
+    }
+    users[username] = makeUserObject(username, userObject);
+    return true;
+  });
+  if (!written) {
+    return AccountFailed;
+  }
+
+  usernameListModel->addUsername(username);
+  rankStats(username);
+  return result;
+}
+
+bool ProfileStore::rewriteProfile(
+    const QStringList& usernames,
+    const std::function<bool(QJsonObject& users)>& change) {
+  // Queued patches first, a patch for a renamed user would be dropped
+  if (profileFlusherThread->isRunning()) {
+    QMetaObject::invokeMethod(profileFlusher, "flush",
+                              Qt::BlockingQueuedConnection);
+  }
+  if (profileFlusher->counters().queueDepth > 0) {
+    qDebug() << "Queued profile changes could not be written";
+    setError("Error: Could not write to profile.json");
+    return false;
+  }
+
+  // Another instance may be writing the profile, hold the lock until the
+  // change is on disk
+  QLockFile lock(ProfileCodec::lockPath(jsonFilePath));
+  if (!lock.tryLock(ProfileCodec::LockTimeoutMs)) {
+    qDebug() << "Timed out waiting for the profile lock";
+    setError("Error: Profile is busy, try again");
+    return false;
+  }
+
+  bool written = profileShards->isEnabled()
+                     ? rewriteUserFiles(usernames, change)
+                     : rewriteProfileFile(change);
+
+  // Written past the background writer, so the watcher may not have
+  // reported it yet
+  invalidateProfileCache();
+  return written;
+}
+
+bool ProfileStore::rewriteProfileFile(
+    const std::function<bool(QJsonObject& users)>& change) {
+  // The profile may still be JSON, or already migrated to CBOR
+  QFile file(ProfileCodec::activePath(jsonFilePath));
+  QString absolutePath = QFileInfo(file).absoluteFilePath();
+
+  QJsonObject jsonObject;
+  quint64 generation = 0;
+  ProfileCodec::JournalPositions positions;
+
+  // Read existing data (if any), a profile that does not parse is left
+  // for the integrity scan rather than replaced
+  if (file.exists()) {
+    if (!file.open(QIODevice::ReadOnly)) {
+      qDebug() << "Failed to open" << absolutePath << " for reading.";
+      setError("Error: Could not read profile.json");
+      return false;
+    }
+
+    QByteArray jsonData = file.readAll();
+    file.close();
+
+    if (!ProfileCodec::decode(jsonData, jsonObject, &generation,
+                              &positions)) {
+      qDebug() << "Invalid JSON format.";
+      setError("Error: Invalid profile format.");
+      return false;
+    }
+  }
+
+  if (!change(jsonObject)) {
+    return false;
+  }
+
+  // Write the updated profile as CBOR, migrating a JSON profile
+  if (!ProfileCodec::save(
+          jsonFilePath, ProfileCodec::encode(jsonObject, ProfileCodec::Cbor,
+                                             generation + 1, positions))) {
+    qDebug() << "Failed to write to"
+             << QFileInfo(ProfileCodec::cborPath(jsonFilePath))
+                    .absoluteFilePath();
+    setError("Error: Could not write to profile.json");
+    return false;
+  }
+  return true;
+}
+
+bool ProfileStore::rewriteUserFiles(
+    const QStringList& usernames,
+    const std::function<bool(QJsonObject& users)>& change) {
+  QStringList index;
+  if (!profileShards->readIndex(index)) {
+    qDebug() << "Failed to open"
+             << QFileInfo(profileShards->indexPath()).absoluteFilePath()
+             << " for reading.";
+    setError("Error: Could not read profile.json");
+    return false;
+  }
+  QSet<QString> listed;
+  for (const QString& username : index) {
+    listed.insert(username);
+  }
+
+  // Only the named users are read, a new file takes the journal positions
+  // of the files read with it (a renamed user's)
+  QJsonObject users;
+  QHash<QString, ProfileCodec::JournalPositions> positions;
+  ProfileCodec::JournalPositions newPositions;
+  for (const QString& username : usernames) {
+    if (!listed.contains(username)) {
+      continue;
+    }
+    QJsonObject userObject;
+    ProfileCodec::JournalPositions filePositions;
+    if (!profileShards->readUser(username, userObject, &filePositions)) {
+      qDebug() << "Failed to read" << profileShards->userPath(username);
+      setError("Error: Could not read profile.json");
+      return false;
+    }
+    users.insert(username, userObject);
+    positions.insert(username, filePositions);
+    for (auto it = filePositions.constBegin(); it != filePositions.constEnd();
+         ++it) {
+      newPositions[it.key()] = std::max(newPositions[it.key()], it.value());
+    }
+  }
+
+  if (!change(users)) {
+    return false;
+  }
+
+  // User files first, so the index never lists a user without a file
+  bool indexChanged = false;
+  for (auto it = users.constBegin(); it != users.constEnd(); ++it) {
+    if (!profileShards->writeUser(it.key(), it.value().toObject(),
+                                  positions.value(it.key(), newPositions))) {
+      qDebug() << "Failed to write to" << profileShards->userPath(it.key());
+      setError("Error: Could not write to profile.json");
+      return false;
+    }
+    if (!listed.contains(it.key())) {
+      index.append(it.key());
+      indexChanged = true;
+    }
+  }
+
+  QStringList removed;
+  for (const QString& username : usernames) {
+    if (listed.contains(username) && !users.contains(username)) {
+      index.removeAll(username);
+      removed.append(username);
+      indexChanged = true;
+    }
+  }
+
+  if (indexChanged && !profileShards->writeIndex(index)) {
+    qDebug() << "Failed to write to" << profileShards->indexPath();
+    setError("Error: Could not write to profile.json");
+    return false;
+  }
+
+  // Removed users go last, once the index no longer lists them
+  for (const QString& username : removed) {
+    profileShards->removeUser(username);
+  }
+  return true;
+}
+
+bool ProfileStore::enableShardedProfiles() {
+  if (profileShards->isEnabled()) {
+    return true;
+  }
+
+  // Everything queued has to be in the profile that is split up
+  if (profileFlusherThread->isRunning()) {
+    QMetaObject::invokeMethod(profileFlusher, "flush",
+                              Qt::BlockingQueuedConnection);
+  }
+
+  QString singleFilePath = profileFilePath();
+  invalidateProfileCache();
+  ensureProfileCache();
+  if (profileStatus != ProfileOk) {
+    qDebug() << "Cannot split the profile, it could not be loaded.";
+    return false;
+  }
+
+  if (!profileShards->create(profileJson, profilePositions)) {
+    qDebug() << "Failed to create the profiles directory"
+             << QFileInfo(shardDirPath).absoluteFilePath();
+    return false;
+  }
+
+  // Keep the single file as a backup, it is no longer read
+  QFile::remove(singleFilePath + ".migrated");
+  QFile::rename(singleFilePath, singleFilePath + ".migrated");
+  qDebug() << "Profile split into" << profileJson.size() << "user files";
+
+  invalidateProfileCache();
+  watchProfileFile();
+  return true;
+}
+
+unsigned int ProfileStore::getGamesPlayed(const QString& username) const {
+  const UserStats* stats = findStats(username);
+  if (!stats) {
+    return 0;  // Indicates error
+  }
+
+  qDebug() << "Retrieved games played for user:" << username
+           << "| Games played count:" << stats->gamesPlayed;
+  return stats->gamesPlayed;
+}
+
+void ProfileStore::updateGamesPlayed(const QString& username,
+                                     const unsigned int& newGamesPlayed) {
+  const UserStats* current = findStats(username);
+  if (!current) {
+    emit statusMessage(errorText);
+    return;
+  }
+
+  // Check if the new games played is smaller than the wins count
+  if (newGamesPlayed < current->gamesWin) {
+    qDebug() << "Error: New games played cannot be smaller than games won.";
+    reportError(
+        "Error: New games played count cannot be smaller than wins.");
+    return;
+  }
+
+  UserStats stats = *current;
+  stats.gamesPlayed = newGamesPlayed;
+  storeStats(username, stats);
+
+  qDebug() << "Updated games played for user:" << username
+           << "| New games played count:" << stats.gamesPlayed;
+  emit statusMessage("Games played count updated for " + username);
+}
+
+unsigned int ProfileStore::getWins(const QString& username) const {
+  const UserStats* stats = findStats(username);
+  if (!stats) {
+    return 0;  // Indicates error
+  }
+
+  qDebug() << "Retrieved wins for user:" << username
+           << "| Wins count:" << stats->gamesWin;
+  return stats->gamesWin;
+}
+
+float ProfileStore::getWinRate(const QString& username) const {
+  return statsSnapshot(username).winRate;
+}
+
+void ProfileStore::updateWins(const QString& username,
+                              const unsigned int& newWins) {
+  const UserStats* current = findStats(username);
+  if (!current) {
+    emit statusMessage(errorText);
+    return;
+  }
+
+  // Check if the new wins count is greater than the games played
+  if (newWins > current->gamesPlayed) {
+    qDebug() << "Error: New games won cannot be greater than games played.";
+    reportError(
+        "Error: New games win count cannot be greater than games played.");
+    return;
+  }
+
+  UserStats stats = *current;
+  stats.gamesWin = newWins;
+  storeStats(username, stats);
+
+  qDebug() << "Updated wins for user:" << username
+           << "| New wins count:" << stats.gamesWin;
+  emit statusMessage("Win count updated for " + username);
+}
+
+unsigned int ProfileStore::getGuessTotal(const QString& username) const {
+  const UserStats* stats = findStats(username);
+  if (!stats) {
+    return 0;  // Indicates error
+  }
+
+  qDebug() << "Retrieved total number of guess for user:" << username
+           << "| Guess total count:" << stats->guessTotal;
+  return stats->guessTotal;
+}
+
+void ProfileStore::updateGuessTotal(const QString& username,
+                                    const unsigned int& newGuessTotal) {
+  const UserStats* current = findStats(username);
+  if (!current) {
+    emit statusMessage(errorText);
+    return;
+  }
+
+  // Check if the new guess total is smaller than the guess hit count
+  if (newGuessTotal < current->guessHit) {
+    qDebug() << "Error: New guess total cannot be less than guess hit.";
+    reportError(
+        "Error: New guess total count cannot be less than guess hit.");
+    return;
+  }
+
+  UserStats stats = *current;
+  stats.guessTotal = newGuessTotal;
+  storeStats(username, stats);
+
+  qDebug() << "Updated guess total for user:" << username
+           << "| New guess total count:" << stats.guessTotal;
+  emit statusMessage("Guess total count updated for " + username);
+}
+
+unsigned int ProfileStore::getGuessHit(const QString& username) const {
+  const UserStats* stats = findStats(username);
+  if (!stats) {
+    return 0;  // Indicates error
+  }
+
+  qDebug() << "Retrieved guess hit for user:" << username
+           << "| Guess hit count:" << stats->guessHit;
+  return stats->guessHit;
+}
+
+float ProfileStore::getHitRate(const QString& username) {
+  return statsSnapshot(username).hitRate;
+}
+
+const Leaderboard* ProfileStore::leaderboard() {
+  if (!rankingsValid) {
+    // Only on first use and after an outside change to the profile
+    rankings->clear();
+    for (const StatsSnapshot& snapshot :
+         statsSnapshots(usernameListModel->usernames())) {
+      if (snapshot.found) {
+        rankings->update(snapshot.username, snapshot.counters);
+      }
+    }
+    rankingsValid = true;
+  }
+  return rankings;
+}
+
+void ProfileStore::rankStats(const QString& username) {
+  if (!rankingsValid) {
+    return;  // Picked up when the leaderboard is built
+  }
+
+  ensureProfileCache();
+  if (profileStatus != ProfileOk) {
+    return;
+  }
+  if (const UserStats* stats = cachedStats(username)) {
+    rankings->update(username, *stats);
+  }
+}
+
+void ProfileStore::rankChangedUsers(
+    const QStringList& previousUsers,
+    const QHash<QString, UserStats>& previousStats) {
+  if (!rankingsValid) {
+    return;  // Picked up when the leaderboard is built
+  }
+  if (status() != ProfileOk) {
+    rankingsValid = false;
+    return;
+  }
+
+  const QStringList usernames = usernameListModel->usernames();
+  QSet<QString> current(usernames.begin(), usernames.end());
+  QSet<QString> previous(previousUsers.begin(), previousUsers.end());
+  for (const QString& username : previousUsers) {
+    if (!current.contains(username)) {
+      rankings->remove(username);
+    }
+  }
+
+  // Another instance only rewrites the shard index to add users, so in the
+  // sharded layout only their files are read
+  int changed = 0;
+  for (const QString& username : usernames) {
+    if (profileSharded && previous.contains(username)) {
+      continue;
+    }
+    const UserStats* stats = cachedStats(username);
+    auto before = previousStats.constFind(username);
+    if (!stats) {
+      rankings->remove(username);
+    } else if (before == previousStats.constEnd() ||
+               !sameCounters(*before, *stats)) {
+      rankings->update(username, *stats);
+      changed++;
+    }
+  }
+  qDebug() << "Re-ranked" << changed << "users changed outside this instance";
+}
+
+PlayerRatings ProfileStore::getRatings(const QString& username) const {
+  ensureProfileCache();
+  loadShard(username);
+
+  Rating initial = ratingEngine.initialRating();
+  QJsonObject ratingsObject =
+      profileJson.value(username).toObject()["ratings"].toObject();
+  PlayerRatings ratings;
+  ratings.spymaster = ratingFromJson(ratingsObject["spymaster"], initial);
+  ratings.operative = ratingFromJson(ratingsObject["operative"], initial);
+  return ratings;
+}
+
+RoleStats ProfileStore::getRoleStats(const QString& username) const {
+  ensureProfileCache();
+  loadShard(username);
+  return roleStatsFromJson(
+      profileJson.value(username).toObject()["role_statistics"]);
+}
+
+void ProfileStore::writeRoleStatsToJson(const QString& username,
+                                        const RoleStats& stats) const {
+  // Update the document in place so unknown keys survive the rewrite
+  QJsonObject userObject = profileJson[username].toObject();
+  userObject["role_statistics"] = roleStatsToJson(stats);
+  profileJson[username] = userObject;
+}
+
+void ProfileStore::addRoleStatsDeltas(
+    const QHash<QString, RoleStats>& deltas,
+    QHash<QString, UserPatch>& patches) {
+  for (auto it = deltas.constBegin(); it != deltas.constEnd(); ++it) {
+    loadShard(it.key());
+    if (it.key().isEmpty() || !hasUser(it.key())) {
+      continue;  // Guests and users of another profile
+    }
+
+    // One journal record per changed counter, the fields follow roleFields
+    RoleStats stats = getRoleStats(it.key());
+    UserPatch& patch = patches[it.key()];
+    int field = StatsJournal::CluesGiven;
+    for (const RoleField& roleField : roleFields) {
+      qint32 delta = qint32(it.value().*roleField.counter);
+      stats.*roleField.counter += delta;
+      if (delta != 0) {
+        patch.addEvent(statsJournal->append(
+            it.key(), StatsJournal::Field(field), delta));
+      }
+      field++;
+    }
+    writeRoleStatsToJson(it.key(), stats);
+  }
+}
+
+void ProfileStore::writeRatingsToJson(const QString& username,
+                                      const PlayerRatings& ratings) const {
+  // Update the document in place so unknown keys survive the rewrite
+  QJsonObject userObject = profileJson[username].toObject();
+  userObject["ratings"] = ratingsToJson(ratings);
+  profileJson[username] = userObject;
+}
+
+void ProfileStore::rateMatch(const MatchResult& match) {
+  ensureProfileCache();
+  if (profileStatus != ProfileOk) {
+    qDebug() << "Error: cannot rate the game, profile is not loaded.";
+    return;
+  }
+
+  PlayerRatings players[RatingEngine::SeatCount];
+  Rating seats[RatingEngine::SeatCount];
+  for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+    players[seat] = getRatings(match.players[seat]);
+    seats[seat] = RatingEngine::roleRating(
+        players[seat], RatingEngine::roleOf(RatingEngine::Seat(seat)));
+  }
+
+  ratingEngine.rateMatch(seats, match.redWon, match.timestamp);
+
+  // Only users of this profile are stored, in one queued batch
+  QHash<QString, UserPatch> patches;
+  for (int seat = 0; seat < RatingEngine::SeatCount; seat++) {
+    const QString& username = match.players[seat];
+    if (username.isEmpty() || !hasUser(username)) {
+      continue;
+    }
+    RatingEngine::Role role = RatingEngine::roleOf(RatingEngine::Seat(seat));
+    Rating& stored = RatingEngine::roleRating(players[seat], role);
+    journalRating(username, role, stored, seats[seat], patches[username]);
+    stored = seats[seat];
+    writeRatingsToJson(username, players[seat]);
+  }
+  profileFlusher->enqueue(patches);
+
+  qDebug() << "Rated game for" << patches.size() << "users";
+}
+
+void ProfileStore::journalRating(const QString& username,
+                                 RatingEngine::Role role, const Rating& before,
+                                 Rating& after, UserPatch& patch) {
+  StatsJournal::Field first = role == RatingEngine::Spymaster
+                                  ? StatsJournal::SpymasterRating
+                                  : StatsJournal::OperativeRating;
+  qint32 ratingDelta =
+      qRound((after.rating - before.rating) * StatsJournal::RatingScale);
+  qint32 deviationDelta =
+      qRound((after.deviation - before.deviation) * StatsJournal::RatingScale);
+  qint32 gamesDelta = qint32(qint64(after.games) - qint64(before.games));
+
+  // Stored as replay will rebuild it, to the journal's precision
+  after.rating =
+      before.rating + double(ratingDelta) / StatsJournal::RatingScale;
+  after.deviation =
+      before.deviation + double(deviationDelta) / StatsJournal::RatingScale;
+  after.lastPlayed = std::max(before.lastPlayed, after.lastPlayed);
+
+  const struct {
+    StatsJournal::Field field;
+    qint32 delta;
+  } changes[] = {
+      {first, ratingDelta},
+      {StatsJournal::Field(first + 1), deviationDelta},
+      {StatsJournal::Field(first + 2), gamesDelta},
+  };
+
+  // A user without a rating in this role starts from the initial one
+  patch.addDefaults(ratingDefaults(role, ratingEngine.initialRating()));
+  for (const auto& change : changes) {
+    if (change.delta != 0) {
+      patch.addEvent(statsJournal->append(username, change.field, change.delta,
+                                          after.lastPlayed));
+    }
+  }
+}
+
+bool ProfileStore::recomputeRatings(const QVector<MatchResult>& matches) {
+  ensureProfileCache();
+  if (profileStatus != ProfileOk) {
+    qDebug() << "Error: cannot recompute ratings, profile is not loaded.";
+    reportError("Error: No user data found.");
+    return false;
+  }
+
+  QHash<QString, PlayerRatings> ratings = ratingEngine.recompute(matches);
+
+  // Users without rated games go back to the initial rating
+  PlayerRatings initial;
+  initial.spymaster = ratingEngine.initialRating();
+  initial.operative = ratingEngine.initialRating();
+
+  // Absolute ratings, written under the lock rather than queued
+  int rated = 0;
+  bool written = rewriteProfile(loadUsernames(), [&](QJsonObject& users) {
+    for (auto it = users.begin(); it != users.end(); ++it) {
+      QJsonObject userObject = it.value().toObject();
+      userObject["ratings"] = ratingsToJson(ratings.value(it.key(), initial));
+      it.value() = userObject;
+    }
+    rated = users.size();
+    return true;
+  });
+  if (!written) {
+    emit statusMessage(errorText);
+    return false;
+  }
+
+  qDebug() << "Recomputed ratings from" << matches.size() << "games for"
+           << rated << "users";
+  return true;
+}
+
+bool ProfileStore::recomputeRatings() {
+  return recomputeRatings(history->results());
+}
+
+bool ProfileStore::recordMatch(const MatchRecord& record) {
+  pairStats->recordGame(record.result());
+  return history->append(record);
+}
+
+const MatchHistory* ProfileStore::matchHistory() const { return history; }
+
+QVector<PairRecord> ProfileStore::bestPartners(const QString& username,
+                                               int count,
+                                               quint32 minGames) const {
+  QVector<PairRecord> partners =
+      pairStats->records(username, PairStats::Teammates, minGames);
+  if (partners.size() > count) {
+    partners.resize(std::max(count, 0));
+  }
+  return partners;
+}
+
+PairRecord ProfileStore::headToHead(const QString& username,
+                                    const QString& opponent) const {
+  return pairStats->record(username, opponent, PairStats::Opponents);
+}
+
+void ProfileStore::setRatingParams(const RatingEngine::Params& params) {
+  ratingEngine = RatingEngine(params);
+}
+
+StatsSnapshot ProfileStore::statsSnapshot(const QString& username) const {
+  return makeSnapshot(username, findStats(username));
+}
+
+StatsSnapshot ProfileStore::recentStats(const QString& username,
+                                        int days) const {
+  if (!findStats(username)) {
+    return makeSnapshot(username, nullptr);
+  }
+
+  UserStats stats =
+      statsBuckets->window(username, QDate::currentDate().toJulianDay(), days);
+  return makeSnapshot(username, &stats);
+}
+
+QList<StatsSnapshot> ProfileStore::statsSnapshots(
+    const QStringList& usernames) const {
+  QList<StatsSnapshot> snapshots;
+  bool profileOk = checkProfileStatus();
+  snapshots.reserve(usernames.size());
+  for (const QString& username : usernames) {
+    snapshots.append(
+        makeSnapshot(username, profileOk ? cachedStats(username) : nullptr));
+  }
+  return snapshots;
+}
+
+void ProfileStore::updateGuessHit(const QString& username,
+                                  const unsigned int& newGuessHit) {
+  const UserStats* current = findStats(username);
+  if (!current) {
+    emit statusMessage(errorText);
+    return;
+  }
+
+  // Check if the new guess hit is greater than the guess total
+  if (newGuessHit > current->guessTotal) {
+    qDebug() << "Error: New guess hit cannot be greater than guess total.";
+    reportError(
+        "Error: New guess hit count cannot be greater than guess total.");
+    return;
+  }
+
+  UserStats stats = *current;
+  stats.guessHit = newGuessHit;
+  storeStats(username, stats);
+
+  qDebug() << "Updated guess hit for user:" << username
+           << "| New guess hit count:" << stats.guessHit;
+  emit statusMessage("Guess hit count updated for " + username);
+}
+
+void ProfileStore::renameUser(const QString& oldUsername,
+                              const QString& newUsername) {
+  ensureProfileCache();
+
+  if (profileStatus == ProfileMissing) {
+    qDebug() << "Error: profile.json does not exist.";
+    reportError("Error: No user data found.");
+    return;
+  }
+
+  if (profileStatus == ProfileUnreadable) {
+    qDebug() << "Failed to open" << QFileInfo(profileFilePath()).absoluteFilePath()
+             << " for reading.";
+    reportError("Error: Could not read profile.json");
+    return;
+  }
+
+  if (profileStatus == ProfileInvalid) {
+    qDebug() << "Invalid JSON format.";
+    reportError("Error: Invalid profile format.");
+    return;
+  }
+
+  // Renamed on disk under the lock, from the entry stored there
+  bool renamed =
+      rewriteProfile({oldUsername, newUsername}, [&](QJsonObject& users) {
+        // Check if the old username exists
+        if (!users.contains(oldUsername)) {
+          qDebug() << "User not found:" << oldUsername;
+          setError("Error: User does not exist.");
+          return false;
+        }
+
+        // Check if the new username already exists
+        if (users.contains(newUsername)) {
+          qDebug() << "New username already exists:" << newUsername;
+          setError("Error: Username already taken.");
+          return false;
+        }
+
+        // Rename the user: Move data from old username to new username
+        QJsonObject userObject = users[oldUsername].toObject();
+
+        // Ensure profile object exists
+        if (userObject.contains("profile") &&
+            userObject["profile"].isObject()) {
+          QJsonObject profileObject = userObject["profile"].toObject();
+          profileObject["player_name"] = newUsername;  // Update player_name
+          userObject["profile"] = profileObject;
+        } else {
+          qDebug() << "Error: No profile data found for user:"
+                   << oldUsername;
+          setError("Error: User profile missing.");
+          return false;
+        }
+
+        users.remove(oldUsername);        // Remove old entry
+        users[newUsername] = userObject;  // Insert under new username
+        return true;
+      });
+  if (!renamed) {
+    emit statusMessage(errorText);
+    return;
+  }
+
+  statsBuckets->rename(oldUsername, newUsername);
+  pairStats->rename(oldUsername, newUsername);
+  usernameListModel->renameUsername(oldUsername, newUsername);
+  rankings->rename(oldUsername, newUsername);
+
+  qDebug() << "User renamed from" << oldUsername << "to" << newUsername;
+  emit statusMessage("Username successfully changed.");
+}
+
+bool ProfileStore::applyGameDeltas(
+    const QHash<QString, UserStats>& deltas,
+    const QHash<QString, RoleStats>& roleDeltas) {
+  ensureProfileCache();
+  if (profileStatus != ProfileOk) {
+    qDebug() << "Error: cannot apply statistics, profile is not loaded.";
+    reportError("Error: No user data found.");
+    return false;
+  }
+
+  QHash<QString, UserPatch> patches;
+  addStatsDeltas(deltas, patches);
+  addRoleStatsDeltas(roleDeltas, patches);
+
+  // One batch, so every change of the game is written by the same flush
+  profileFlusher->enqueue(patches);
+
+  qDebug() << "Committed statistics for" << patches.size() << "users";
+  return true;
+}
+
+void ProfileStore::addStatsDeltas(const QHash<QString, UserStats>& deltas,
+                                  QHash<QString, UserPatch>& patches) {
+  for (auto it = deltas.constBegin(); it != deltas.constEnd(); ++it) {
+    loadShard(it.key());
+    if (!statsTable->find(it.key())) {
+      qDebug() << "Skipping statistics for unknown user:" << it.key();
+      continue;
+    }
+    bucketStats(it.key(), it.value());
+
+    // Added in place in the mapped table
+    UserStats* stats = statsTable->find(it.key());
+    UserStats before = *stats;
+    addCounters(*stats, it.value());
+    journalStats(it.key(), before, *stats, patches[it.key()]);
+    staleJsonStats.insert(it.key());
+    rankStats(it.key());
+  }
+}
+
+bool ProfileStore::mergeStats(const QHash<QString, StatsCounters>& counters) {
+  ensureProfileCache();
+  if (profileStatus != ProfileOk) {
+    qDebug() << "Error: cannot merge statistics, profile is not loaded.";
+    reportError("Error: No user data found.");
+    return false;
+  }
+
+  QHash<QString, UserPatch> patches;
+  QStringList created;
+  for (auto it = counters.constBegin(); it != counters.constEnd(); ++it) {
+    loadShard(it.key());
+    const UserStats& stats = it.value();
+    if (!hasUser(it.key())) {
+      // Shaped like an account made by createAccount, the counters are
+      // journaled so they add to an account made elsewhere meanwhile
+      QJsonObject userObject = makeUserObject(it.key(), QJsonObject());
+      UserPatch& patch = patches[it.key()];
+      patch.addDefaults(userObject);
+      patch.createUser();
+      journalStats(it.key(), UserStats(), stats, patch);
+
+      applyCachedEntry(it.key(), userObject);
+      writeStatsToJson(it.key(), stats);
+      statsTable->insert(it.key(), stats);
+      created.append(it.key());
+      rankStats(it.key());
+      continue;
+    }
+
+    UserStats* current = statsTable->find(it.key());
+    if (!current) {
+      continue;  // Statistics missing, already reported by the lookup
+    }
+    UserStats before = *current;
+    addCounters(*current, stats);
+    journalStats(it.key(), before, *current, patches[it.key()]);
+    staleJsonStats.insert(it.key());
+    rankStats(it.key());
+  }
+
+  // Sorted inserts for a few accounts, one rebuild for a large batch
+  if (created.size() > 64) {
+    usernameListModel->setUsernames(loadUsernames());
+  } else {
+    for (const QString& username : created) {
+      usernameListModel->addUsername(username);
+    }
+  }
+
+  profileFlusher->enqueue(patches);
+  qDebug() << "Merged statistics for" << counters.size() << "users,"
+           << created.size() << "new";
+  return true;
+}
+
+bool ProfileStore::importProfile(const QString& dumpPath) {
+  ProfileImporter importer(dumpPath);
+  bool imported = importer.run(
+      [this](const QHash<QString, StatsCounters>& batch) {
+        return mergeStats(batch);
+      });
+
+  if (!imported) {
+    qDebug() << "Failed to import" << QFileInfo(dumpPath).absoluteFilePath()
+             << ":" << importer.errorString();
+    reportError("Error: Could not import " + dumpPath);
+    return false;
+  }
+
+  qDebug() << "Imported" << importer.usersRead() << "users from" << dumpPath
+           << "|" << importer.usersSkipped() << "without statistics";
+  emit statusMessage("Imported " + QString::number(importer.usersRead()) +
+                     " users.");
+  return true;
+}
+
+void ProfileStore::bucketStats(const QString& username,
+                               const StatsCounters& delta) {
+  // Only users in the profile, the same ones the counters are kept for
+  if (checkProfileStatus() && cachedStats(username)) {
+    statsBuckets->add(username, QDate::currentDate().toJulianDay(), delta);
+  }
+}
+
+void ProfileStore::addStats(const QString& username, const UserStats& delta) {
+  const UserStats* current = findStats(username);
+  if (!current) {
+    emit statusMessage(errorText);
+    return;
+  }
+  bucketStats(username, delta);
+
+  // One journal record per counter, then a single queued profile write
+  UserStats stats = *current;
+  addCounters(stats, delta);
+  storeStats(username, stats);
+}
+
+void ProfileStore::won(const QString& username) {
+  UserStats delta;
+  delta.gamesPlayed = 1;
+  delta.gamesWin = 1;
+  addStats(username, delta);
+}
+
+void ProfileStore::lost(const QString& username) {
+  UserStats delta;
+  delta.gamesPlayed = 1;
+  addStats(username, delta);
+}
+
+void ProfileStore::hit(const QString& username) {
+  UserStats delta;
+  delta.guessTotal = 1;
+  delta.guessHit = 1;
+  addStats(username, delta);
+}
+
+void ProfileStore::miss(const QString& username) {
+  UserStats delta;
+  delta.guessTotal = 1;
+  addStats(username, delta);
+}
@@ -0,0 +1,282 @@
+/**
+ * @file ratingengine.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Glicko skill ratings for the spymaster and operative roles
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "ratingengine.h"
+
+#include <QPair>
+#include <QStringList>
+#include <QThread>
+#include <QVarLengthArray>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Glicko scale factor, ln(10) / 400
+const double Q = std::log(10.0) / 400.0;
+const double PI = 3.14159265358979323846;
+
+// Weight of a game against an opponent, lower for uncertain opponents
+double attenuation(double deviation) {
+  return 1.0 / std::sqrt(1.0 + 3.0 * Q * Q * deviation * deviation / (PI * PI));
+}
+
+// Run function(begin, end) over [0, count), split across the thread pool
+// when there is enough work to pay for it
+template <typename Function>
+void parallelFor(int count, Function function) {
+  const int minChunk = 1024;
+  int chunks = std::min(QThread::idealThreadCount() * 4, count / minChunk);
+  if (chunks < 2) {
+    function(0, count);
+    return;
+  }
+
+  QVector<QPair<int, int>> ranges;
+  ranges.reserve(chunks);
+  for (int i = 0; i < chunks; i++) {
+    ranges.append(qMakePair(int(qint64(count) * i / chunks),
+                            int(qint64(count) * (i + 1) / chunks)));
+  }
+  QtConcurrent::blockingMap(ranges, [&function](const QPair<int, int>& range) {
+    function(range.first, range.second);
+  });
+}
+
+}  // namespace
+
+RatingEngine::RatingEngine() {}
+
+RatingEngine::RatingEngine(const Params& params) : constants(params) {}
+
+const RatingEngine::Params& RatingEngine::params() const { return constants; }
+
+Rating RatingEngine::initialRating() const {
+  Rating rating;
+  rating.rating = constants.initialRating;
+  rating.deviation = constants.initialDeviation;
+  return rating;
+}
+
+RatingEngine::Role RatingEngine::roleOf(Seat seat) {
+  return (seat == RedSpymaster || seat == BlueSpymaster) ? Spymaster
+                                                         : Operative;
+}
+
+Rating& RatingEngine::roleRating(PlayerRatings& ratings, Role role) {
+  return role == Spymaster ? ratings.spymaster : ratings.operative;
+}
+
+void RatingEngine::teamRatings(const Rating* const seats[SeatCount],
+                               Opponent& red, Opponent& blue) {
+  auto combine = [](const Rating& spymaster, const Rating& operative) {
+    Opponent team;
+    team.rating = (spymaster.rating + operative.rating) / 2;
+    team.deviation = std::sqrt((spymaster.deviation * spymaster.deviation +
+                                operative.deviation * operative.deviation) /
+                               2);
+    return team;
+  };
+  red = combine(*seats[RedSpymaster], *seats[RedOperative]);
+  blue = combine(*seats[BlueSpymaster], *seats[BlueOperative]);
+}
+
+void RatingEngine::age(Rating& rating, qint64 timestamp) const {
+  if (rating.games == 0) {
+    return;  // Still at the initial deviation
+  }
+
+  qint64 idle = timestamp / constants.periodMs -
+                rating.lastPlayed / constants.periodMs;
+  if (idle > 0) {
+    double growth = constants.deviationGrowth;
+    rating.deviation =
+        std::min(std::sqrt(rating.deviation * rating.deviation +
+                           growth * growth * double(idle)),
+                 constants.initialDeviation);
+  }
+}
+
+void RatingEngine::update(Rating& rating, const Opponent* opponents,
+                          const double* scores, int count) const {
+  double variance = 0;  // Sum of g^2 E (1 - E)
+  double surprise = 0;  // Sum of g (s - E)
+  for (int i = 0; i < count; i++) {
+    double g = attenuation(opponents[i].deviation);
+    double expected =
+        1.0 /
+        (1.0 + std::pow(10.0, -g * (rating.rating - opponents[i].rating) / 400));
+    variance += g * g * expected * (1 - expected);
+    surprise += g * (scores[i] - expected);
+  }
+
+  double precision =
+      1.0 / (rating.deviation * rating.deviation) + Q * Q * variance;
+  rating.rating += Q / precision * surprise;
+  rating.deviation =
+      std::max(std::sqrt(1.0 / precision), constants.minDeviation);
+}
+
+void RatingEngine::rateMatch(Rating seats[SeatCount], bool redWon,
+                             qint64 timestamp) const {
+  Rating aged[SeatCount];
+  const Rating* agedSeats[SeatCount];
+  for (int seat = 0; seat < SeatCount; seat++) {
+    aged[seat] = seats[seat];
+    age(aged[seat], timestamp);
+    agedSeats[seat] = &aged[seat];
+  }
+
+  Opponent red, blue;
+  teamRatings(agedSeats, red, blue);
+
+  // Everyone is rated from the ratings before the game
+  for (int seat = 0; seat < SeatCount; seat++) {
+    bool isRed = seat == RedSpymaster || seat == RedOperative;
+    double score = isRed == redWon ? 1 : 0;
+    Rating rating = aged[seat];
+    update(rating, isRed ? &blue : &red, &score, 1);
+    rating.games++;
+    rating.lastPlayed = timestamp;
+    seats[seat] = rating;
+  }
+}
+
+QHash<QString, PlayerRatings> RatingEngine::recompute(
+    const QVector<MatchResult>& matches) const {
+  // Games with an empty seat cannot be rated
+  std::vector<int> order;
+  order.reserve(matches.size());
+  for (int i = 0; i < matches.size(); i++) {
+    const MatchResult& match = matches.at(i);
+    bool complete = true;
+    for (int seat = 0; seat < SeatCount; seat++) {
+      complete = complete && !match.players[seat].isEmpty();
+    }
+    if (complete) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&matches](int a, int b) {
+    return matches.at(a).timestamp < matches.at(b).timestamp;
+  });
+
+  // Dense ids, player index * RoleCount + role, so ratings are a flat array
+  QHash<QString, int> playerIds;
+  QStringList players;
+  std::vector<int> seatIds(order.size() * SeatCount);
+  for (size_t i = 0; i < order.size(); i++) {
+    const MatchResult& match = matches.at(order[i]);
+    for (int seat = 0; seat < SeatCount; seat++) {
+      auto it = playerIds.find(match.players[seat]);
+      if (it == playerIds.end()) {
+        it = playerIds.insert(match.players[seat], players.size());
+        players.append(match.players[seat]);
+      }
+      seatIds[i * SeatCount + seat] =
+          it.value() * RoleCount + roleOf(Seat(seat));
+    }
+  }
+
+  std::vector<Rating> ratings(size_t(players.size()) * RoleCount,
+                              initialRating());
+  std::vector<Opponent> teams(order.size() * 2);  // Red then blue per game
+  std::vector<std::pair<int, int>> entries;       // (rating id, seat slot)
+  std::vector<int> groups;                        // Start of each player
+
+  size_t begin = 0;
+  while (begin < order.size()) {
+    qint64 start = matches.at(order[begin]).timestamp;
+    qint64 period = start / constants.periodMs;
+    size_t end = begin;
+    while (end < order.size() &&
+           matches.at(order[end]).timestamp / constants.periodMs == period) {
+      end++;
+    }
+    int games = int(end - begin);
+
+    // Team ratings of every game, from the ratings at the period start
+    parallelFor(games, [&](int first, int last) {
+      for (int i = first; i < last; i++) {
+        size_t game = begin + i;
+        Rating aged[SeatCount];
+        const Rating* agedSeats[SeatCount];
+        for (int seat = 0; seat < SeatCount; seat++) {
+          aged[seat] = ratings[seatIds[game * SeatCount + seat]];
+          age(aged[seat], start);
+          agedSeats[seat] = &aged[seat];
+        }
+        teamRatings(agedSeats, teams[game * 2], teams[game * 2 + 1]);
+      }
+    });
+
+    // Group the seats of the period by rating id
+    entries.clear();
+    for (size_t game = begin; game < end; game++) {
+      for (int seat = 0; seat < SeatCount; seat++) {
+        int slot = int(game * SeatCount + seat);
+        entries.emplace_back(seatIds[slot], slot);
+      }
+    }
+    std::sort(entries.begin(), entries.end());
+    groups.clear();
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (i == 0 || entries[i].first != entries[i - 1].first) {
+        groups.push_back(int(i));
+      }
+    }
+    groups.push_back(int(entries.size()));
+
+    // Each rating only reads its own games, so players update in parallel
+    parallelFor(int(groups.size()) - 1, [&](int first, int last) {
+      QVarLengthArray<Opponent, 16> opponents;
+      QVarLengthArray<double, 16> scores;
+      for (int group = first; group < last; group++) {
+        opponents.clear();
+        scores.clear();
+        qint64 lastPlayed = 0;
+        for (int i = groups[group]; i < groups[group + 1]; i++) {
+          int slot = entries[i].second;
+          size_t game = size_t(slot / SeatCount);
+          int seat = slot % SeatCount;
+          bool isRed = seat == RedSpymaster || seat == RedOperative;
+          bool redWon = matches.at(order[game]).redWon;
+          opponents.append(teams[game * 2 + (isRed ? 1 : 0)]);
+          scores.append(isRed == redWon ? 1 : 0);
+          lastPlayed =
+              std::max(lastPlayed, matches.at(order[game]).timestamp);
+        }
+
+        Rating& rating = ratings[entries[groups[group]].first];
+        age(rating, start);
+        update(rating, opponents.constData(), scores.constData(),
+               opponents.size());
+        rating.games += quint32(opponents.size());
+        rating.lastPlayed = lastPlayed;
+      }
+    });
+
+    begin = end;
+  }
+
+  QHash<QString, PlayerRatings> result;
+  result.reserve(players.size());
+  for (int i = 0; i < players.size(); i++) {
+    PlayerRatings player;
+    player.spymaster = ratings[size_t(i) * RoleCount + Spymaster];
+    player.operative = ratings[size_t(i) * RoleCount + Operative];
+    result.insert(players.at(i), player);
+  }
+  return result;
+}
@@ -23,7 +23,7 @@ StatisticsWindow::StatisticsWindow(QWidget* parent) : QWidget(parent) {
     this->move(x, y);
   }
 
-  users = User::instance();
+  users = User::instance()->store();
 
   QVBoxLayout* layout = new QVBoxLayout(this);
 
@@ -146,6 +146,84 @@ StatisticsWindow::StatisticsWindow(QWidget* parent) : QWidget(parent) {
   statisticsLayout->addLayout(guessLayout);
   layout->addLayout(statisticsLayout);
 
+  // Recent Stats Layout Styling, one column per window
+  QHBoxLayout* recentLayout = new QHBoxLayout();
+  QVBoxLayout* weekLayout = new QVBoxLayout();
+  QVBoxLayout* monthLayout = new QVBoxLayout();
+
+  QHBoxLayout* weekWinRateLayout = new QHBoxLayout();
+  weekWinRateLayout->addWidget(new QLabel("Win Rate (7 days):", this));
+  weekWinRateStats = new QLabel("N/A", this);
+  weekWinRateStats->setStyleSheet(statsStyle);
+  weekWinRateLayout->addWidget(weekWinRateStats);
+
+  QHBoxLayout* weekHitRateLayout = new QHBoxLayout();
+  weekHitRateLayout->addWidget(new QLabel("Hit Rate (7 days):", this));
+  weekHitRateStats = new QLabel("N/A", this);
+  weekHitRateStats->setStyleSheet(statsStyle);
+  weekHitRateLayout->addWidget(weekHitRateStats);
+
+  weekLayout->addLayout(weekWinRateLayout);
+  weekLayout->addLayout(weekHitRateLayout);
+
+  QHBoxLayout* monthWinRateLayout = new QHBoxLayout();
+  monthWinRateLayout->addWidget(new QLabel("Win Rate (30 days):", this));
+  monthWinRateStats = new QLabel("N/A", this);
+  monthWinRateStats->setStyleSheet(statsStyle);
+  monthWinRateLayout->addWidget(monthWinRateStats);
+
+  QHBoxLayout* monthHitRateLayout = new QHBoxLayout();
+  monthHitRateLayout->addWidget(new QLabel("Hit Rate (30 days):", this));
+  monthHitRateStats = new QLabel("N/A", this);
+  monthHitRateStats->setStyleSheet(statsStyle);
+  monthHitRateLayout->addWidget(monthHitRateStats);
+
+  monthLayout->addLayout(monthWinRateLayout);
+  monthLayout->addLayout(monthHitRateLayout);
+
+  weekLayout->setAlignment(Qt::AlignHCenter);
+  monthLayout->setAlignment(Qt::AlignHCenter);
+
+  recentLayout->addLayout(weekLayout);
+  recentLayout->addLayout(monthLayout);
+  layout->addLayout(recentLayout);
+
+  // Role Stats Layout Styling, one column per role
+  QHBoxLayout* rolesLayout = new QHBoxLayout();
+  QVBoxLayout* spymasterLayout = new QVBoxLayout();
+  QVBoxLayout* operativeLayout = new QVBoxLayout();
+
+  cluesGivenStats = addStatsRow(spymasterLayout, "Clues Given:", statsStyle);
+  clueWordsStats =
+      addStatsRow(spymasterLayout, "Words per Clue:", statsStyle);
+  cluesSolvedStats =
+      addStatsRow(spymasterLayout, "Clues Solved:", statsStyle);
+  assassinsCausedStats =
+      addStatsRow(spymasterLayout, "Assassins Caused:", statsStyle);
+
+  cluesReceivedStats =
+      addStatsRow(operativeLayout, "Clues Received:", statsStyle);
+  correctPerClueStats =
+      addStatsRow(operativeLayout, "Agents Found per Clue:", statsStyle);
+  bonusGuessesStats =
+      addStatsRow(operativeLayout, "Bonus Guesses:", statsStyle);
+  wrongGuessesStats =
+      addStatsRow(operativeLayout, "Wrong Guesses:", statsStyle);
+  assassinGuessesStats =
+      addStatsRow(operativeLayout, "Assassin Hits:", statsStyle);
+
+  spymasterLayout->setAlignment(Qt::AlignHCenter);
+  operativeLayout->setAlignment(Qt::AlignHCenter);
+
+  rolesLayout->addLayout(spymasterLayout);
+  rolesLayout->addLayout(operativeLayout);
+  layout->addLayout(rolesLayout);
+
+  QVBoxLayout* partnerLayout = new QVBoxLayout();
+  bestPartnerStats = addStatsRow(partnerLayout, "Best Partner:", statsStyle);
+  partnerLayout->setAlignment(Qt::AlignHCenter);
+  layout->addLayout(partnerLayout);
+
   setLayout(layout);
 
   populateDropDown();
@@ -159,11 +237,8 @@ StatisticsWindow::StatisticsWindow(QWidget* parent) : QWidget(parent) {
 StatisticsWindow::~StatisticsWindow() {}
 
 void StatisticsWindow::populateDropDown() {
-  QJsonObject json = users->loadJsonFile();
-  QStringList usernames = json.keys();
-
-  usernameComboBox->clear();
-  usernameComboBox->addItems(usernames);
+  // The shared model is kept up to date, so this is only done once
+  usernameComboBox->setModel(users->usernameModel());
 }
 
 void StatisticsWindow::showUserStats() {
@@ -171,16 +246,89 @@ void StatisticsWindow::showUserStats() {
 
   usernameTitle->setText(username);
 
-  gamesPlayedStats->setText(QString::number(users->getGamesPlayed(username)));
-  gamesWinStats->setText(QString::number(users->getWins(username)));
+  // Every value comes from one lookup of the profile
+  StatsSnapshot stats = users->statsSnapshot(username);
+
+  gamesPlayedStats->setText(QString::number(stats.counters.gamesPlayed));
+  gamesWinStats->setText(QString::number(stats.counters.gamesWin));
 
   // Specify decimal places for floating-point numbers
-  gamesWinRateStats->setText(
-      QString::number(users->getWinRate(username) * 100, 'f', 2) + "%");
-  guessTotalStats->setText(QString::number(users->getGuessTotal(username)));
-  guessHitStats->setText(QString::number(users->getGuessHit(username)));
-  guessHitRateStats->setText(
-      QString::number(users->getHitRate(username) * 100, 'f', 2) + "%");
+  gamesWinRateStats->setText(QString::number(stats.winRate * 100, 'f', 2) +
+                             "%");
+  guessTotalStats->setText(QString::number(stats.counters.guessTotal));
+  guessHitStats->setText(QString::number(stats.counters.guessHit));
+  guessHitRateStats->setText(QString::number(stats.hitRate * 100, 'f', 2) +
+                             "%");
+
+  // Windows are summed from daily buckets, not from the whole history
+  StatsSnapshot week = users->recentStats(username, 7);
+  StatsSnapshot month = users->recentStats(username, 30);
+  weekWinRateStats->setText(formatRate(week.winRate, week.counters.gamesPlayed,
+                                       "games"));
+  weekHitRateStats->setText(formatRate(week.hitRate, week.counters.guessTotal,
+                                       "guesses"));
+  monthWinRateStats->setText(formatRate(
+      month.winRate, month.counters.gamesPlayed, "games"));
+  monthHitRateStats->setText(formatRate(
+      month.hitRate, month.counters.guessTotal, "guesses"));
+
+  // Kept up to date per clue and reveal, read as stored
+  RoleStats roles = users->getRoleStats(username);
+  cluesGivenStats->setText(QString::number(roles.cluesGiven));
+  clueWordsStats->setText(
+      roles.numberedClues == 0
+          ? "N/A"
+          : QString::number(float(roles.clueWords) / roles.numberedClues, 'f',
+                            2));
+  cluesSolvedStats->setText(
+      roles.numberedClues == 0
+          ? "N/A"
+          : QString::number(roles.cluesSolved) + " (" +
+                QString::number(
+                    100.0f * roles.cluesSolved / roles.numberedClues, 'f', 2) +
+                "%)");
+  assassinsCausedStats->setText(QString::number(roles.assassinsCaused));
+
+  cluesReceivedStats->setText(QString::number(roles.cluesReceived));
+  correctPerClueStats->setText(
+      roles.cluesReceived == 0
+          ? "N/A"
+          : QString::number(float(roles.correctGuesses) / roles.cluesReceived,
+                            'f', 2));
+  bonusGuessesStats->setText(QString::number(roles.bonusGuesses));
+  wrongGuessesStats->setText(
+      QString::number(roles.neutralGuesses + roles.opponentGuesses));
+  assassinGuessesStats->setText(QString::number(roles.assassinGuesses));
+
+  // Only this user's pairs are read
+  QVector<PairRecord> partners = users->bestPartners(username, 1);
+  bestPartnerStats->setText(
+      partners.isEmpty()
+          ? "N/A"
+          : partners.first().other + " " +
+                formatRate(partners.first().winRate, partners.first().games,
+                           "games"));
+}
+
+QLabel* StatisticsWindow::addStatsRow(QVBoxLayout* column,
+                                      const QString& title,
+                                      const QString& style) {
+  QHBoxLayout* row = new QHBoxLayout();
+  row->addWidget(new QLabel(title, this));
+  QLabel* value = new QLabel("N/A", this);
+  value->setStyleSheet(style);
+  row->addWidget(value);
+  column->addLayout(row);
+  return value;
+}
+
+QString StatisticsWindow::formatRate(float rate, unsigned int count,
+                                     const QString& unit) const {
+  if (count == 0) {
+    return "N/A";
+  }
+  return QString::number(rate * 100, 'f', 2) + "% (" + QString::number(count) +
+         " " + unit + ")";
 }
 
 void StatisticsWindow::goBackToMain() {
@@ -190,6 +338,5 @@ void StatisticsWindow::goBackToMain() {
 
 void StatisticsWindow::show() {
   QWidget::show();
-  populateDropDown();
   qDebug() << "Statistics shown";
 }
\ No newline at end of file
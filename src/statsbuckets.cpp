@@ -0,0 +1,375 @@
+/**
+ * @file statsbuckets.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Memory-mapped rings of daily statistics counters
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "statsbuckets.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char bucketsMagic[4] = {'C', 'N', 'S', 'B'};
+const quint32 bucketsVersion = 2;
+const int lockTimeoutMs = 5000;  // As long as the profile lock waits
+
+enum RecordState : quint32 {
+  EmptyRecord = 0,
+  UsedRecord = 1,
+  DeletedRecord = 2
+};
+
+QString namesPath(const QString& filePath) { return filePath + ".names"; }
+
+// Add to a 16 bit day counter without wrapping
+void addSaturated(quint16& counter, quint32 delta) {
+  counter = quint16(std::min<quint32>(counter + delta, 0xFFFF));
+}
+
+}  // namespace
+
+StatsBuckets::StatsBuckets(const QString& filePath)
+    : filePath(filePath),
+      lockPath(filePath + ".lock"),
+      userIds(namesPath(filePath)) {}
+
+StatsBuckets::~StatsBuckets() { unmap(); }
+
+bool StatsBuckets::isOpen() const { return data != nullptr; }
+
+quint64 StatsBuckets::hashId(quint32 id) {
+  // splitmix64 finalizer, ids are small and sequential
+  quint64 key = id;
+  key ^= key >> 30;
+  key *= 0xBF58476D1CE4E5B9ULL;
+  key ^= key >> 27;
+  key *= 0x94D049BB133111EBULL;
+  key ^= key >> 31;
+  return key;
+}
+
+bool StatsBuckets::open(quint32 initialCapacity) {
+  unmap();
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs)) {
+    qDebug() << "Timed out waiting for" << QFileInfo(lockPath).fileName();
+    return false;
+  }
+
+  // Names first, the table refers to users by their position in them.
+  // Without them the ids in the table mean nothing, so it starts over.
+  bool namesRead = userIds.read();
+  if (!namesRead && !userIds.reset()) {
+    return false;
+  }
+
+  file.setFileName(filePath);
+  if (!(namesRead && file.exists() && file.open(QIODevice::ReadWrite) &&
+        map())) {
+    if (file.exists()) {
+      qDebug() << "Invalid statistics buckets, recreating"
+               << QFileInfo(filePath).absoluteFilePath();
+    }
+    unmap();
+
+    quint32 capacity = 16;
+    while (capacity < initialCapacity) {
+      capacity *= 2;
+    }
+    if (!rebuild(capacity)) {
+      return false;
+    }
+  }
+
+  seenGeneration = header->generation;
+  return true;
+}
+
+bool StatsBuckets::map() const {
+  qint64 fileSize = file.size();
+  if (fileSize < qint64(sizeof(Header))) {
+    return false;
+  }
+
+  data = file.map(0, fileSize);
+  if (!data) {
+    return false;
+  }
+
+  header = reinterpret_cast<Header*>(data);
+  records = reinterpret_cast<Record*>(data + sizeof(Header));
+
+  quint32 capacity = header->capacity;
+  qint64 expectedSize =
+      qint64(sizeof(Header)) + qint64(capacity) * qint64(sizeof(Record));
+  bool valid =
+      std::memcmp(header->magic, bucketsMagic, sizeof(bucketsMagic)) == 0 &&
+      header->version == bucketsVersion && capacity >= 16 &&
+      (capacity & (capacity - 1)) == 0 && fileSize == expectedSize;
+  if (!valid) {
+    unmap();
+    return false;
+  }
+
+  // The file at filePath is the current table, even if a rebuild that
+  // failed to replace it marked it retired
+  header->retired = 0;
+  return true;
+}
+
+void StatsBuckets::unmap() const {
+  if (data) {
+    file.unmap(data);
+  }
+  data = nullptr;
+  header = nullptr;
+  records = nullptr;
+  file.close();
+}
+
+bool StatsBuckets::refresh() const {
+  if (data && header->retired != 0) {
+    // Another instance rebuilt the table, its records are in the new file
+    unmap();
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadWrite) || !map()) {
+      qDebug() << "Failed to map" << QFileInfo(filePath).absoluteFilePath();
+      unmap();
+      return false;
+    }
+  }
+  if (!data) {
+    return false;
+  }
+
+  // Another instance added or renamed users since the names were read
+  if (header->generation != seenGeneration) {
+    if (!userIds.read()) {
+      qDebug() << "Failed to read"
+               << QFileInfo(namesPath(filePath)).absoluteFilePath();
+      return false;
+    }
+    seenGeneration = header->generation;
+  }
+  return true;
+}
+
+void StatsBuckets::bumpGeneration() {
+  header->generation++;
+  seenGeneration = header->generation;
+}
+
+StatsBuckets::Record* StatsBuckets::lookup(quint32 id) const {
+  if (id == 0) {
+    return nullptr;
+  }
+
+  quint32 mask = header->capacity - 1;
+  for (quint32 i = hashId(id) & mask, probes = 0; probes <= mask;
+       i = (i + 1) & mask, probes++) {
+    Record& record = records[i];
+    if (record.state == EmptyRecord) {
+      return nullptr;  // End of the probe chain
+    }
+    if (record.state == UsedRecord && record.id == id) {
+      return &record;
+    }
+  }
+  return nullptr;
+}
+
+StatsBuckets::Record* StatsBuckets::insert(const QString& username) {
+  quint32 id = userIds.id(username);
+  if (Record* record = lookup(id)) {
+    return record;
+  }
+  if (id == 0) {
+    id = userIds.add(username);
+    if (id == 0) {
+      return nullptr;
+    }
+    bumpGeneration();
+  }
+
+  // Keep at least half of the slots empty so probe chains stay short
+  if ((header->used + header->deleted + 1) * 2 > header->capacity) {
+    quint32 capacity = header->capacity;
+    if ((header->used + 1) * 2 > capacity) {
+      capacity *= 2;  // Otherwise rebuilding just clears the tombstones
+    }
+    if (!rebuild(capacity)) {
+      return nullptr;
+    }
+  }
+
+  quint32 mask = header->capacity - 1;
+  quint32 i = hashId(id) & mask;
+  while (records[i].state == UsedRecord) {
+    i = (i + 1) & mask;
+  }
+
+  Record& record = records[i];
+  if (record.state == DeletedRecord) {
+    header->deleted--;
+  }
+  std::memset(&record, 0, sizeof(Record));
+  record.id = id;
+  record.state = UsedRecord;
+  header->used++;
+  return &record;
+}
+
+bool StatsBuckets::add(const QString& username, qint64 day,
+                       const StatsCounters& delta) {
+  if (!data || day <= 0) {
+    return false;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    return false;
+  }
+
+  Record* record = insert(username);
+  if (!record) {
+    return false;
+  }
+
+  // The slot still holds a day that has rolled out of the ring
+  Bucket& bucket = record->days[day % Days];
+  if (bucket.day != quint32(day)) {
+    std::memset(&bucket, 0, sizeof(Bucket));
+    bucket.day = quint32(day);
+  }
+  addSaturated(bucket.gamesPlayed, delta.gamesPlayed);
+  addSaturated(bucket.gamesWin, delta.gamesWin);
+  addSaturated(bucket.guessTotal, delta.guessTotal);
+  addSaturated(bucket.guessHit, delta.guessHit);
+  return true;
+}
+
+StatsCounters StatsBuckets::window(const QString& username, qint64 today,
+                                   int days) const {
+  StatsCounters totals;
+  if (!data) {
+    return totals;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    return totals;
+  }
+
+  const Record* record = lookup(userIds.id(username));
+  if (!record) {
+    return totals;
+  }
+
+  // Only buckets stamped with a day inside the window count
+  days = std::max(0, std::min(days, int(Days)));
+  for (const Bucket& bucket : record->days) {
+    qint64 age = today - qint64(bucket.day);
+    if (bucket.day != 0 && age >= 0 && age < days) {
+      totals.gamesPlayed += bucket.gamesPlayed;
+      totals.gamesWin += bucket.gamesWin;
+      totals.guessTotal += bucket.guessTotal;
+      totals.guessHit += bucket.guessHit;
+    }
+  }
+  return totals;
+}
+
+bool StatsBuckets::rename(const QString& oldUsername,
+                          const QString& newUsername) {
+  if (!data) {
+    return false;
+  }
+
+  // The record is keyed by the id, which stays with the user
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh() ||
+      !userIds.rename(oldUsername, newUsername)) {
+    return false;
+  }
+  bumpGeneration();
+  return true;
+}
+
+bool StatsBuckets::remove(const QString& username) {
+  if (!data) {
+    return false;
+  }
+
+  QLockFile lock(lockPath);
+  if (!lock.tryLock(lockTimeoutMs) || !refresh()) {
+    return false;
+  }
+
+  Record* record = lookup(userIds.id(username));
+  if (!record) {
+    return false;
+  }
+  erase(record);
+  return true;
+}
+
+void StatsBuckets::erase(Record* record) {
+  // A tombstone keeps the probe chains through this slot intact
+  record->state = DeletedRecord;
+  header->used--;
+  header->deleted++;
+}
+
+bool StatsBuckets::rebuild(quint32 capacity) {
+  QByteArray bytes(int(sizeof(Header) + capacity * sizeof(Record)), '\0');
+  Header* newHeader = reinterpret_cast<Header*>(bytes.data());
+  Record* newRecords =
+      reinterpret_cast<Record*>(bytes.data() + sizeof(Header));
+  std::memcpy(newHeader->magic, bucketsMagic, sizeof(bucketsMagic));
+  newHeader->version = bucketsVersion;
+  newHeader->capacity = capacity;
+
+  // Reinsert every live record, dropping the tombstones
+  if (data) {
+    newHeader->generation = header->generation;
+    quint32 mask = capacity - 1;
+    for (quint32 i = 0; i < header->capacity; i++) {
+      const Record& record = records[i];
+      if (record.state != UsedRecord) {
+        continue;
+      }
+      quint32 slot = hashId(record.id) & mask;
+      while (newRecords[slot].state == UsedRecord) {
+        slot = (slot + 1) & mask;
+      }
+      newRecords[slot] = record;
+      newHeader->used++;
+    }
+
+    // Instances still mapping the old table remap before their next access
+    header->retired = 1;
+  }
+
+  unmap();
+
+  QSaveFile saveFile(filePath);
+  bool written = saveFile.open(QIODevice::WriteOnly) &&
+                 saveFile.write(bytes) == bytes.size() && saveFile.commit();
+  if (!written) {
+    qDebug() << "Failed to write" << QFileInfo(filePath).absoluteFilePath();
+  }
+
+  // On failure the old table is still on disk, map it again
+  file.setFileName(filePath);
+  return file.open(QIODevice::ReadWrite) && map() && written;
+}
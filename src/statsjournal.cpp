@@ -0,0 +1,289 @@
+/**
+ * @file statsjournal.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Append-only binary journal of statistics changes
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "statsjournal.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+
+namespace {
+
+const char journalMagic[4] = {'C', 'N', 'J', 'L'};
+const quint16 journalVersion = 2;
+const int headerSize = 8;
+
+enum RecordType : quint8 { UserRecord = 1, StatRecord = 2, CheckpointRecord = 3 };
+
+QByteArray encodeHeader() {
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out.writeRawData(journalMagic, sizeof(journalMagic));
+  out << journalVersion << quint16(0);
+  return bytes;
+}
+
+QByteArray encodeUser(quint32 id, const QString& username) {
+  QByteArray name = username.toUtf8().left(0xFFFF);
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out << quint8(UserRecord) << id << quint16(name.size());
+  out.writeRawData(name.constData(), name.size());
+  return bytes;
+}
+
+QByteArray encodeStat(quint32 id, const StatsJournal::Event& event) {
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out << quint8(StatRecord) << event.seq << id << quint8(event.field)
+      << event.delta << event.timestamp;
+  return bytes;
+}
+
+QByteArray encodeCheckpoint(quint64 seq) {
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out << quint8(CheckpointRecord) << seq;
+  return bytes;
+}
+
+}  // namespace
+
+StatsJournal::StatsJournal(const QString& filePath)
+    : filePath(filePath), lock(filePath + ".lock") {
+  // Held for the whole session, only a dead owner makes it stale
+  lock.setStaleLockTime(0);
+}
+
+QString StatsJournal::name() const { return QFileInfo(filePath).fileName(); }
+
+QString StatsJournal::slotPath(const QString& basePath, int slot) {
+  return slot == 0 ? basePath : basePath + "." + QString::number(slot);
+}
+
+bool StatsJournal::open() {
+  QMutexLocker locker(&mutex);
+
+  if (!lock.tryLock(0)) {
+    return false;  // Another instance appends to it
+  }
+
+  file.setFileName(filePath);
+  if (!file.open(QIODevice::ReadWrite)) {
+    qDebug() << "Failed to open" << QFileInfo(filePath).absoluteFilePath();
+    return false;
+  }
+
+  QByteArray data = file.readAll();
+  if (!data.startsWith(encodeHeader())) {
+    if (!data.isEmpty()) {
+      // Not ours or an older version, keep it for inspection and start anew
+      qDebug() << "Unrecognised stats journal, moving it aside";
+      file.close();
+      QFile::remove(filePath + ".corrupt");
+      QFile::rename(filePath, filePath + ".corrupt");
+      if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        return false;
+      }
+    }
+    // Numbered from the clock, a profile may still record a position of
+    // the journal this one replaces
+    quint64 start = quint64(QDateTime::currentMSecsSinceEpoch()) * 1000;
+    QByteArray header = encodeHeader() + encodeCheckpoint(start);
+    if (file.write(header) != header.size() || !file.flush()) {
+      return false;
+    }
+    lastSeq = start;
+    return true;
+  }
+
+  QDataStream in(data);
+  in.skipRawData(headerSize);
+  QHash<quint32, QString> names;
+  QString journalName = name();
+  qint64 goodEnd = headerSize;
+
+  // Stop at the first incomplete record, it was torn by a crash
+  while (!in.atEnd()) {
+    quint8 type = 0;
+    in >> type;
+
+    if (type == UserRecord) {
+      quint32 id = 0;
+      quint16 length = 0;
+      in >> id >> length;
+      QByteArray name(length, Qt::Uninitialized);
+      if (in.status() != QDataStream::Ok ||
+          in.readRawData(name.data(), length) != length) {
+        break;
+      }
+      names.insert(id, QString::fromUtf8(name));
+      ids.insert(QString::fromUtf8(name), id);
+      nextId = std::max(nextId, id + 1);
+    } else if (type == StatRecord) {
+      Event event;
+      quint32 id = 0;
+      quint8 field = 0;
+      in >> event.seq >> id >> field >> event.delta >> event.timestamp;
+      if (in.status() != QDataStream::Ok) {
+        break;
+      }
+      event.journal = journalName;
+      event.username = names.value(id);
+      event.field = Field(field);
+      if (!event.username.isEmpty() && field < FieldCount) {
+        events.append(event);
+      }
+      lastSeq = std::max(lastSeq, event.seq);
+    } else if (type == CheckpointRecord) {
+      quint64 seq = 0;
+      in >> seq;
+      if (in.status() != QDataStream::Ok) {
+        break;
+      }
+      lastSeq = std::max(lastSeq, seq);
+    } else {
+      break;
+    }
+
+    goodEnd = in.device()->pos();
+  }
+
+  if (goodEnd < data.size()) {
+    qDebug() << "Discarding" << data.size() - goodEnd
+             << "bytes from the end of the stats journal";
+    file.resize(goodEnd);
+  }
+  return file.seek(goodEnd);
+}
+
+quint32 StatsJournal::userId(const QString& username) {
+  auto it = ids.constFind(username);
+  if (it != ids.constEnd()) {
+    return it.value();
+  }
+
+  quint32 id = nextId;
+  if (!writeRecord(encodeUser(id, username))) {
+    return 0;
+  }
+  ids.insert(username, id);
+  nextId++;
+  return id;
+}
+
+bool StatsJournal::writeRecord(const QByteArray& record) {
+  if (!file.isOpen()) {
+    return false;
+  }
+
+  qint64 start = file.pos();
+  if (file.write(record) == record.size() && file.flush()) {
+    return true;
+  }
+
+  // Cut a partial record off so the following ones stay readable
+  file.resize(start);
+  file.seek(start);
+  return false;
+}
+
+StatsJournal::Event StatsJournal::append(const QString& username,
+                                         Field field, qint32 delta,
+                                         qint64 timestamp) {
+  QMutexLocker locker(&mutex);
+
+  // Filled in even on failure, the caller still applies the change
+  Event event;
+  event.journal = name();
+  event.username = username;
+  event.field = field;
+  event.delta = delta;
+  event.timestamp =
+      timestamp != 0 ? timestamp : QDateTime::currentMSecsSinceEpoch();
+
+  quint32 id = userId(username);
+  event.seq = lastSeq + 1;
+  if (id == 0 || !writeRecord(encodeStat(id, event))) {
+    qDebug() << "Failed to append to the stats journal";
+    event.seq = 0;
+    return event;
+  }
+
+  lastSeq = event.seq;
+  events.append(event);
+  return event;
+}
+
+bool StatsJournal::compact(quint64 seq) {
+  QMutexLocker locker(&mutex);
+
+  QList<Event> remaining;
+  for (const Event& event : events) {
+    if (event.seq > seq) {
+      remaining.append(event);
+    }
+  }
+
+  // Keep the compacted position so sequence numbers never restart
+  quint64 kept = remaining.isEmpty() ? std::max(seq, lastSeq) : seq;
+
+  // Rewrite with fresh ids so users that dropped out are forgotten
+  QHash<QString, quint32> remainingIds;
+  QByteArray bytes = encodeHeader();
+  bytes += encodeCheckpoint(kept);
+  for (const Event& event : remaining) {
+    quint32 id = remainingIds.value(event.username);
+    if (id == 0) {
+      id = remainingIds.size() + 1;
+      remainingIds.insert(event.username, id);
+      bytes += encodeUser(id, event.username);
+    }
+    bytes += encodeStat(id, event);
+  }
+
+  QSaveFile saveFile(filePath);
+  if (!saveFile.open(QIODevice::WriteOnly) ||
+      saveFile.write(bytes) != bytes.size() || !saveFile.commit()) {
+    qDebug() << "Failed to compact the stats journal";
+    return false;
+  }
+
+  // The old handle points at the replaced file
+  file.close();
+  if (!file.open(QIODevice::ReadWrite) || !file.seek(file.size())) {
+    qDebug() << "Failed to reopen the stats journal";
+  }
+
+  events = remaining;
+  ids = remainingIds;
+  nextId = remainingIds.size() + 1;
+  return true;
+}
+
+quint64 StatsJournal::lastSequence() const {
+  QMutexLocker locker(&mutex);
+  return lastSeq;
+}
+
+QList<StatsJournal::Event> StatsJournal::eventsAfter(quint64 seq) const {
+  QMutexLocker locker(&mutex);
+
+  QList<Event> tail;
+  for (const Event& event : events) {
+    if (event.seq > seq) {
+      tail.append(event);
+    }
+  }
+  return tail;
+}
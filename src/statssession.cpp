@@ -0,0 +1,109 @@
+/**
+ * @file statssession.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Per-game buffer of statistics changes committed once at game end
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "statssession.h"
+
+#include "user.h"
+
+StatsSession::StatsSession(ProfileStore* users) : users(users) {}
+
+void StatsSession::hit(const QString& username) {
+  UserStats& delta = deltas[username];
+  delta.guessTotal++;
+  delta.guessHit++;
+}
+
+void StatsSession::miss(const QString& username) {
+  deltas[username].guessTotal++;
+}
+
+void StatsSession::won(const QString& username) {
+  UserStats& delta = deltas[username];
+  delta.gamesPlayed++;
+  delta.gamesWin++;
+}
+
+void StatsSession::lost(const QString& username) {
+  deltas[username].gamesPlayed++;
+}
+
+void StatsSession::clue(const QString& spymaster, const QString& operative,
+                        int number) {
+  RoleStats& given = roleDeltas[spymaster];
+  given.cluesGiven++;
+  if (number > 0) {
+    given.numberedClues++;
+    given.clueWords += number;
+  }
+  roleDeltas[operative].cluesReceived++;
+
+  clueSpymaster = spymaster;
+  clueOperative = operative;
+  clueNumber = number;
+  clueFound = 0;
+}
+
+void StatsSession::reveal(Reveal card) {
+  if (clueSpymaster.isEmpty()) {
+    return;  // No clue given yet
+  }
+
+  // One lookup at a time, an insert may move the other entry
+  RoleStats& guessed = roleDeltas[clueOperative];
+  switch (card) {
+    case OwnAgent:
+      guessed.correctGuesses++;
+      clueFound++;
+      if (clueNumber > 0 && clueFound > clueNumber) {
+        guessed.bonusGuesses++;
+      }
+      if (clueNumber > 0 && clueFound == clueNumber) {
+        roleDeltas[clueSpymaster].cluesSolved++;
+      }
+      break;
+    case OpponentAgent:
+      guessed.opponentGuesses++;
+      break;
+    case Bystander:
+      guessed.neutralGuesses++;
+      break;
+    case Assassin:
+      guessed.assassinGuesses++;
+      roleDeltas[clueSpymaster].assassinsCaused++;
+      break;
+  }
+}
+
+bool StatsSession::isEmpty() const {
+  return deltas.isEmpty() && roleDeltas.isEmpty();
+}
+
+bool StatsSession::commit() {
+  clueSpymaster.clear();
+  if (isEmpty()) {
+    return true;
+  }
+
+  if (!users) {
+    users = User::instance()->store();
+  }
+
+  // Queued as one batch, a flush never writes half of a game
+  bool written = users->applyGameDeltas(deltas, roleDeltas);
+  deltas.clear();
+  roleDeltas.clear();
+  return written;
+}
+
+void StatsSession::discard() {
+  deltas.clear();
+  roleDeltas.clear();
+  clueSpymaster.clear();
+}
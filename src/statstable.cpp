@@ -0,0 +1,295 @@
+/**
+ * @file statstable.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Memory-mapped table of fixed-size statistics records
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "statstable.h"
+
+#include <QDebug>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char tableMagic[4] = {'C', 'N', 'S', 'T'};
+const quint32 tableVersion = 2;
+
+enum RecordState : quint32 {
+  EmptyRecord = 0,
+  UsedRecord = 1,
+  DeletedRecord = 2
+};
+
+// Smallest power of two that keeps the table at most half full
+quint32 capacityFor(int users) {
+  quint32 capacity = 16;
+  while (capacity < quint32(users) * 2) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+}  // namespace
+
+StatsTable::StatsTable(const QString& filePath)
+    : filePath(filePath),
+      lock(filePath + ".lock"),
+      userIds(QString()) {
+  // Held for the life of the process, a crashed owner's lock is stale
+  lock.setStaleLockTime(0);
+}
+
+StatsTable::~StatsTable() { unmap(); }
+
+bool StatsTable::isOpen() const { return data != nullptr; }
+
+int StatsTable::size() const { return header ? int(header->used) : 0; }
+
+quint64 StatsTable::hashId(quint32 id) {
+  // splitmix64 finalizer, ids are small and sequential
+  quint64 key = id;
+  key ^= key >> 30;
+  key *= 0xBF58476D1CE4E5B9ULL;
+  key ^= key >> 27;
+  key *= 0x94D049BB133111EBULL;
+  key ^= key >> 31;
+  return key;
+}
+
+bool StatsTable::open(quint32 initialCapacity) {
+  unmap();
+  if (!lock.isLocked() && !lock.tryLock(0)) {
+    return false;  // Owned by another instance
+  }
+
+  // Whatever a previous owner left is refilled from the profile anyway
+  if (!userIds.reset()) {
+    return false;
+  }
+  quint32 capacity = 16;
+  while (capacity < initialCapacity) {
+    capacity *= 2;
+  }
+  return rebuild(capacity);
+}
+
+bool StatsTable::reset() {
+  if (!data || !userIds.reset()) {
+    return false;
+  }
+
+  // Cleared in place, the pages stay mapped
+  std::fill_n(records, header->capacity, Record());
+  header->used = 0;
+  header->deleted = 0;
+  return true;
+}
+
+bool StatsTable::reserve(int users) {
+  if (!data) {
+    return false;
+  }
+
+  quint32 capacity = capacityFor(int(header->used) + users);
+  return header->capacity >= capacity || rebuild(capacity);
+}
+
+bool StatsTable::map() {
+  qint64 fileSize = file.size();
+  if (fileSize < qint64(sizeof(Header))) {
+    return false;
+  }
+
+  data = file.map(0, fileSize);
+  if (!data) {
+    return false;
+  }
+
+  header = reinterpret_cast<Header*>(data);
+  records = reinterpret_cast<Record*>(data + sizeof(Header));
+
+  quint32 capacity = header->capacity;
+  qint64 expectedSize =
+      qint64(sizeof(Header)) + qint64(capacity) * qint64(sizeof(Record));
+  bool valid =
+      std::memcmp(header->magic, tableMagic, sizeof(tableMagic)) == 0 &&
+      header->version == tableVersion && capacity >= 16 &&
+      (capacity & (capacity - 1)) == 0 && fileSize == expectedSize;
+  if (!valid) {
+    unmap();
+  }
+  return valid;
+}
+
+void StatsTable::unmap() {
+  if (data) {
+    file.unmap(data);
+  }
+  data = nullptr;
+  header = nullptr;
+  records = nullptr;
+  file.close();
+}
+
+StatsTable::Record* StatsTable::lookup(quint32 id) const {
+  if (id == 0) {
+    return nullptr;
+  }
+
+  quint32 mask = header->capacity - 1;
+  for (quint32 i = hashId(id) & mask, probes = 0; probes <= mask;
+       i = (i + 1) & mask, probes++) {
+    Record& record = records[i];
+    if (record.state == EmptyRecord) {
+      return nullptr;  // End of the probe chain
+    }
+    if (record.state == UsedRecord && record.id == id) {
+      return &record;
+    }
+  }
+  return nullptr;
+}
+
+StatsCounters* StatsTable::find(const QString& username) {
+  if (!data) {
+    return nullptr;
+  }
+
+  Record* record = lookup(userIds.id(username));
+  return record ? &record->counters : nullptr;
+}
+
+const StatsCounters* StatsTable::find(const QString& username) const {
+  if (!data) {
+    return nullptr;
+  }
+
+  const Record* record = lookup(userIds.id(username));
+  return record ? &record->counters : nullptr;
+}
+
+StatsCounters* StatsTable::insert(const QString& username,
+                                  const StatsCounters& counters) {
+  if (!data) {
+    return nullptr;
+  }
+
+  quint32 id = userIds.id(username);
+  if (Record* record = lookup(id)) {
+    record->counters = counters;
+    return &record->counters;
+  }
+  if (id == 0) {
+    id = userIds.add(username);
+    if (id == 0) {
+      return nullptr;
+    }
+  }
+
+  // Keep at least half of the slots empty so probe chains stay short
+  if ((header->used + header->deleted + 1) * 2 > header->capacity) {
+    quint32 capacity = header->capacity;
+    if ((header->used + 1) * 2 > capacity) {
+      capacity *= 2;  // Otherwise rebuilding just clears the tombstones
+    }
+    if (!rebuild(capacity)) {
+      return nullptr;
+    }
+  }
+
+  quint32 mask = header->capacity - 1;
+  quint32 i = hashId(id) & mask;
+  while (records[i].state == UsedRecord) {
+    i = (i + 1) & mask;
+  }
+
+  Record& record = records[i];
+  if (record.state == DeletedRecord) {
+    header->deleted--;
+  }
+  record.id = id;
+  record.counters = counters;
+  record.state = UsedRecord;
+  header->used++;
+  return &record.counters;
+}
+
+bool StatsTable::remove(const QString& username) {
+  if (!data) {
+    return false;
+  }
+
+  Record* record = lookup(userIds.id(username));
+  if (!record) {
+    return false;
+  }
+
+  // A tombstone keeps the probe chains through this slot intact
+  record->state = DeletedRecord;
+  header->used--;
+  header->deleted++;
+  return true;
+}
+
+QHash<QString, StatsCounters> StatsTable::toHash() const {
+  QHash<QString, StatsCounters> counters;
+  if (!data) {
+    return counters;
+  }
+
+  counters.reserve(int(header->used));
+  for (quint32 i = 0; i < header->capacity; i++) {
+    const Record& record = records[i];
+    if (record.state == UsedRecord) {
+      counters.insert(userIds.name(record.id), record.counters);
+    }
+  }
+  return counters;
+}
+
+bool StatsTable::rebuild(quint32 capacity) {
+  QByteArray bytes(int(sizeof(Header) + capacity * sizeof(Record)), '\0');
+  Header* newHeader = reinterpret_cast<Header*>(bytes.data());
+  Record* newRecords =
+      reinterpret_cast<Record*>(bytes.data() + sizeof(Header));
+  std::memcpy(newHeader->magic, tableMagic, sizeof(tableMagic));
+  newHeader->version = tableVersion;
+  newHeader->capacity = capacity;
+
+  // Reinsert every live record, dropping the tombstones
+  if (data) {
+    quint32 mask = capacity - 1;
+    for (quint32 i = 0; i < header->capacity; i++) {
+      const Record& record = records[i];
+      if (record.state != UsedRecord) {
+        continue;
+      }
+      quint32 slot = hashId(record.id) & mask;
+      while (newRecords[slot].state == UsedRecord) {
+        slot = (slot + 1) & mask;
+      }
+      newRecords[slot] = record;
+      newHeader->used++;
+    }
+  }
+
+  unmap();
+
+  QSaveFile saveFile(filePath);
+  bool written = saveFile.open(QIODevice::WriteOnly) &&
+                 saveFile.write(bytes) == bytes.size() && saveFile.commit();
+  if (!written) {
+    qDebug() << "Failed to write" << QFileInfo(filePath).absoluteFilePath();
+  }
+
+  // On failure the old table is still on disk, map it again
+  file.setFileName(filePath);
+  return file.open(QIODevice::ReadWrite) && map() && written;
+}
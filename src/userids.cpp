@@ -0,0 +1,142 @@
+/**
+ * @file userids.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Small ids for usernames, saved to a names file
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "userids.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace {
+
+const char idsMagic[4] = {'C', 'N', 'U', 'I'};
+
+QByteArray encodeName(const QString& username) {
+  QByteArray name = username.toUtf8();
+  QByteArray entry;
+  QDataStream out(&entry, QIODevice::WriteOnly);
+  out << quint16(name.size());
+  out.writeRawData(name.constData(), name.size());
+  return entry;
+}
+
+}  // namespace
+
+UserIds::UserIds(const QString& filePath)
+    : filePath(filePath), names({QString()}) {}
+
+bool UserIds::read() {
+  QFile namesFile(filePath);
+  if (filePath.isEmpty() || !namesFile.open(QIODevice::ReadWrite)) {
+    return false;
+  }
+  QByteArray bytes = namesFile.readAll();
+  if (!bytes.startsWith(QByteArray(idsMagic, sizeof(idsMagic)))) {
+    return false;
+  }
+
+  names = {QString()};
+  ids.clear();
+  int pos = sizeof(idsMagic);
+  while (pos + 2 <= bytes.size()) {
+    int length = (uchar(bytes[pos]) << 8) | uchar(bytes[pos + 1]);
+    if (pos + 2 + length > bytes.size()) {
+      break;  // Torn by a crash mid-append
+    }
+    QString username = QString::fromUtf8(bytes.constData() + pos + 2, length);
+    ids.insert(username, quint32(names.size()));
+    names.append(username);
+    pos += 2 + length;
+  }
+  if (pos < bytes.size()) {
+    namesFile.resize(pos);
+  }
+  return true;
+}
+
+bool UserIds::reset() {
+  names = {QString()};
+  ids.clear();
+  return write();
+}
+
+quint32 UserIds::id(const QString& username) const {
+  return ids.value(username);
+}
+
+quint32 UserIds::add(const QString& username) {
+  auto it = ids.constFind(username);
+  if (it != ids.constEnd()) {
+    return it.value();
+  }
+
+  if (username.toUtf8().size() > 0xFFFF) {
+    return 0;
+  }
+  QByteArray entry = encodeName(username);
+
+  // Appended before use, so a record never refers to an unsaved id
+  QFile namesFile(filePath);
+  if (!filePath.isEmpty() &&
+      (!namesFile.open(QIODevice::Append) ||
+       namesFile.write(entry) != entry.size() || !namesFile.flush())) {
+    qDebug() << "Failed to write" << QFileInfo(filePath).absoluteFilePath();
+    return 0;
+  }
+
+  quint32 id = quint32(names.size());
+  names.append(username);
+  ids.insert(username, id);
+  return id;
+}
+
+bool UserIds::rename(const QString& oldUsername, const QString& newUsername) {
+  if (!ids.contains(oldUsername) || ids.contains(newUsername) ||
+      newUsername.toUtf8().size() > 0xFFFF) {
+    return false;
+  }
+
+  quint32 id = ids.take(oldUsername);
+  ids.insert(newUsername, id);
+  names[int(id)] = newUsername;
+  if (!write()) {
+    // Keep the names that are on disk
+    ids.remove(newUsername);
+    ids.insert(oldUsername, id);
+    names[int(id)] = oldUsername;
+    return false;
+  }
+  return true;
+}
+
+QString UserIds::name(quint32 id) const {
+  return id < quint32(names.size()) ? names.at(int(id)) : QString();
+}
+
+bool UserIds::write() const {
+  if (filePath.isEmpty()) {
+    return true;  // Kept in memory only
+  }
+
+  QByteArray bytes(idsMagic, sizeof(idsMagic));
+  for (int id = 1; id < names.size(); id++) {
+    bytes += encodeName(names.at(id));
+  }
+
+  QSaveFile saveFile(filePath);
+  bool written = saveFile.open(QIODevice::WriteOnly) &&
+                 saveFile.write(bytes) == bytes.size() && saveFile.commit();
+  if (!written) {
+    qDebug() << "Failed to write" << QFileInfo(filePath).absoluteFilePath();
+  }
+  return written;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file usernamemodel.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Shared sorted list model of every username
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "usernamemodel.h"
+
+#include <algorithm>
+
+UsernameModel::UsernameModel(QObject* parent) : QAbstractListModel(parent) {}
+
+int UsernameModel::rowCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : sorted.size();
+}
+
+QVariant UsernameModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid() || index.row() >= sorted.size() ||
+      (role != Qt::DisplayRole && role != Qt::EditRole)) {
+    return QVariant();
+  }
+  return sorted.at(index.row());
+}
+
+const QStringList& UsernameModel::usernames() const { return sorted; }
+
+int UsernameModel::lowerBound(const QString& username) const {
+  return int(std::lower_bound(sorted.begin(), sorted.end(), username) -
+             sorted.begin());
+}
+
+void UsernameModel::setUsernames(QStringList usernames) {
+  usernames.sort();
+  usernames.removeDuplicates();
+
+  // Merge the two sorted lists, touching only the rows that differ
+  int row = 0;
+  int next = 0;
+  while (row < sorted.size() || next < usernames.size()) {
+    if (next == usernames.size() ||
+        (row < sorted.size() && sorted.at(row) < usernames.at(next))) {
+      beginRemoveRows(QModelIndex(), row, row);
+      sorted.removeAt(row);
+      endRemoveRows();
+    } else if (row == sorted.size() || usernames.at(next) < sorted.at(row)) {
+      beginInsertRows(QModelIndex(), row, row);
+      sorted.insert(row, usernames.at(next));
+      endInsertRows();
+      row++;
+      next++;
+    } else {
+      row++;
+      next++;
+    }
+  }
+}
+
+void UsernameModel::addUsername(const QString& username) {
+  int row = lowerBound(username);
+  if (row < sorted.size() && sorted.at(row) == username) {
+    return;
+  }
+
+  beginInsertRows(QModelIndex(), row, row);
+  sorted.insert(row, username);
+  endInsertRows();
+}
+
+void UsernameModel::removeUsername(const QString& username) {
+  int row = lowerBound(username);
+  if (row == sorted.size() || sorted.at(row) != username) {
+    return;
+  }
+
+  beginRemoveRows(QModelIndex(), row, row);
+  sorted.removeAt(row);
+  endRemoveRows();
+}
+
+void UsernameModel::renameUsername(const QString& oldUsername,
+                                   const QString& newUsername) {
+  removeUsername(oldUsername);
+  addUsername(newUsername);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file userpatch.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Field-level changes to one user entry, queued for the profile writer
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "userpatch.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+// Add a journal delta to a counter without wrapping below zero
+int addDelta(const QJsonValue& counter, qint32 delta) {
+  qint64 value = qint64(std::max(counter.toInt(), 0)) + delta;
+  return int(std::min<qint64>(std::max<qint64>(value, 0), INT_MAX));
+}
+
+// Keys of "statistics", in the order of the journal fields
+const char* const counterKeys[] = {"games_played", "games_win", "guess_total",
+                                   "guess_hit"};
+
+// Keys of "role_statistics", in the order of the journal fields (the same
+// order as roleFields in profilestore.cpp)
+const struct {
+  const char* role;
+  const char* key;
+} roleKeys[] = {
+    {"spymaster", "clues_given"},
+    {"spymaster", "numbered_clues"},
+    {"spymaster", "clue_words"},
+    {"spymaster", "clues_solved"},
+    {"spymaster", "assassins_caused"},
+    {"operative", "clues_received"},
+    {"operative", "correct_guesses"},
+    {"operative", "bonus_guesses"},
+    {"operative", "neutral_guesses"},
+    {"operative", "opponent_guesses"},
+    {"operative", "assassin_guesses"},
+};
+
+// Roles of "ratings", in the order of the journal fields
+const char* const ratingRoles[] = {"spymaster", "operative"};
+
+}  // namespace
+
+void UserPatch::addEvent(const StatsJournal::Event& event) {
+  events.append(event);
+}
+
+void UserPatch::addDefaults(const QJsonObject& defaults) {
+  mergeDefaults(this->defaults, defaults);
+}
+
+void UserPatch::createUser() { creates = true; }
+
+void UserPatch::merge(const UserPatch& newer) {
+  events += newer.events;
+  mergeDefaults(defaults, newer.defaults);
+  creates = creates || newer.creates;
+}
+
+bool UserPatch::changes(const ProfileCodec::JournalPositions& positions) const {
+  if (creates) {
+    return true;
+  }
+  for (const StatsJournal::Event& event : events) {
+    if (event.seq == 0 || event.seq > positions.value(event.journal)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ProfileCodec::JournalPositions UserPatch::positions() const {
+  ProfileCodec::JournalPositions newest;
+  for (const StatsJournal::Event& event : events) {
+    if (event.seq > newest.value(event.journal)) {
+      newest.insert(event.journal, event.seq);
+    }
+  }
+  return newest;
+}
+
+QJsonValue UserPatch::apply(
+    const QJsonValue& entry,
+    const ProfileCodec::JournalPositions& positions) const {
+  if (!entry.isObject() && !creates) {
+    return QJsonValue(QJsonValue::Undefined);  // Removed or renamed since
+  }
+
+  QJsonObject user = entry.toObject();
+  mergeDefaults(user, defaults);
+
+  // A record that failed to reach the journal has no position to compare
+  for (const StatsJournal::Event& event : events) {
+    if (event.seq == 0 || event.seq > positions.value(event.journal)) {
+      applyEvent(user, event);
+    }
+  }
+  return user;
+}
+
+void UserPatch::applyEvent(QJsonObject& entry,
+                           const StatsJournal::Event& event) {
+  if (event.field <= StatsJournal::GuessHit) {
+    QJsonObject statistics = entry["statistics"].toObject();
+    const char* key = counterKeys[event.field];
+    statistics[key] = addDelta(statistics[key], event.delta);
+    entry["statistics"] = statistics;
+  } else if (event.field <= StatsJournal::AssassinGuesses) {
+    const auto& field = roleKeys[event.field - StatsJournal::CluesGiven];
+    QJsonObject roles = entry["role_statistics"].toObject();
+    QJsonObject role = roles[field.role].toObject();
+    role[field.key] = addDelta(role[field.key], event.delta);
+    roles[field.role] = role;
+    entry["role_statistics"] = roles;
+  } else if (event.field < StatsJournal::FieldCount) {
+    // Three fields per role: rating, deviation, games
+    int index = event.field - StatsJournal::SpymasterRating;
+    const char* roleName = ratingRoles[index / 3];
+    QJsonObject ratings = entry["ratings"].toObject();
+    QJsonObject rating = ratings[roleName].toObject();
+    double points = double(event.delta) / StatsJournal::RatingScale;
+    if (index % 3 == 0) {
+      rating["rating"] = rating["rating"].toDouble() + points;
+    } else if (index % 3 == 1) {
+      rating["deviation"] = rating["deviation"].toDouble() + points;
+    } else {
+      rating["games"] = addDelta(rating["games"], event.delta);
+      rating["last_played"] = double(std::max(
+          qint64(rating["last_played"].toDouble()), event.timestamp));
+    }
+    ratings[roleName] = rating;
+    entry["ratings"] = ratings;
+  }
+}
+
+void UserPatch::mergeDefaults(QJsonObject& target,
+                              const QJsonObject& defaults) {
+  for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it) {
+    QJsonValue current = target.value(it.key());
+    if (current.isUndefined()) {
+      target.insert(it.key(), it.value());
+    } else if (current.isObject() && it.value().isObject()) {
+      QJsonObject nested = current.toObject();
+      mergeDefaults(nested, it.value().toObject());
+      target.insert(it.key(), nested);
+    }
+  }
+}
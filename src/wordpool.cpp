@@ -0,0 +1,108 @@
+/**
+ * @file wordpool.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief The words boards are dealt from, loaded once per process
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "wordpool.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QSet>
+#include <QTextStream>
+#include <utility>
+
+namespace {
+
+// FNV-1a over the UTF-8 of every word, each followed by a newline
+quint32 fingerprintOf(const QVector<QString>& words) {
+  quint32 hash = 2166136261u;
+  for (const QString& word : words) {
+    const QByteArray bytes = word.toUtf8();
+    for (char c : bytes) {
+      hash = (hash ^ quint8(c)) * 16777619u;
+    }
+    hash = (hash ^ quint8('\n')) * 16777619u;
+  }
+  return hash;
+}
+
+}  // namespace
+
+const WordPool& WordPool::instance() {
+  // Initialised once, thread-safe since C++11
+  static const WordPool pool(":/resources/wordlist-eng.txt");
+  return pool;
+}
+
+WordPool::WordPool(const QString& path) : hash(0) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qDebug() << "failed to open" << path << ", using fallback";
+    // Fallback word list if file not found
+    words = {"apple",    "banana", "cat",    "dog",    "elephant",
+             "fish",     "goat",   "horse",  "iguana", "jelly",
+             "kangaroo", "lion",   "monkey", "nest",   "owl",
+             "penguin",  "queen",  "rabbit", "snake",  "tiger",
+             "umbrella", "violin", "whale",  "xray",   "zebra"};
+    hash = fingerprintOf(words);
+    return;
+  }
+
+  // Read words from file, a word listed twice could land on a board twice
+  QSet<QString> seen;
+  QTextStream in(&file);
+  while (!in.atEnd()) {
+    QString line = in.readLine().trimmed();
+    if (!line.isEmpty() && !seen.contains(line)) {
+      seen.insert(line);
+      words.append(line);
+    }
+  }
+  words.squeeze();
+  hash = fingerprintOf(words);
+  qDebug() << "Loaded" << words.size() << "words";
+}
+
+int WordPool::size() const { return words.size(); }
+
+const QString& WordPool::at(int index) const { return words.at(index); }
+
+const QString* WordPool::begin() const { return words.constData(); }
+
+const QString* WordPool::end() const {
+  return words.constData() + words.size();
+}
+
+quint32 WordPool::fingerprint() const { return hash; }
+
+bool WordPool::sample(int* indices, int count, BoardRandom& rng) const {
+  int poolSize = words.size();
+  if (count > poolSize) {
+    qDebug() << "Not enough words to sample" << count << "from" << poolSize;
+    return false;
+  }
+
+  // Floyd: one draw per word, a board is too small for the scan to matter
+  for (int picked = 0, j = poolSize - count; j < poolSize; picked++, j++) {
+    int index = int(rng.bounded(quint32(j + 1)));
+    for (int k = 0; k < picked; k++) {
+      if (indices[k] == index) {
+        index = j;  // Taken, and j cannot have been drawn yet
+        break;
+      }
+    }
+    indices[picked] = index;
+  }
+
+  // Floyd picks late positions last, shuffle them for a random layout
+  for (int i = count - 1; i > 0; --i) {
+    std::swap(indices[i], indices[rng.bounded(quint32(i + 1))]);
+  }
+  return true;
+}
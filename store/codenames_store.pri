@@ -0,0 +1,20 @@
+# Links the headless profile store library into a program
+# Usage: include(<path to>/store/codenames_store.pri)
+# Needs QtCore and QtConcurrent only, no gui or widgets
+QT += core concurrent
+
+include($$PWD/profilestore.pri)
+
+# The headers are not added, moc already ran on them for the library
+INCLUDEPATH += $$PWD/../include
+DEPENDPATH += $$PWD/../include
+
+STORE_LIB = $$PWD/../lib/$${QMAKE_PREFIX_STATICLIB}codenames_store.$${QMAKE_EXTENSION_STATICLIB}
+LIBS += -L$$PWD/../lib -lcodenames_store
+PRE_TARGETDEPS += $$STORE_LIB
+
+# Builds the library first, and again whenever one of its files changes
+storelib.target = $$STORE_LIB
+storelib.depends = $$STORE_SOURCES $$STORE_HEADERS
+storelib.commands = cd $$PWD && $$QMAKE_QMAKE store.pro -o Makefile.store && $(MAKE) -f Makefile.store
+QMAKE_EXTRA_TARGETS += storelib
@@ -0,0 +1,38 @@
+# Sources of the headless profile store, compiled only by store.pro
+# Programs link the library through codenames_store.pri instead
+STORE_ROOT = $$clean_path($$PWD/..)
+
+STORE_SOURCES += $$STORE_ROOT/src/leaderboard.cpp
+STORE_SOURCES += $$STORE_ROOT/src/matchhistory.cpp
+STORE_SOURCES += $$STORE_ROOT/src/pairstats.cpp
+STORE_SOURCES += $$STORE_ROOT/src/profilecodec.cpp
+STORE_SOURCES += $$STORE_ROOT/src/profileflusher.cpp
+STORE_SOURCES += $$STORE_ROOT/src/profileimporter.cpp
+STORE_SOURCES += $$STORE_ROOT/src/profilescanner.cpp
+STORE_SOURCES += $$STORE_ROOT/src/profileshards.cpp
+STORE_SOURCES += $$STORE_ROOT/src/profilestore.cpp
+STORE_SOURCES += $$STORE_ROOT/src/ratingengine.cpp
+STORE_SOURCES += $$STORE_ROOT/src/statsbuckets.cpp
+STORE_SOURCES += $$STORE_ROOT/src/statsjournal.cpp
+STORE_SOURCES += $$STORE_ROOT/src/statstable.cpp
+STORE_SOURCES += $$STORE_ROOT/src/userids.cpp
+STORE_SOURCES += $$STORE_ROOT/src/usernamemodel.cpp
+STORE_SOURCES += $$STORE_ROOT/src/userpatch.cpp
+STORE_HEADERS += $$STORE_ROOT/include/leaderboard.h
+STORE_HEADERS += $$STORE_ROOT/include/matchhistory.h
+STORE_HEADERS += $$STORE_ROOT/include/pairstats.h
+STORE_HEADERS += $$STORE_ROOT/include/profilecodec.h
+STORE_HEADERS += $$STORE_ROOT/include/profileflusher.h
+STORE_HEADERS += $$STORE_ROOT/include/profileimporter.h
+STORE_HEADERS += $$STORE_ROOT/include/profilescanner.h
+STORE_HEADERS += $$STORE_ROOT/include/profileshards.h
+STORE_HEADERS += $$STORE_ROOT/include/profilestore.h
+STORE_HEADERS += $$STORE_ROOT/include/ratingengine.h
+STORE_HEADERS += $$STORE_ROOT/include/statsbuckets.h
+STORE_HEADERS += $$STORE_ROOT/include/statscounters.h
+STORE_HEADERS += $$STORE_ROOT/include/statsjournal.h
+STORE_HEADERS += $$STORE_ROOT/include/statstable.h
+STORE_HEADERS += $$STORE_ROOT/include/userids.h
+STORE_HEADERS += $$STORE_ROOT/include/usernamemodel.h
+STORE_HEADERS += $$STORE_ROOT/include/userpatch.h
+
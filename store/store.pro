@@ -0,0 +1,23 @@
+# Headless profile store as a static library, for a dedicated server or any
+# other program that keeps statistics without the game's windows
+# Build: qmake store/store.pro && make
+QT -= gui
+
+CONFIG += c++17 staticlib
+
+TARGET = codenames_store
+TEMPLATE = lib
+
+QT += core concurrent
+
+include($$PWD/profilestore.pri)
+
+SOURCES += $$STORE_SOURCES
+HEADERS += $$STORE_HEADERS
+INCLUDEPATH += $$PWD/../include
+
+# Output Directory
+DESTDIR = $$PWD/../lib
+
+# Object Directory
+OBJECTS_DIR = $$PWD/../build/store
@@ -0,0 +1,48 @@
+/**
+ * @file main.cpp
+ * @author Team 9 - UWO CS 3307
+ * @brief Merges profile dumps from other machines into the local profile
+ * @version 0.1
+ * @date 2025-03-30
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * Usage: profile_merge <dump> [<dump> ...]
+ * Run from the directory holding resources/, like the game. The counters of
+ * every user in each dump are added to the local profile and users it does
+ * not have are created. Dumps are streamed, so a dump of any size merges in
+ * the same memory; the local profile itself is loaded as usual.
+ */
+#include <QCoreApplication>
+#include <QTextStream>
+
+#include "profilestore.h"
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+
+  QStringList dumps = app.arguments().mid(1);
+  QTextStream err(stderr);
+  if (dumps.isEmpty()) {
+    err << "usage: profile_merge <dump> [<dump> ...]\n";
+    return 2;
+  }
+
+  ProfileStore* store = new ProfileStore("resources", &app);
+  int failed = 0;
+  for (const QString& dump : dumps) {
+    if (store->importProfile(dump)) {
+      err << "merged " << dump << "\n";
+    } else {
+      err << "could not merge " << dump << "\n";
+      failed++;
+    }
+    err.flush();
+  }
+
+  // Quitting flushes every queued change before the process exits
+  QMetaObject::invokeMethod(&app, &QCoreApplication::quit,
+                            Qt::QueuedConnection);
+  app.exec();
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+# Merges profile dumps from other machines into the local profile
+# Build: qmake tools/profilemerge/profilemerge.pro && make
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = profile_merge
+TEMPLATE = app
+
+SOURCES += $$PWD/main.cpp
+
+include($$PWD/../../store/codenames_store.pri)
+
+# Output Directory
+DESTDIR = $$PWD/../../bin
+
+# Object Directory
+OBJECTS_DIR = $$PWD/../../build/tools